@@ -0,0 +1,22 @@
+#version 450 core
+
+//	Dual filter (Kawase) downsample : the target is half the size of Image
+
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+layout (binding = 0) uniform sampler2D Image;
+
+void main()
+{
+	vec2 halfPixel = 0.5 / textureSize(Image, 0);
+
+	vec3 result = texture(Image, TexCoords).rgb * 4.0;
+	result += texture(Image, TexCoords - halfPixel).rgb;
+	result += texture(Image, TexCoords + halfPixel).rgb;
+	result += texture(Image, TexCoords + vec2(halfPixel.x, -halfPixel.y)).rgb;
+	result += texture(Image, TexCoords - vec2(halfPixel.x, -halfPixel.y)).rgb;
+
+	FragColor = vec4(result / 8.0, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 450 core
+
+//	Dual filter (Kawase) upsample : the target is twice the size of Image
+//	It's added to the target, so each level keeps its own glow
+
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+layout (binding = 0) uniform sampler2D Image;
+
+void main()
+{
+	vec2 halfPixel = 0.5 / textureSize(Image, 0);
+
+	vec3 result = texture(Image, TexCoords + vec2(-halfPixel.x * 2.0, 0.0)).rgb;
+	result += texture(Image, TexCoords + vec2(-halfPixel.x, halfPixel.y)).rgb * 2.0;
+	result += texture(Image, TexCoords + vec2(0.0, halfPixel.y * 2.0)).rgb;
+	result += texture(Image, TexCoords + vec2(halfPixel.x, halfPixel.y)).rgb * 2.0;
+	result += texture(Image, TexCoords + vec2(halfPixel.x * 2.0, 0.0)).rgb;
+	result += texture(Image, TexCoords + vec2(halfPixel.x, -halfPixel.y)).rgb * 2.0;
+	result += texture(Image, TexCoords + vec2(0.0, -halfPixel.y * 2.0)).rgb;
+	result += texture(Image, TexCoords + vec2(-halfPixel.x, -halfPixel.y)).rgb * 2.0;
+
+	FragColor = vec4(result / 12.0, 1.0);
+}
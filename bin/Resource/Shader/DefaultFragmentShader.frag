@@ -3,67 +3,87 @@
 layout (location = 0) out vec4 FragColor;
 layout (location = 1) out vec4 BrightColor;
 
-struct Map
-{
-	bool exist;
-	sampler2D text;
-	vec3 offset;
-	vec3 tiling;
-};
+//	Which maps exist is known at compile time, see ShaderFeature (Shader.hpp)
+//	The maps are bound per batch, their tiling (xy) and offset (zw) are in the material
 
-struct Bump
+//	Mirrors GpuMaterial (OpaquePass.hpp)
+struct Material
 {
-	Map   map;
-	float multiplier;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	vec4 emissive;		// w : shininess
+
+	vec4 diffuseMap;
+	vec4 normalMap;
+	vec4 specularMap;
+	vec4 emissiveMap;
+	vec4 maskMap;
+
+	vec4 normalMultiplier;
 };
 
-struct Material
-{
-	vec3 ambient;
-	vec3 diffuse;
-	vec3 specular;
-	vec3 emissive;
+layout (std430, binding = 6) readonly buffer MaterialBuffer { Material materials[]; };	// MATERIAL_BINDING
 
-	float shininess;
-	
-	Map diffuseMap;
-	Map specularMap;
-	Map emissiveMap;
-	Map maskMap;
-	Bump normalMap;
-};
+uniform sampler2D DiffuseMap;
+uniform sampler2D NormalMap;
+uniform sampler2D SpecularMap;
+uniform sampler2D EmissiveMap;
+uniform sampler2D MaskMap;
 
+//	Mirrors GpuLight (LightClusters.hpp)
 struct Light
 {
-	bool enabled;
+	vec3 position;		float power;
+	vec3 ambient;		float cutOff;
+	vec3 diffuse;		float outerCutOff;
+	vec3 specular;		int   lightType;
+	vec3 attenuation;	float radius;
+	vec3 direction;		float padding;
+};
 
-	vec3 position;
+//	Unbounded lights first, then the clustered point lights
+layout (std430, binding = 2) readonly buffer LightBuffer		{ Light light_list[]; };
+layout (std430, binding = 3) readonly buffer ClusterBuffer		{ uvec2 clusters[]; };	// offset, count
+layout (std430, binding = 4) readonly buffer ClusterIndexBuffer	{ uint  cluster_indices[]; };
 
-	vec3 ambient;
-	vec3 diffuse;
-	vec3 specular;
+#define CLUSTER_X 16u
+#define CLUSTER_Y 9u
+#define CLUSTER_Z 24u
 
-	vec3 attenuation;
-	vec3 direction;
+#ifdef OBJECT_LIGHTS
+#define OBJECT_LIGHT_COUNT 8
 
-	float power;
-	float cutOff;
-	float outerCutOff;
+//	Mirrors GpuObject (OpaquePass.hpp), only the lights picked for the model are read
+struct Object
+{
+	mat4 model;
+	mat4 normalMatrix;
+	uint material;
 
-	int lightType;
+	uint lightCount;
+	uint lights[OBJECT_LIGHT_COUNT];
 };
 
-#define MAX_LIGHTS 64
-uniform Light light_list[MAX_LIGHTS];
+layout (std430, binding = 5) readonly buffer ObjectBuffer { Object objects[]; };	// OBJECT_BINDING
+#endif
+
+uniform int   GlobalLightNumber;
+uniform float ClusterScale;
+uniform float ClusterBias;
+uniform vec2  ScreenSize;
+uniform mat4  View;
 
-uniform int LightNumber;
-uniform Material mat;
 uniform vec3 ViewPos;
-uniform bool showNormal;
 
 in vec3 Normal;
 in vec2 TexCoord;
 in vec3 FragPos;
+flat in uint MaterialIndex;
+flat in uint ObjectIndex;
+
+//	Material of the draw, read once in main()
+Material mat;
 
 
 /*----------------------------------------------------------------------------------------*/
@@ -71,9 +91,9 @@ in vec3 FragPos;
 //	Get text coord
 //	--------------
 
-vec2 getTextCoord(in vec2 texCoord, in Map in_map)
+vec2 getTextCoord(in vec2 texCoord, in vec4 in_map)
 {
-	return texCoord * in_map.tiling.xy + in_map.offset.xy;
+	return texCoord * in_map.xy + in_map.zw;
 }
 
 /*----------------------------------------------------------------------------------------*/
@@ -112,7 +132,7 @@ void setSpotLight(inout vec3 diffuse, inout vec3 specular, in int i, in vec3 lig
 //	-------------------
 vec3 getAmbient( in float strength, in int i)
 {
-	return strength * light_list[i].ambient * mat.ambient;
+	return strength * light_list[i].ambient * mat.ambient.rgb;
 }
 
 /*----------------------------------------------------------------------------------------*/
@@ -121,14 +141,13 @@ vec3 getAmbient( in float strength, in int i)
 //	--------------------
 vec3 getSpecular(in vec3 lightDir, in vec3 norm, in vec3 viewDir, in int i)
 {
-	vec3 color = light_list[i].specular * mat.specular;
-	if(mat.specularMap.exist)
-	{
-		color *= texture(mat.specularMap.text, getTextCoord(TexCoord, mat.specularMap)).rgb;
-	}
+	vec3 color = light_list[i].specular * mat.specular.rgb;
+#ifdef SPECULAR_MAP
+	color *= texture(SpecularMap, getTextCoord(TexCoord, mat.specularMap)).rgb;
+#endif
 
     vec3 halfwayDir = normalize(lightDir + viewDir);
-	float	spec = pow(max(dot(norm, halfwayDir), 0.0), mat.shininess);
+	float	spec = pow(max(dot(norm, halfwayDir), 0.0), mat.emissive.w);
 	return	spec * color;
 }
 
@@ -144,56 +163,113 @@ vec3 getDiffuse(in vec3 lightDir, in vec3 norm, in int i)
 
 /*----------------------------------------------------------------------------------------*/
 
-//	Loop on lights and apply them
-//	-----------------------------
+//	Index of the cluster holding the fragment
+//	-----------------------------------------
+uint getClusterIndex()
+{
+	float depth = -(View * vec4(FragPos, 1.0)).z;
+
+	uvec2 tile  = uvec2(clamp(gl_FragCoord.xy / ScreenSize, 0.0, 0.999) * vec2(CLUSTER_X, CLUSTER_Y));
+	uint  slice = uint(clamp(log(depth) * ClusterScale + ClusterBias, 0.0, float(CLUSTER_Z - 1u)));
+
+	return tile.x + tile.y * CLUSTER_X + slice * CLUSTER_X * CLUSTER_Y;
+}
+
+/*----------------------------------------------------------------------------------------*/
+
+//	Apply one light
+//	---------------
+vec3 getLightChange(in int i, in vec3 norm, in vec3 viewDir)
+{
+	vec3 ligthWorldPosition = light_list[i].position;
+
+	vec3 lightDir;
+
+	//	Directionnal Light
+	if(light_list[i].lightType == 1)
+	{
+		lightDir = normalize(ligthWorldPosition);
+	}
+	else
+	{
+		lightDir = normalize(ligthWorldPosition -FragPos); 
+	}
+
+	
+	
+	vec3 ambient  = getAmbient( 1.0,i);
+	vec3 diffuse  = getDiffuse(lightDir, norm, i);
+	vec3 specular = getSpecular(lightDir, norm, viewDir, i);
+	
+	//	Point Light
+	if(light_list[i].lightType == 0)
+	{
+		SetPointLight(ambient, diffuse, specular, i, ligthWorldPosition);
+	}
+	//	Spot Light
+	else if(light_list[i].lightType == 2)
+	{
+		setSpotLight(diffuse, specular,i,lightDir);
+	}
+
+	return ambient + diffuse + specular;
+}
+
+/*----------------------------------------------------------------------------------------*/
+
+//	Apply one point light, clustered lights are always point lights
+//	---------------------------------------------------------------
+vec3 getPointLightChange(in int i, in vec3 norm, in vec3 viewDir)
+{
+	vec3 ligthWorldPosition = light_list[i].position;
+	vec3 lightDir = normalize(ligthWorldPosition -FragPos);
+
+	vec3 ambient  = getAmbient( 1.0,i);
+	vec3 diffuse  = getDiffuse(lightDir, norm, i);
+	vec3 specular = getSpecular(lightDir, norm, viewDir, i);
+
+	SetPointLight(ambient, diffuse, specular, i, ligthWorldPosition);
+
+	return ambient + diffuse + specular;
+}
+
+/*----------------------------------------------------------------------------------------*/
+
+//	Loop on the unbounded lights and the lights of the cluster,
+//	or on the lights picked for the model (see LightSelector)
+//	----------------------------------------------------------
 vec3 getLightChanges(in vec2 texCoord, in vec3 norm, in vec3 color)
 {
 	vec3 result = {0.0,0.0,0.0};
 	
 	vec3 viewDir = normalize(ViewPos - FragPos);
 
-	//	Light Loop
-	for(int i = 0 ; i < LightNumber && i < MAX_LIGHTS; i++)
+#ifdef OBJECT_LIGHTS
+	uint lightCount = objects[ObjectIndex].lightCount;
+
+	for(uint i = 0; i < lightCount; i++)
+	{
+		result += getLightChange(int(objects[ObjectIndex].lights[i]), norm, viewDir);
+	}
+#else
+	for(int i = 0; i < GlobalLightNumber; i++)
+	{
+		result += getLightChange(i, norm, viewDir);
+	}
+
+	uvec2 cluster = clusters[getClusterIndex()];
+
+	for(uint i = 0; i < cluster.y; i++)
 	{
-		if (!light_list[i].enabled)
+		int index = int(cluster_indices[cluster.x + i]);
+
+		//	Clusters are conservative, skip the lights that don't reach this fragment
+		if (distance(light_list[index].position, FragPos) > light_list[index].radius)
 			continue;
 
-		vec3 ligthWorldPosition = light_list[i].position;
-
-		vec3 lightDir;
-
-		//	Directionnal Light
-		if(light_list[i].lightType == 1)
-		{
-			lightDir = normalize(ligthWorldPosition);
-		}
-		else
-		{
-			lightDir = normalize(ligthWorldPosition -FragPos); 
-		}
-
-		
-		
-		vec3 ambient  = getAmbient( 1.0,i);
-		vec3 diffuse  = getDiffuse(lightDir, norm, i);
-		vec3 specular = getSpecular(lightDir, norm, viewDir, i);
-		
-		//	Point Light
-		if(light_list[i].lightType == 0)
-		{
-			SetPointLight(ambient, diffuse, specular, i, ligthWorldPosition);
-		}
-		//	Spot Light
-		else if(light_list[i].lightType == 2)
-		{
-			setSpotLight(diffuse, specular,i,lightDir);
-		}
-
-		//	Check if Material has specular textures
-		//	---------------------------------------
-
-		result += ambient + diffuse + specular;
+		result += getPointLightChange(index, norm, viewDir);
 	}
+#endif
 
 	return result * color;
 }
@@ -202,16 +278,17 @@ vec3 getLightChanges(in vec2 texCoord, in vec3 norm, in vec3 color)
 
 void main()
 {	
+	mat = materials[MaterialIndex];
+
 	vec3 norm = Normal;
 	
 	//	Check if Material has diffuse textures
 	//	--------------------------------------
 
-	vec3 color = mat.diffuse;
-	if(mat.diffuseMap.exist)
-	{
-		color = texture(mat.diffuseMap.text, getTextCoord(TexCoord, mat.diffuseMap)).rgb * mat.diffuse;
-	}
+	vec3 color = mat.diffuse.rgb;
+#ifdef DIFFUSE_MAP
+	color = texture(DiffuseMap, getTextCoord(TexCoord, mat.diffuseMap)).rgb * mat.diffuse.rgb;
+#endif
 
 
 	vec3 result =  getLightChanges(TexCoord, norm, color);
@@ -219,25 +296,20 @@ void main()
 	//	Check if Material has emissive textures
 	//	---------------------------------------
 
-	vec4 emissive = vec4(mat.emissive,1.0);
-	if(mat.emissiveMap.exist)
-	{
-		emissive = texture(mat.emissiveMap.text, getTextCoord(TexCoord, mat.emissiveMap)) + vec4(mat.emissive,1.0);
-	}
+	vec4 emissive = vec4(mat.emissive.rgb,1.0);
+#ifdef EMISSIVE_MAP
+	emissive = texture(EmissiveMap, getTextCoord(TexCoord, mat.emissiveMap)) + vec4(mat.emissive.rgb,1.0);
+#endif
 
-	if (showNormal)
-	{
-		FragColor = vec4(norm, 1.0);
-	}
-	else
-	{
-	    FragColor = vec4(result,1.0) + emissive;
-	}
+#ifdef SHOW_NORMAL
+	FragColor = vec4(norm, 1.0);
+#else
+	FragColor = vec4(result,1.0) + emissive;
+#endif
 	
-	if(mat.maskMap.exist)
-	{
-		FragColor.a = texture(mat.maskMap.text, getTextCoord(TexCoord, mat.maskMap)).r;
-	}
+#ifdef MASK_MAP
+	FragColor.a = texture(MaskMap, getTextCoord(TexCoord, mat.maskMap)).r;
+#endif
 
 	
     //	Check whether fragment output is higher than threshold,
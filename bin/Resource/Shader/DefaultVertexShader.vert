@@ -4,21 +4,42 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
-uniform mat4 Model;
+layout (location = 3) in uint aDrawIndex;	// Per instance, the baseInstance of the draw command
+
+#define OBJECT_LIGHT_COUNT 8
+
+//	Mirrors GpuObject (OpaquePass.hpp)
+struct Object
+{
+	mat4 model;
+	mat4 normalMatrix;
+	uint material;
+
+	uint lightCount;
+	uint lights[OBJECT_LIGHT_COUNT];
+};
+
+layout (std430, binding = 5) readonly buffer ObjectBuffer { Object objects[]; };	// OBJECT_BINDING, streamed by the opaque pass
+
 uniform mat4 View;
 uniform mat4 Projection;
 
 out vec3 Normal;
 out vec2 TexCoord; 
 out vec3 FragPos;
+flat out uint MaterialIndex;
+flat out uint ObjectIndex;
 
 void main()
 {
+	mat4 Model = objects[aDrawIndex].model;
+
 	TexCoord = aTexCoord;
 	FragPos = vec3(Model * vec4(aPos, 1.0));
 
-	mat3 normalMatrix = transpose(inverse(mat3(Model)));
+	Normal = normalize(mat3(objects[aDrawIndex].normalMatrix) * aNormal);
+	MaterialIndex = objects[aDrawIndex].material;
+	ObjectIndex = aDrawIndex;
 
-	Normal = normalize(normalMatrix * aNormal);;
-	gl_Position = Projection * View * Model * vec4(aPos, 1.0);
+	gl_Position = Projection * View * vec4(FragPos, 1.0);
 }
@@ -5,6 +5,8 @@ uniform sampler2D BloomBlur;
 uniform float Exposure;
 uniform float Gamma;
 uniform bool Bloom;
+uniform float BloomIntensity;
+uniform float Sharpness;
 
 in vec2 TexCoords;
 out vec4 FragColor;
@@ -37,14 +39,39 @@ void setBlurKernel(inout float kernel[9])
     );
 }
 
+// Upscale of a scene drawn under the window size : bilinear, then a contrast adaptive sharpen
+// on the texels of the scene. The negative lobe shrinks where the neighbourhood already has
+// contrast, edges don't ring. Ratios of the min and max keep it the same for HDR values.
+vec3 sampleSharpened()
+{
+    vec3 center = texture(Scene, TexCoords).rgb;
+    if (Sharpness <= 0.0) return center;
+
+    vec2 texel = 1.0 / vec2(textureSize(Scene, 0));
+
+    vec3 north = texture(Scene, TexCoords + vec2(0.0,  texel.y)).rgb;
+    vec3 south = texture(Scene, TexCoords + vec2(0.0, -texel.y)).rgb;
+    vec3 east  = texture(Scene, TexCoords + vec2( texel.x, 0.0)).rgb;
+    vec3 west  = texture(Scene, TexCoords + vec2(-texel.x, 0.0)).rgb;
+
+    vec3 minColor = min(center, min(min(north, south), min(east, west)));
+    vec3 maxColor = max(center, max(max(north, south), max(east, west)));
+
+    vec3 amplitude = sqrt(clamp(minColor / max(maxColor, vec3(1e-4)), 0.0, 1.0));
+    vec3 weight = -amplitude * mix(1.0 / 8.0, 1.0 / 5.0, Sharpness);
+
+    vec3 result = (center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+    return max(result, vec3(0.0));
+}
+
 void main(void) 
 {
-    vec3 hdrColor = texture(Scene, TexCoords).rgb;      
+    vec3 hdrColor = sampleSharpened();
 
     if(Bloom)
     {
         vec3 bloomColor = texture(BloomBlur, TexCoords).rgb;
-        hdrColor += bloomColor; // additive blending
+        hdrColor += bloomColor * BloomIntensity; // additive blending
     
         // tone mapping
         vec3 result = vec3(1.0) - exp(-hdrColor * Exposure);
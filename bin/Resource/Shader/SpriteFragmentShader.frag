@@ -1,12 +1,12 @@
 #version 450 core
 
 in vec2 TexCoords;
+in vec4 Color;
 out vec4 FragColor;
 
-uniform sampler2D Image;
-uniform vec3 SpriteColor;
+layout (binding = 0) uniform sampler2D Image;
 
 void main()
 {    
-    FragColor = vec4(SpriteColor,1.0) * texture(Image, TexCoords);
-}  
\ No newline at end of file
+    FragColor = Color * texture(Image, TexCoords);
+}  
@@ -1,14 +1,18 @@
 #version 450 core
 
-layout (location = 0) in vec4 Vertex; // <vec2 position, vec2 texCoords>
+layout (location = 0) in vec3 aPos;		// already in world space, baked by the QuadBatcher
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColor;
+
 out vec2 TexCoords;
+out vec4 Color;
 
-uniform mat4 Model;
 uniform mat4 View;
 uniform mat4 Projection;
 
 void main()
 {
-    TexCoords = Vertex.zw;
-    gl_Position = Projection * View * Model * vec4(Vertex.xy, 0.0, 1.0);
-}
\ No newline at end of file
+    TexCoords = aTexCoord;
+    Color = aColor;
+    gl_Position = Projection * View * vec4(aPos, 1.0);
+}
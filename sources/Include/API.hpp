@@ -24,13 +24,26 @@ public:
 
 	int		init();
 	void	loading();
-	void	windowLoop();
+
+	//	Play the game in the window, tracePath saves the profilers trace when the window closes
+	void	windowLoop(const std::string& tracePath = "");
+
+	//	Play a scene for a number of fixed frames without window nor GPU, log the timings
+	//	assertNoAlloc fails the run when a frame allocates after HEADLESS_WARMUP_FRAMES
+	int		runHeadless(const std::string& scenePath, int frameCount, bool assertNoAlloc = false);
+
+	//	Load and unload a scene loadCount times without window nor GPU, log the timings
+	//	"synthetic" builds SYNTHETIC_SCENE_OBJECTS objects instead of reading a file
+	int		runSceneBenchmark(const std::string& scenePath, int loadCount);
 
 private:
 
 	//	Internal Private Function
 	//	-------------------------
 
+	//	Kill the singletons, GLFW and ImGui
+	void	shutdown();
+
 	GLFWwindow* m_window;
 	Core::EditorManager m_editor;
 };
\ No newline at end of file
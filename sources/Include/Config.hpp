@@ -12,4 +12,74 @@
 #define MIN_HEIGHT	10.00f;
 
 //	HUD scale depend on it
-#define ORTHOGRAPHIC_SCALE	10.00f;
\ No newline at end of file
+#define ORTHOGRAPHIC_SCALE	10.00f;
+
+//	UI texture atlas, packed at build time with --pack-atlas
+#define UI_ATLAS_LIST	"Assets/UI.atlaslist"
+#define UI_ATLAS		"Assets/UI_atlas"
+
+//	Shader storage bindings of the opaque batches (transforms, material values)
+#define OBJECT_BINDING		5
+#define MATERIAL_BINDING	6
+
+//	Draws of one glMultiDrawElementsIndirect, the per draw index buffer of the mesh arena counts as many
+#define MAX_BATCH_DRAWS		4096
+
+//	Shader storage bindings of the clustered lights
+#define LIGHT_BINDING			2
+#define CLUSTER_BINDING			3
+#define CLUSTER_INDEX_BINDING	4
+
+//	Light budget of a model when its lights are picked per object (see LightSelector), mirrors GpuObject in the shaders
+#define OBJECT_LIGHT_COUNT		8
+
+//	Linked shader programs saved by the driver, reloaded on the next runs
+#define PROGRAM_CACHE_DIR	"Cache/Shaders/"
+
+//	Dynamic resolution : GPU frame time the scene scale aims for (120 Hz), and how low the scale can go
+#define DYNAMIC_RES_TARGET_MS	8.3f
+#define DYNAMIC_RES_MIN_SCALE	0.5f
+
+//	CPU scopes (PROFILE_SCOPE), 0 compiles them out
+#define ENABLE_PROFILER		1
+
+//	Log ring : lines waiting for the writer thread, and the characters kept of a line
+#define LOG_RING_SIZE		4096
+#define LOG_RECORD_SIZE		240
+
+//	Log lines of a category under its level are compiled out (0 info, 1 success, 2 warning, 3 failure, 4 error, 5 none)
+#define LOG_LEVEL_LOADING	0
+#define LOG_LEVEL_SHADERS	0
+
+//	Heap bytes and allocations per subsystem through the global new and delete (see MemoryTracker)
+#define ENABLE_MEMORY_TRACKING	1
+
+//	Job system workers, 0 is one per hardware thread with the main thread counted in
+#define JOB_WORKERS				0
+#define JOB_QUEUE_SIZE			1024	// Jobs a thread can have waiting, a power of two
+#define JOB_EXTERNAL_THREADS	4		// Threads besides the main one and the workers allowed to add jobs (render, loading)
+
+//	Frame arena of a thread : bytes per frame before it chains a heap block, and frames an allocation lives
+#define FRAME_ARENA_SIZE		(1 << 20)
+#define FRAME_ARENA_FRAMES		2
+
+//	Objects per slab of the GameObject and Component pools
+#define POOL_SLAB_OBJECTS		256
+
+//	Chrome trace written by the profilers (chrome://tracing, ui.perfetto.dev)
+#define TRACE_FILE			"trace.json"
+
+//	--capture-stats <frames> [file] : renderer counters of the first frames, one CSV line each
+#define STATS_CAPTURE_FILE	"render_stats.csv"
+
+//	--headless run : scene played without a window, frames simulated at a fixed step
+#define HEADLESS_SCENE		"Assets/NewGame.scn"
+#define HEADLESS_FRAMES		600
+#define HEADLESS_DELTA_TIME	(1.f / 60.f)
+
+//	--assert-no-alloc : the headless run fails when a frame allocates once these frames are played
+#define HEADLESS_WARMUP_FRAMES	120
+
+//	--bench-scene : loads and unloads of the scene timed, and the objects of the "synthetic" scene
+#define BENCH_SCENE_LOADS		10
+#define SYNTHETIC_SCENE_OBJECTS	50000
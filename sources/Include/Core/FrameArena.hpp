@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Config.hpp>
+
+namespace Core
+{
+	//	Linear allocator of a thread for what only lives a frame : a pointer bump per allocation,
+	//	nothing is freed before reset. Each thread has its own (FrameArena::get), reset by that
+	//	thread at its frame boundary. An allocation lives FRAME_ARENA_FRAMES frames : the texts the
+	//	main thread puts in a packet stay valid while the render thread draws it.
+	//	Past FRAME_ARENA_SIZE bytes a frame chains heap blocks, given back on the next reset of that frame.
+	class FrameArena
+	{
+	public:
+		//	Constructor & Destructor
+		//	------------------------
+
+		FrameArena() = default;
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Arena of the calling thread
+		static FrameArena& get();
+
+		//	Memory valid until this frame comes back, FRAME_ARENA_FRAMES resets later
+		//	Parameters : size_t size, size_t alignment
+		//	------------------------------------------
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		T* allocate(size_t count) { return (T*)allocate(count * sizeof(T), alignof(T)); }
+
+		//	Copy of a string
+		//	Parameters : const char* text
+		//	-----------------------------
+		const char* copy(const char* text);
+
+		//	printf in the arena, returns the string
+		//	Parameters : const char* format, ...
+		//	------------------------------------
+		const char* format(const char* format, ...);
+
+		//	Start the next frame : its memory, from FRAME_ARENA_FRAMES frames ago, is reused
+		//	Parameters : None
+		//	-----------------
+		void reset();
+
+		//	Show the bytes of the frames and the heap blocks chained
+		//	Parameters : None
+		//	-----------------
+		void showImGui();
+
+	private:
+
+		struct alignas(16) Block
+		{
+			Block* next;
+			size_t size;
+		};
+
+		struct Frame
+		{
+			Block* first = nullptr;		//	FRAME_ARENA_SIZE, kept
+			Block* current = nullptr;	//	Chained when the first one is full
+			size_t used = 0;			//	Bytes of current
+			size_t bytes = 0;			//	Bytes given this frame
+		};
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		Frame m_frames[FRAME_ARENA_FRAMES];
+		int m_current = 0;
+
+		size_t m_lastBytes = 0;
+		size_t m_peakBytes = 0;
+		unsigned long long m_overflowBlocks = 0;
+
+		static Block* createBlock(size_t size);
+	};
+
+	//	Containers allocating in the arena of the thread that creates them, freeing does nothing
+	//	FrameVector<Collider3*> colliders; lives until the end of the frame at most
+	template<typename T>
+	struct FrameAllocator
+	{
+		using value_type = T;
+
+		FrameArena* arena;
+
+		FrameAllocator() : arena(&FrameArena::get()) {}
+		template<typename U> FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+		T* allocate(size_t count) { return arena->allocate<T>(count); }
+		void deallocate(T*, size_t) {}
+
+		template<typename U> bool operator==(const FrameAllocator<U>& other) const { return arena == other.arena; }
+		template<typename U> bool operator!=(const FrameAllocator<U>& other) const { return arena != other.arena; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+}
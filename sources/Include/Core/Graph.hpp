@@ -64,9 +64,9 @@ namespace Core
 
 		//	Scene management
 		//	-----------------
-		void graphLoop();
+		void graphLoop(FramePacket& packet);
 
-		void drawCurrentScene();
+		void drawCurrentScene(FramePacket& packet);
 		void updateCurrentScene();
 
 		//	Useful functions
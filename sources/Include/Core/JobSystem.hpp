@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
+#include <new>
+
+#include <Config.hpp>
+#include <Utils/Singleton.h>
+#include <Core/MemoryTracker.hpp>
+
+namespace Core
+{
+	class JobCounter;
+
+	//	Worker threads running small jobs, started by API::init.
+	//	Every thread adding jobs has its own queue (Chase-Lev deque) : it pushes and pops at the bottom
+	//	without locking, idle threads steal the oldest jobs at the top. A thread waiting for a counter
+	//	runs jobs meanwhile, a nested parallelFor keeps its thread busy instead of blocking it.
+	//	Jobs are taken from a ring of JOB_QUEUE_SIZE per thread, adding them doesn't allocate.
+	//	Before start, or when the ring is full, a job runs on the spot.
+	class JobSystem : public Singleton<JobSystem>
+	{
+	public:
+		//	Bytes a job can capture
+		static constexpr size_t JOB_DATA_SIZE = 64;
+
+		//	Destructor
+		//	----------
+
+		~JobSystem();
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Start the workers, the calling thread helps them when it waits
+		//	Parameters : unsigned int workerCount (0 for a worker per hardware thread besides this one)
+		//	-------------------------------------------------------------------------------------------
+		void start(unsigned int workerCount = JOB_WORKERS);
+
+		//	Run the jobs left and join the workers
+		//	Parameters : None
+		//	-----------------
+		void stop();
+
+		bool isRunning() const { return m_running; }
+
+		//	Workers and the main thread
+		unsigned int getThreadCount() const { return m_running ? m_workerCount + 1 : 1; }
+
+		//	Add a job counted by counter, held until dependency is done : its jobs are added before this one
+		//	Parameters : JobCounter& counter, const F& function (void()), JobCounter* dependency
+		//	------------------------------------------------------------------------------------
+		template<typename F>
+		void run(JobCounter& counter, const F& function, JobCounter* dependency = nullptr);
+
+		//	Run jobs until every job of the counter is done
+		//	Parameters : JobCounter& counter
+		//	--------------------------------
+		void wait(JobCounter& counter);
+
+		//	Call function(begin, end) over [0, count) on every thread and wait for it.
+		//	Ranges are split while other threads are hungry : a busy frame keeps big chunks,
+		//	an idle one spreads it, never under minGrain indices.
+		//	Parameters : unsigned int count, const F& function (void(unsigned int, unsigned int)), unsigned int minGrain
+		//	------------------------------------------------------------------------------------------------------------
+		template<typename F>
+		void parallelFor(unsigned int count, const F& function, unsigned int minGrain = 1);
+
+		//	Show the threads and the jobs they ran and stole
+		//	Parameters : None
+		//	-----------------
+		void showImGui();
+
+	private:
+		friend class JobCounter;
+
+		struct Job
+		{
+			void (*function)(JobSystem& system, Job& job) = nullptr;
+
+			JobCounter* counter = nullptr;
+			JobCounter* dependency = nullptr;
+
+			//	Next job held by the same dependency
+			Job* nextWaiting = nullptr;
+
+			//	Memory tag of the thread which added it
+			MemoryTag tag = MemoryTag::UNTAGGED;
+
+			//	Set until it's done, the ring skips it meanwhile
+			std::atomic<bool> active{ false };
+
+			alignas(16) unsigned char data[JOB_DATA_SIZE];
+		};
+
+		//	Piece of a parallelFor, in the data of its job
+		struct RangeJob
+		{
+			const void* body;
+			void (*invoke)(const void* body, unsigned int begin, unsigned int end);
+
+			unsigned int begin;
+			unsigned int end;
+			unsigned int grain;
+		};
+
+		//	Chase-Lev deque : the owner pushes and pops at the bottom, the other threads steal at the top
+		class JobQueue
+		{
+		public:
+			bool push(Job* job);
+			Job* pop();
+			Job* steal();
+
+			bool isEmpty() const;
+
+		private:
+			alignas(64) std::atomic<long long> m_top{ 0 };
+			alignas(64) std::atomic<long long> m_bottom{ 0 };
+
+			std::atomic<Job*> m_jobs[JOB_QUEUE_SIZE];
+		};
+
+		struct ThreadSlot
+		{
+			JobQueue queue;
+
+			Job jobs[JOB_QUEUE_SIZE];
+			unsigned int nextJob = 0;
+
+			//	Next victim of a steal
+			unsigned int random = 1;
+
+			std::atomic<unsigned long long> executed{ 0 };
+			std::atomic<unsigned long long> stolen{ 0 };
+		};
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		bool m_running = false;
+		unsigned int m_workerCount = 0;
+
+		//	Main thread, workers, then the external threads in the order they add their first job
+		std::unique_ptr<ThreadSlot[]> m_slots;
+		unsigned int m_slotCount = 0;
+		std::atomic<unsigned int> m_nextSlot{ 0 };
+
+		std::vector<std::thread> m_workers;
+		std::atomic<bool> m_quit{ false };
+
+		//	Idle workers sleep until a job is pushed
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wake;
+		std::atomic<int> m_sleeping{ 0 };
+
+		//	Tells the slots of a stopped system from the ones of the running one
+		static std::atomic<unsigned int> s_generation;
+
+		void threadLoop(unsigned int slot);
+
+		//	Queue of the calling thread, nullptr when not running or no slot is left
+		ThreadSlot* getThreadSlot();
+
+		//	Next job of the ring, nullptr when it comes back to one not done
+		Job* allocateJob(ThreadSlot& slot);
+
+		//	Count the job and push it, or hold it on its dependency until that one is done
+		void submit(ThreadSlot& slot, Job* job);
+
+		//	Push a job ready to run, wake a worker
+		void push(ThreadSlot& slot, Job* job);
+
+		//	Own job first, then the oldest of another thread
+		Job* getJob(ThreadSlot& slot);
+
+		void execute(ThreadSlot& slot, Job* job);
+
+		bool hasWork() const;
+
+		static void executeRange(JobSystem& system, Job& job);
+
+		template<typename F>
+		static void invokeJob(JobSystem& system, Job& job)
+		{
+			F* function = (F*)job.data;
+			(*function)();
+			function->~F();
+		}
+
+		template<typename F>
+		static void invokeRange(const void* body, unsigned int begin, unsigned int end)
+		{
+			(*(const F*)body)(begin, end);
+		}
+	};
+
+	//	Jobs added with it and not done yet, waited with JobSystem::wait or given as a dependency
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		//	Not done while a thread still holds it, the waiter can destroy it once this is true
+		bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0 && !m_locked.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<int> m_pending{ 0 };
+
+		//	Guards the jobs waiting on it and the last decrement, which hands them to a queue
+		std::atomic<bool> m_locked{ false };
+		JobSystem::Job* m_waiting = nullptr;
+
+		void lock() { while (m_locked.exchange(true, std::memory_order_acquire)) std::this_thread::yield(); }
+		void unlock() { m_locked.store(false, std::memory_order_release); }
+	};
+}
+
+
+//	Templates
+//	---------
+
+template<typename F>
+void Core::JobSystem::run(JobCounter& counter, const F& function, JobCounter* dependency)
+{
+	static_assert(sizeof(F) <= JOB_DATA_SIZE, "Job capturing too much, capture a pointer to the data");
+	static_assert(alignof(F) <= 16, "Job capturing an over-aligned type");
+
+	ThreadSlot* slot = getThreadSlot();
+	Job* job = slot ? allocateJob(*slot) : nullptr;
+
+	if (!job)
+	{
+		if (dependency) wait(*dependency);
+		function();
+		return;
+	}
+
+	new (job->data) F(function);
+	job->function = &invokeJob<F>;
+	job->counter = &counter;
+	job->dependency = dependency;
+
+	submit(*slot, job);
+}
+
+template<typename F>
+void Core::JobSystem::parallelFor(unsigned int count, const F& function, unsigned int minGrain)
+{
+	if (count == 0) return;
+
+	ThreadSlot* slot = getThreadSlot();
+	Job* job = slot && count > minGrain ? allocateJob(*slot) : nullptr;
+
+	if (!job)
+	{
+		function(0u, count);
+		return;
+	}
+
+	//	A few pieces per thread at most, they're cut smaller only when stolen
+	unsigned int pieces = getThreadCount() * 4;
+	unsigned int grain = (count + pieces - 1) / pieces;
+
+	RangeJob* range = new (job->data) RangeJob;
+	range->body = &function;
+	range->invoke = &invokeRange<F>;
+	range->begin = 0;
+	range->end = count;
+	range->grain = grain > minGrain ? grain : (minGrain > 0 ? minGrain : 1);
+
+	JobCounter counter;
+	job->function = &executeRange;
+	job->counter = &counter;
+	job->dependency = nullptr;
+
+	submit(*slot, job);
+	wait(counter);
+}
@@ -1,27 +1,92 @@
 #pragma once
 
 #include <string>
-
+#include <ctime>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <Config.hpp>
 #include "Utils/Singleton.h"
 
 namespace Core
 {
+	//	Lowest level written, set at runtime (Log::setLevel) or per category at build time (LOG_LEVEL_*)
+	enum class LogLevel
+	{
+		LEVEL_INFO = 0,
+		LEVEL_SUCCESS,
+		LEVEL_WARNING,
+		LEVEL_FAILURE,
+		LEVEL_ERROR,
+		LEVEL_NONE,
+	};
+
+	//	Lines are pushed in a bounded ring without locking and written by a thread of the log :
+	//	the console and a log file streamed as the game runs. Failures and errors are on disk
+	//	before their call returns, a crash drains what's left in the ring.
+	//	A full ring drops the lines, the count of dropped lines is written once there's room.
 	class Log : public Singleton<Log>
 	{
 	private:
 		//	Private Internal Variables
 		//	-------------------------
 
+		//	Line waiting in the ring, sequence tells whose turn it is to use it
+		struct Record
+		{
+			std::atomic<unsigned long long> sequence{ 0 };
+			time_t time = 0;
+			LogLevel level = LogLevel::LEVEL_INFO;
+			unsigned short length = 0;
+			char text[LOG_RECORD_SIZE];
+		};
+
 		//	Log file name
 		std::string m_logName;
+		FILE* m_file = nullptr;
 
-		//	Content written in log during its creation
-		std::string m_content;
+		std::unique_ptr<Record[]> m_ring;
 
-		//	Write the string in the content
-		//	Parameters : string in_line
-		//	---------------------------
-		void writeInContent(const std::string& in_line);
+		//	Next line pushed, next line written (writer thread only)
+		std::atomic<unsigned long long> m_pushed{ 0 };
+		unsigned long long m_popped = 0;
+
+		//	Lines on disk, the writer thread publishes them after each batch
+		std::atomic<unsigned long long> m_written{ 0 };
+		std::atomic<unsigned long long> m_dropped{ 0 };
+		unsigned long long m_reportedDrops = 0;
+
+		std::atomic<int> m_level{ (int)LogLevel::LEVEL_INFO };
+
+		//	Only one drain at a time : the writer thread or the crash handler
+		std::mutex m_drainMutex;
+
+		std::thread m_thread;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_flushed;
+		bool m_flushRequested = false;
+		bool m_quit = false;
+
+		//	Push a line in the ring, returns its index or -1 when the ring is full
+		//	Parameters : LogLevel level, const char* tag, const char* line, size_t length
+		//	-----------------------------------------------------------------------------
+		long long push(LogLevel level, const char* tag, const char* line, size_t length);
+
+		//	Write the pushed lines to the console and the file, m_drainMutex locked.
+		//	Batched on the stack, the crash handler drains without allocating
+		//	Parameters : None
+		//	-----------------
+		void drain();
+
+		//	Loop of the writer thread
+		void threadLoop();
+
+		//	Write the lines left in the ring, then let the crash go on
+		static void onCrash(int signal);
 
 	public:
 		//	Constructor & Destructor
@@ -35,6 +100,11 @@ namespace Core
 		//	Public Internal Functions
 		//	-------------------------
 
+		//	Write a line of a level, lines under the runtime level are skipped
+		//	Parameters : LogLevel level, string in_line
+		//	-------------------------------------------
+		void writeLine(LogLevel level, const std::string& in_line);
+
 		//	Write the string in the content
 		//	Parameters : string in_line
 		//	---------------------------
@@ -64,5 +134,28 @@ namespace Core
 		//	Parameters : none
 		//	-----------------
 		void breakLine();
+
+		//	Wait until every line pushed so far is written
+		//	Parameters : None
+		//	-----------------
+		void flush();
+
+		void setLevel(LogLevel level) { m_level = (int)level; }
+		LogLevel getLevel() const { return (LogLevel)m_level.load(); }
+
+		//	Show ImGui
+		//	Parameters : None
+		//	-----------------
+		void showImGui();
 	};
-}
\ No newline at end of file
+}
+
+//	LOG_INFO(LOADING, "line") : lines of a category under its LOG_LEVEL_<CATEGORY> (Config.hpp)
+//	are compiled out, their string isn't even built
+#define LOG_LINE(category, level, line)	do { if ((int)Core::LogLevel::level >= LOG_LEVEL_##category) Core::Log::instance()->writeLine(Core::LogLevel::level, line); } while (0)
+
+#define LOG_INFO(category, line)		LOG_LINE(category, LEVEL_INFO, line)
+#define LOG_SUCCESS(category, line)		LOG_LINE(category, LEVEL_SUCCESS, line)
+#define LOG_WARNING(category, line)		LOG_LINE(category, LEVEL_WARNING, line)
+#define LOG_FAILURE(category, line)		LOG_LINE(category, LEVEL_FAILURE, line)
+#define LOG_ERROR(category, line)		LOG_LINE(category, LEVEL_ERROR, line)
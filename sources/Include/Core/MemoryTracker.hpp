@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Config.hpp>
+
+namespace Core
+{
+	//	Subsystem charged for an allocation
+	enum class MemoryTag
+	{
+		UNTAGGED = 0,
+		RESOURCES,
+		PHYSICS,
+		RENDERER,
+		SCENE,
+		PARTICLES,
+		TEXT,
+		LOG,
+
+		COUNT,
+	};
+
+	//	Bytes and allocation counts per subsystem, on the heap and on the GPU.
+	//	The global new and delete (ENABLE_MEMORY_TRACKING) put the size and tag of each block
+	//	in a header : a block is given back to the tag it was taken from, whichever thread frees it.
+	//	The tag of an allocation is the one of the thread at that time (MEMORY_TAG), or the
+	//	one of a TaggedAllocator. GPU bytes are declared where textures and buffers are created.
+	//	No singleton : new runs before main and inside the singletons.
+	class MemoryTracker
+	{
+	public:
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Allocate a tracked block
+		//	Parameters : size_t size, MemoryTag tag
+		//	---------------------------------------
+		static void* allocate(size_t size, MemoryTag tag);
+
+		//	Free a block of allocate(), nullptr does nothing
+		//	Parameters : void* pointer
+		//	--------------------------
+		static void release(void* pointer);
+
+		//	Add the bytes of a texture or buffer created (or removed when negative)
+		//	Parameters : MemoryTag tag, long long bytes
+		//	-------------------------------------------
+		static void addGpuBytes(MemoryTag tag, long long bytes);
+
+		//	Tag of the allocations of the calling thread, returns the previous one
+		//	Parameters : MemoryTag tag
+		//	--------------------------
+		static MemoryTag setThreadTag(MemoryTag tag);
+		static MemoryTag getThreadTag();
+
+		//	Close the allocation count of the last frame, on the main thread
+		//	Parameters : None
+		//	-----------------
+		static void beginFrame();
+
+		//	Allocations of every thread during the last frame
+		static unsigned long long getFrameAllocations();
+
+		//	Write the blocks still allocated per tag in the log, when the game exits
+		//	Parameters : None
+		//	-----------------
+		static void logLiveAllocations();
+
+		//	Show ImGui
+		//	Parameters : None
+		//	-----------------
+		static void showImGui();
+
+		static const char* getTagName(MemoryTag tag);
+	};
+
+	//	Charge the allocations of the calling thread to a tag during its lifetime, see MEMORY_TAG
+	class MemoryScope
+	{
+	public:
+		MemoryScope(MemoryTag tag) : m_previous(MemoryTracker::setThreadTag(tag)) {}
+		~MemoryScope() { MemoryTracker::setThreadTag(m_previous); }
+
+		MemoryScope(const MemoryScope&) = delete;
+		MemoryScope& operator=(const MemoryScope&) = delete;
+
+	private:
+		MemoryTag m_previous;
+	};
+
+	//	Containers charged to a tag whatever the thread tag, std::vector<T, TaggedAllocator<T, MemoryTag::PHYSICS>>
+	template<typename T, MemoryTag Tag>
+	struct TaggedAllocator
+	{
+		using value_type = T;
+
+		template<typename U>
+		struct rebind { using other = TaggedAllocator<U, Tag>; };
+
+		TaggedAllocator() = default;
+		template<typename U> TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+		T* allocate(size_t count) { return (T*)MemoryTracker::allocate(count * sizeof(T), Tag); }
+		void deallocate(T* pointer, size_t) { MemoryTracker::release(pointer); }
+
+		template<typename U> bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+		template<typename U> bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+	};
+}
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+
+//	MEMORY_TAG(PHYSICS) charges the allocations of the rest of the block to Physics
+#define MEMORY_TAG(tag)		Core::MemoryScope MEMORY_CONCAT(memoryScope, __LINE__)(Core::MemoryTag::tag)
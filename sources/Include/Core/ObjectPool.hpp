@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <typeinfo>
+
+#include <Config.hpp>
+
+namespace Core
+{
+	//	Slabs of POOL_SLAB_OBJECTS objects of a type, side by side. A destroyed object goes on a free
+	//	list and its slot is the next one given, a new slab is only taken when the list is empty.
+	//	The slabs are given back all at once by trim, when the last object of the pool is gone
+	//	(a scene unloaded) : no free per object. Main thread only, as the scenes.
+	class PoolBase
+	{
+	public:
+		//	Constructor & Destructor
+		//	------------------------
+
+		PoolBase(const char* name, size_t objectSize, size_t alignment);
+		~PoolBase();
+
+		PoolBase(const PoolBase&) = delete;
+		PoolBase& operator=(const PoolBase&) = delete;
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Memory of an object, the last slot freed or the next one of the slabs
+		//	Parameters : None
+		//	-----------------
+		void* allocate();
+
+		//	Give back the slot of an object already destroyed
+		//	Parameters : void* object
+		//	-------------------------
+		void release(void* object);
+
+		//	Free the slabs if no object of the pool is alive
+		//	Parameters : None
+		//	-----------------
+		void trim();
+
+		//	Trim every pool, after a scene is unloaded
+		//	Parameters : None
+		//	-----------------
+		static void trimAll();
+
+		//	Show the objects and slabs of every pool
+		//	Parameters : None
+		//	-----------------
+		static void showImGui();
+
+		size_t getLiveCount() const { return m_live; }
+		size_t getSlabCount() const { return m_slabCount; }
+
+	private:
+
+		struct alignas(16) Slab
+		{
+			Slab* next;
+		};
+
+		//	What a free slot holds
+		struct Slot
+		{
+			Slot* next;
+		};
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		const char* m_name;
+		size_t m_stride;
+
+		Slab* m_slabs = nullptr;
+		Slot* m_free = nullptr;
+
+		size_t m_live = 0;
+		size_t m_peakLive = 0;
+		size_t m_slabCount = 0;
+
+		//	Every pool created, for trimAll and the panel
+		PoolBase* m_nextPool = nullptr;
+		static PoolBase*& getPools();
+	};
+
+	//	Pool of a type, created on its first use
+	//	Model* model = ObjectPool<Model>::get().create(gameObject);
+	template<typename T>
+	class ObjectPool : public PoolBase
+	{
+	public:
+		static ObjectPool& get()
+		{
+			static ObjectPool pool;
+			return pool;
+		}
+
+		template<typename... Args>
+		T* create(Args&&... args) { return new (allocate()) T(std::forward<Args>(args)...); }
+
+		void destroy(T* object)
+		{
+			object->~T();
+			release(object);
+		}
+
+	private:
+		ObjectPool() : PoolBase(typeid(T).name(), sizeof(T), alignof(T)) {}
+	};
+}
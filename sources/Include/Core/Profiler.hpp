@@ -0,0 +1,184 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <algorithm>
+
+#include <Config.hpp>
+#include <Utils/Singleton.h>
+
+namespace Core
+{
+	//	CPU time of named scopes on every thread, for a flame view of the last frames and a Chrome trace.
+	//	Each thread writes the scopes it ends in a ring of its own without locking, the main
+	//	thread collects the rings once per frame. Times are steady_clock nanoseconds, the clock
+	//	the GpuProfiler puts its timestamps on, both end up on the same trace.
+	//	Scope names are string literals, only their pointer is kept. The kept scopes and frames
+	//	are fixed rings as the history of the GpuProfiler, a frame doesn't allocate.
+	class Profiler : public Singleton<Profiler>
+	{
+	public:
+		//	Frames kept for the flame view and the trace
+		static constexpr int FRAMES = 120;
+
+		//	Scopes a thread can end between two collections
+		static constexpr unsigned int THREAD_EVENTS = 1 << 14;
+
+		//	Scopes of a thread kept for the flame view and the trace, the oldest go once it's full
+		static constexpr unsigned int HISTORY_EVENTS = 1 << 14;
+
+		//	Constructor & Destructor
+		//	------------------------
+
+		Profiler();
+		~Profiler();
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Start a frame of the main thread, collect the scopes every thread ended since the last one
+		//	Parameters : None
+		//	-----------------
+		void beginFrame();
+
+		//	Name the calling thread in the flame view and the trace
+		//	Parameters : const char* name
+		//	-----------------------------
+		void setThreadName(const char* name);
+
+		//	Open a scope on the calling thread, returns its depth
+		//	Parameters : None
+		//	-----------------
+		int beginScope();
+
+		//	Close the last scope of the calling thread
+		//	Parameters : const char* name, long long start, int depth
+		//	---------------------------------------------------------
+		void endScope(const char* name, long long start, int depth);
+
+		//	Write the scopes of the kept frames as Chrome trace events
+		//	Parameters : std::ostream& out, bool& first (no comma before the first event of the list)
+		//	-----------------------------------------------------------------------------------------
+		void writeTraceEvents(std::ostream& out, bool& first);
+
+		//	Write the CPU and GPU scopes of the kept frames in a Chrome trace (chrome://tracing, ui.perfetto.dev)
+		//	Parameters : const std::string& path
+		//	------------------------------------
+		void saveTrace(const std::string& path);
+
+		//	Show the frame graph and the flame view of a kept frame
+		//	Parameters : None
+		//	-----------------
+		void showImGui();
+
+		//	Nanoseconds of the steady_clock
+		static long long getTicks();
+
+	private:
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		struct Event
+		{
+			const char* name = nullptr;
+			long long start = 0;
+			long long end = 0;
+			int depth = 0;
+		};
+
+		struct ThreadBuffer
+		{
+			//	Written by its thread only, head is published once the event is
+			Event events[THREAD_EVENTS];
+			std::atomic<unsigned long long> head{ 0 };
+			int depth = 0;
+
+			//	Read by the main thread only, the collected events are history[historyTail, historyHead)
+			unsigned long long tail = 0;
+			Event history[HISTORY_EVENTS];
+			unsigned long long historyHead = 0;
+			unsigned long long historyTail = 0;
+			unsigned long long dropped = 0;
+
+			std::string name;
+
+			//	Set when its thread ends, the next new thread takes the ring over
+			std::atomic<bool> exited{ false };
+		};
+
+		//	Held by each thread, releases its ring when the thread ends
+		struct ThreadSlot
+		{
+			unsigned int profiler = 0;
+			ThreadBuffer* buffer = nullptr;
+
+			~ThreadSlot();
+		};
+
+		//	Tells the rings of a killed profiler from the ones of the live one
+		static std::atomic<unsigned int> s_nextId;
+		static std::atomic<unsigned int> s_liveId;
+		unsigned int m_id;
+
+		//	Guards the list of threads and their names
+		std::mutex m_mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+		//	Start of the frames of the main thread, the FRAMES + 1 last ones are kept
+		long long m_frameStarts[FRAMES + 1] = {};
+		unsigned long long m_frameCount = 0;
+
+		bool m_paused = false;
+		int m_frameOffset = 0;
+
+		//	Ring of the calling thread, registered on its first scope
+		ThreadBuffer* getThreadBuffer();
+
+		//	Move the ended scopes of a ring to its collected events
+		void collect(ThreadBuffer& buffer);
+
+		//	Frames kept, and the start of one of them (0 is the oldest)
+		int getKeptFrames() const { return (int)std::min(m_frameCount, (unsigned long long)FRAMES + 1); }
+		long long getFrameStart(int frame) const { return m_frameStarts[(m_frameCount - getKeptFrames() + frame) % (FRAMES + 1)]; }
+	};
+
+	//	Time the code run during its lifetime, see PROFILE_SCOPE
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const char* name) : m_name(name), m_depth(Profiler::instance()->beginScope()), m_start(Profiler::getTicks()) {}
+		~ProfileScope() { Profiler::instance()->endScope(m_name, m_start, m_depth); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_name;
+		int m_depth;
+		long long m_start;
+	};
+}
+
+//	PROFILE_SCOPE("Physics") times the rest of the block, nothing is left of it with ENABLE_PROFILER at 0
+#if ENABLE_PROFILER
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#define PROFILE_SCOPE(name)			Core::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name)		Core::Profiler::instance()->setThreadName(name)
+#define PROFILE_BEGIN_FRAME()		Core::Profiler::instance()->beginFrame()
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_BEGIN_FRAME()
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+#include <Utils/Singleton.h>
+
+#include <LowRenderer/FramePacket.hpp>
+
+namespace Core
+{
+	//	Thread owning the GL context while the game runs.
+	//	The main thread updates the scene and extracts it in a FramePacket, the render
+	//	thread draws the previous packet meanwhile. Two packets are used in turn, the
+	//	submitted / rendered frame counts are the fences telling when one is free again.
+	//	Without the thread (editor, --single-thread) the packet is drawn right away.
+	class RenderThread : public Singleton<RenderThread>
+	{
+	public:
+		//	Constructor & Destructor
+		//	------------------------
+
+		RenderThread() = default;
+		~RenderThread();
+
+
+		//	Public Internal Variables
+		//	-------------------------
+
+		//	Set by --single-thread, every frame is then drawn by the main thread
+		bool m_enabled = true;
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Packet of the next frame, waits until the render thread is done with the frame it last held
+		//	Parameters : None
+		//	-----------------
+		FramePacket& beginFrame();
+
+		//	Draw the packet of beginFrame(), on the render thread if threaded or right away
+		//	Parameters : bool threaded
+		//	--------------------------
+		void submit(bool threaded);
+
+		//	Wait for the submitted frames and take the GL context back on the main thread
+		//	Needed before any GL call outside of a packet (scene loading, editor)
+		//	Parameters : None
+		//	-----------------
+		void acquireContext();
+
+		//	Join the render thread, the main thread keeps the context
+		//	Parameters : None
+		//	-----------------
+		void stop();
+
+		//	Show ImGui
+		//	Parameters : None
+		//	-----------------
+		void showImGui();
+
+	private:
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		//	Frame times summed over several frames, in ms
+		struct FrameTimes
+		{
+			double frameMs = 0.0;	//	Between two beginFrame()
+			int frames = 0;
+
+			double mainMs = 0.0;	//	Update, extraction and ImGui
+			double waitMs = 0.0;	//	Main thread blocked on the packet fence
+			int mainFrames = 0;
+
+			double renderMs = 0.0;	//	Draws of the packet
+			double swapMs = 0.0;
+			int renderFrames = 0;
+
+			//	Time both threads were busy
+			double getOverlapMs() const;
+		};
+
+		FramePacket m_packets[2];
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+
+		//	Fences : the packet of frame N is free again once m_renderedFrames > N
+		unsigned long long m_submittedFrames = 0;
+		unsigned long long m_renderedFrames = 0;
+
+		bool m_threaded = false;
+		bool m_mainHasContext = true;
+		bool m_renderHasContext = false;
+		bool m_releaseContext = false;
+		bool m_quit = false;
+
+		Clock::time_point m_frameStart;
+		Clock::time_point m_mainStart;
+		bool m_hasFrameStart = false;
+
+		//	Last STATS_FRAMES frames, their average, and the whole run in the current mode
+		FrameTimes m_window;
+		FrameTimes m_average;
+		FrameTimes m_run;
+
+		//	Draw a packet and swap, on the thread holding the context
+		void render(FramePacket& packet);
+
+		//	Loop of the render thread
+		void threadLoop();
+
+		//	Add the times of a drawn packet, m_mutex locked
+		void addRenderTimes(const FramePacket& packet);
+
+		//	Write the average times of the run in the log
+		void logRun();
+	};
+}
@@ -4,7 +4,12 @@
 #include <LowRenderer/CameraEditor.hpp>
 #include <LowRenderer/CameraHUD.hpp>
 #include <LowRenderer/PostProcessor.hpp>
+#include <LowRenderer/RenderGraph.hpp>
 #include <LowRenderer/CubeMap.hpp>
+#include <LowRenderer/GpuRingBuffer.hpp>
+#include <LowRenderer/LightClusters.hpp>
+#include <LowRenderer/LightSelector.hpp>
+#include <LowRenderer/DynamicResolution.hpp>
 
 class Light;
 class Camera;
@@ -12,6 +17,7 @@ class Model;
 class Sprite;
 class ParticleSystem;
 class SpriteBillboard;
+class FramePacket;
 
 namespace Core
 {
@@ -24,10 +30,32 @@ namespace Core
 
 		int m_activeCamera;
 
-		//	Send datas to all shaders
-		//	Parameters : None
-		//	-----------------
-		void sendDatasToGPU(const CameraBase& activeCamera);
+		//	Send datas to all shaders, the scene targets are drawn at renderScale of the window
+		//	Parameters : const CameraBase& activeCamera, float renderScale
+		//	--------------------------------------------------------------
+		void sendDatasToGPU(const CameraBase& activeCamera, float renderScale = 1.f);
+
+		//	Scene pass : skybox, models and translucent quads
+		//	Parameters : FramePacket& packet
+		//	--------------------------------
+		void drawScene(FramePacket& packet);
+
+		//	HUD pass : sprites and texts over the composited scene
+		//	Parameters : const FramePacket& packet
+		//	--------------------------------------
+		void drawHUD(const FramePacket& packet);
+
+		//	Packet extracted last, read by the ImGui of the same frame
+		const FramePacket* m_packet = nullptr;
+
+		//	Packet drawn by the passes of the graph, set by render()
+		FramePacket* m_renderedPacket = nullptr;
+
+		//	What the graph was built with, it's described again when one changes
+		float m_graphScale = -1.f;
+		int m_graphWidth = 0;
+		int m_graphHeight = 0;
+		int m_graphPostProcess = -1;
 
 	public:
 
@@ -48,6 +76,23 @@ namespace Core
 
 		PostProcessor m_postProcess;
 
+		//	Passes of the frame, kept across frames and rebuilt by render() when the scale,
+		//	the window size or the post process settings change
+		RenderGraph m_renderGraph;
+
+		//	Transforms and material values of the opaque batches, and their indirect commands
+		GpuRingBuffer m_storageRing;
+		GpuRingBuffer m_commandRing;
+
+		LightClusters m_lightClusters;
+
+		//	Lighter than clustering : each model gets its OBJECT_LIGHT_COUNT most influential lights
+		LightSelector m_lightSelector;
+		bool m_objectLights = false;
+
+		//	Scale of the scene targets, the HUD is drawn over the composite at the window size
+		DynamicResolution m_dynamicResolution;
+
 		std::unordered_map<int, const Light*> m_lightList;
 		std::unordered_map<int, CameraBase*> m_cameraList;
 		std::unordered_map<int, Model*> m_modelList;
@@ -63,10 +108,20 @@ namespace Core
 		//	-----------------
 		void update();
 
-		//	Draw saved models
+		//	Copy what the frame draws in packet, on the main thread
+		//	Parameters : FramePacket& packet
+		//	--------------------------------
+		void extract(FramePacket& packet);
+
+		//	Draw an extracted frame, on the thread holding the GL context
+		//	Parameters : FramePacket& packet
+		//	--------------------------------
+		void render(FramePacket& packet);
+
+		//	Build the shader variants of the scene renderers, to not compile them while playing
 		//	Parameters : None
 		//	-----------------
-		void draw();
+		void prewarmShaders();
 
 
 		//	Show ImGui
@@ -21,6 +21,9 @@ namespace Core
 		float timeScale = 1.f;
 
 		void setDeltaTime();
+
+		//	Advance by a fixed step instead of the clock, for reproducible runs
+		void setDeltaTime(float fixedDelta);
 		void setFixedDeltaTime();
 
 		bool fixedDeltaTimeLoop();
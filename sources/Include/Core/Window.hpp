@@ -11,6 +11,9 @@ namespace Core
 	public:
 		Window();
 
+		//	Set by --headless : no GLFW window, the null render device is loaded
+		static bool s_headless;
+
 		GLFWwindow* m_window = nullptr;
 
 		int		m_width;
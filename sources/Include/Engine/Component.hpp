@@ -6,6 +6,10 @@
 
 class GameObject;
 class Transform3;
+namespace Core
+{
+	class PoolBase;
+}
 namespace Physics
 {
 	class Collider3;
@@ -42,6 +46,41 @@ enum class ComponentType
 	COUNT,
 };
 
+//	A bit per ComponentType
+typedef unsigned int ComponentMask;
+static_assert((int)ComponentType::COUNT <= 32, "ComponentMask has a bit per component type");
+
+constexpr ComponentMask getComponentMask() { return 0u; }
+
+template<typename... Types>
+constexpr ComponentMask getComponentMask(ComponentType type, Types... types)
+{
+	return (1u << (int)type) | getComponentMask(types...);
+}
+
+//	Lowest type of a mask, COUNT when it is empty
+constexpr int getFirstComponentType(ComponentMask mask)
+{
+	int type = 0;
+	while (type < (int)ComponentType::COUNT && (mask & (1u << type)) == 0) type++;
+	return type;
+}
+
+//	Compile-time ID of a component class : the mask of the types a C* can point to,
+//	its own or those of the classes deriving from it. Declared after each class with COMPONENT_ID,
+//	GameObject::getComponent<C> doesn't compile for a class without one.
+template<typename C>
+struct ComponentId;
+
+//	COMPONENT_ID(Physics::Collider3, ComponentType::SphereCollider3D, ComponentType::BoxCollider3D);
+#define COMPONENT_ID(C, ...)																	\
+	template<>																					\
+	struct ComponentId<C>																		\
+	{																							\
+		static constexpr ComponentMask mask = getComponentMask(__VA_ARGS__);					\
+		static constexpr int type = getFirstComponentType(mask);								\
+	}
+
 
 class ComponentTypeInfo : public Singleton<ComponentTypeInfo>
 {
@@ -93,6 +132,12 @@ public:
 	GameObject* m_gameObject = nullptr;
 	Transform3* m_transform  = nullptr;
 
+	//	Pool of its type when added by GameObject::addComponent, nullptr when created with new
+	Core::PoolBase* m_pool = nullptr;
+
+	//	Index in the array of its type in the scene (Scene::m_components), -1 when not in one
+	int m_sceneIndex = -1;
+
 	std::string m_name = "";
 
 	int m_type = -1;
@@ -130,6 +175,12 @@ public:
 	void showImGUIComponent();
 
 	virtual void destroy();
+
+	//	Destruct the component and give its memory back, it stays in the component list of its GameObject
+	//	Parameters : None
+	//	-----------------
+	void release();
+
 	virtual void showImGUI() = 0;
 	virtual void saveComponentInSCNFile(std::ofstream& file) = 0;
 	virtual void loadComponentFromSCNFile(std::istringstream& lineStream) = 0;
@@ -4,6 +4,8 @@
 #include <Engine/Layers.hpp>
 #include <Engine/Transform3.hpp>
 
+#include <Core/ObjectPool.hpp>
+
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -31,28 +33,22 @@ private:
 	//	Private Internal Functions
 	//	--------------------------
 
-	template<typename C, typename Requires = std::enable_if_t<std::is_base_of<Component, C>::value>>
-	bool tryGetComponentIndex(int& i)
+	//	First component of the lowest type of the mask the object has, nullptr if none
+	//	Parameters : ComponentMask mask
+	//	-------------------------------
+	Component* findComponent(ComponentMask mask) const
 	{
-		for (i = 0; i < (int)m_componentList.size(); i++)
-		{
-			if (m_componentList[i] == nullptr) continue;
-
-			if (dynamic_cast<C*>(m_componentList[i]) != nullptr)
-			{
-				return true;
-			}
-		}
-		return false;
+		mask &= m_componentMask;
+		return mask ? m_componentTable[getFirstComponentType(mask)] : nullptr;
 	}
 
-	//	Check if a unique component is already in the component list
+	//	Check if a component of this type is already in the component list
 	//	Parameters : int i
 	//	------------------
 	bool HasUniqueComponentOfType(const int i);
 
 
-	//	Check if a unique component is already in the component list
+	//	Add a component of this type, from the registry of the component classes
 	//	Parameters : int i
 	//	------------------
 	void addComponentOfType(const int i);
@@ -63,6 +59,10 @@ private:
 	bool manuallyDisabled = false;
 	int m_key;
 
+	//	Types of its components, and the first component of each type
+	ComponentMask m_componentMask = 0;
+	Component* m_componentTable[(int)ComponentType::COUNT] = {};
+
 public:
 	//	Construcor
 	//	----------
@@ -72,13 +72,17 @@ public:
 
 	~GameObject();
 
+	//	GameObjects are made in their pool, side by side (ObjectPool<GameObject>)
+	static void* operator new(size_t size);
+	static void operator delete(void* pointer);
+
 	//	Public Internal Variables
 	//	-------------------------
 
 	LayerData m_layer;
 
 	std::string m_name;
-	std::unordered_map<int, Component*> m_componentList;
+	std::vector<Component*> m_componentList;
 
 	bool m_isEnabled = true;
 	bool m_isStatic = false;
@@ -91,24 +95,30 @@ public:
 	//	-------------------------
 
 	//	Add Component, and return the new component
+	//	Components of a type are made in their pool (ObjectPool<C>)
 	//	Parameters : none
 	//  -----------------
 	template<typename C, typename Requires = std::enable_if_t<std::is_base_of<Component, C>::value>>
 	C* addComponent()
 	{
-		int i;
+		Component* found = findComponent(ComponentId<C>::mask);
 
-		if (tryGetComponentIndex<C>(i))
+		if (found)
 		{
 			ComponentTypeInfo* _componentManager = ComponentTypeInfo::instance();
 
 			//	If is a unique component return
-			if (_componentManager->m_componentList[m_componentList[i]->m_type].isUnique) return nullptr;
+			if (_componentManager->m_componentList[found->m_type].isUnique) return nullptr;
 		}
-		int index = (int)m_componentList.size();
-		m_componentList[index] = new C(this);
 
-		return dynamic_cast<C*>(m_componentList[index]);
+		Core::ObjectPool<C>& pool = Core::ObjectPool<C>::get();
+		C* component = pool.create(this);
+		component->m_pool = &pool;
+
+		m_componentList.push_back(component);
+		registerComponent(component);
+
+		return component;
 	}
 
 	//	Return true if successfully got the expected component and out is the pointer of the found component
@@ -117,34 +127,19 @@ public:
 	template<typename C, typename Requires = std::enable_if_t<std::is_base_of<Component, C>::value>>
 	bool tryGetComponent(C** out)
 	{
-		for (auto comp : m_componentList)
-		{
-			*out = dynamic_cast<C*>(comp.second);
-
-			if (*out) return true;
-			
-		}
+		*out = getComponent<C>();
 
-		*out = nullptr;
-
-		return false;
+		return *out != nullptr;
 	}
 
-	//	Return the awaited component 
+	//	Return the awaited component, from the type table : no search in the component list
 	//	Be sure that the gameObject contain this component at least once
 	//	Parameters : none
 	//  -----------------
 	template<typename C, typename Requires = std::enable_if_t<std::is_base_of<Component, C>::value>>
 	C* getComponent()
 	{
-		int i;
-
-		if (tryGetComponentIndex<C>(i))
-		{
-			return dynamic_cast<C*>(m_componentList[i]);
-		}
-
-		return nullptr;
+		return static_cast<C*>(findComponent(ComponentId<C>::mask));
 	}
 
 	//	If the current gameObject doesn't have any component of type C,
@@ -154,8 +149,8 @@ public:
 	template<typename C, typename Requires = std::enable_if_t<std::is_base_of<Component, C>::value>>
 	C* requireComponent()
 	{
-		int i;
-		if (tryGetComponentIndex<C>(i)) return dynamic_cast<C*>(m_componentList[i]);
+		C* component = getComponent<C>();
+		if (component) return component;
 		
 		return addComponent<C>();
 	}
@@ -176,6 +171,16 @@ public:
 		return false;
 	}
 
+	//	Put a new component of the list in the type table, and in the array of its type in the scene
+	//	Parameters : Component* component
+	//	---------------------------------
+	void registerComponent(Component* component);
+
+	//	Take a component going away out of the type table and of the scene, it stays in the list
+	//	Parameters : Component* component
+	//	---------------------------------
+	void unregisterComponent(Component* component);
+
 	void showImGUIGameObject();
 
 	void loadFromScnFile(std::ifstream& file, Resources::Scene& m_scene);
@@ -116,3 +116,5 @@ public:
 	void loadComponentFromSCNFile(std::istringstream& lineStream) override;
 
 };
+
+COMPONENT_ID(Transform3, ComponentType::Transform);
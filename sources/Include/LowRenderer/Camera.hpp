@@ -45,3 +45,5 @@ public:
     //Transform 
     //float displacement_speed = DISPLACEMENT_SPEED;
 };
+
+COMPONENT_ID(Camera, ComponentType::Camera);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Config.hpp>
+
+//	Scale of the window the scene targets are drawn at, steered by the GPU frame time.
+//	The frame time is smoothed, the scale drops as soon as it goes over the target and
+//	only climbs back a step at a time once it's well under : a step up can't push the
+//	frame back over, the scale doesn't swing between two values.
+//	CPU only, it can be driven without a GL context.
+class DynamicResolution
+{
+public:
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Take the GPU time of the last measured frame, returns the scale of the next one
+	//	Parameters : float gpuFrameMs (0 when no frame was measured yet)
+	//	----------------------------------------------------------------
+	float update(float gpuFrameMs);
+
+	float getScale() const { return m_scale; }
+	float getSmoothedMs() const { return m_smoothedMs; }
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+	//	Public Internal Variables
+	//	-------------------------
+
+	bool m_enabled = false;
+	float m_targetMs = DYNAMIC_RES_TARGET_MS;
+	float m_minScale = DYNAMIC_RES_MIN_SCALE;
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	float m_scale = 1.f;
+	float m_smoothedMs = 0.f;
+
+	//	Frames left before the next change, the profiler reads frames late
+	int m_cooldown = 0;
+	unsigned int m_changes = 0;
+};
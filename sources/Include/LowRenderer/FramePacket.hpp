@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+#include <imgui.h>
+
+#include <LowRenderer/CameraBase.hpp>
+#include <LowRenderer/LightClusters.hpp>
+#include <LowRenderer/OpaquePass.hpp>
+#include <LowRenderer/TranslucentPass.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/Model.hpp>
+#include <LowRenderer/Text.hpp>
+#include <LowRenderer/RenderStats.hpp>
+
+namespace Core
+{
+	class RendererManager;
+}
+
+//	Camera copied at extraction, the render thread never reads the component
+class CameraSnapshot : public CameraBase
+{
+public:
+	//	Constructors
+	//	------------
+
+	CameraSnapshot() = default;
+	CameraSnapshot(const CameraBase& camera);
+
+	Maths::Mat4x4 getViewMatrix() const override { return m_view; }
+	Vector3f getPosition() const override { return m_position; }
+
+private:
+	Maths::Mat4x4 m_view = Maths::mat4x4Identity();
+	Vector3f m_position;
+};
+
+//	Everything the renderer reads to draw a frame, copied from the scene at the
+//	end of its update. The render thread draws packet N while the main thread
+//	updates the scene and fills packet N+1.
+class FramePacket
+{
+public:
+	//	Constructor & Destructor
+	//	------------------------
+
+	FramePacket() = default;
+	~FramePacket();
+
+	FramePacket(const FramePacket&) = delete;
+	FramePacket& operator=(const FramePacket&) = delete;
+
+
+	//	Public Internal Variables
+	//	-------------------------
+
+	//	Renderer of the scene, only its GL side is used by the render thread
+	Core::RendererManager* renderer = nullptr;
+
+	bool hasCamera = false;
+	CameraSnapshot camera;
+	CameraSnapshot hudCamera;
+
+	std::vector<GpuLight> lights;
+
+	//	Models read the lights picked for them instead of the clusters
+	bool objectLights = false;
+	OpaquePass opaquePass;
+	TranslucentPass translucentPass;
+
+	std::vector<QuadItem> hudQuads;
+	std::vector<TextRender::TextParameter> texts;
+
+	//	ImGui lists to draw, the packet copy when another thread draws them
+	ImDrawData* imguiData = nullptr;
+
+	//	Counters of the extraction, the render thread adds its own
+	FrameStats stats;
+
+	//	Written by the thread that drew the packet
+	double renderMs = 0.0;
+	double swapMs = 0.0;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Empty the packet, keep the capacity of its lists
+	//	Parameters : None
+	//	-----------------
+	void clear();
+
+	//	Copy the draw lists, ImGui reuses its own at the next NewFrame()
+	//	Parameters : const ImDrawData* source
+	//	-------------------------------------
+	void copyImGui(const ImDrawData* source);
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	ImDrawData m_imguiCopy;
+	ImVector<ImDrawList*> m_imguiLists;
+
+	//	Delete the copied lists, on the main thread as ImGui counts its allocations
+	void freeImGui();
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <Utils/Singleton.h>
+
+//	Shadow copy of the GL state the engine touches.
+//	Every bind goes through it so calls that wouldn't change anything are skipped.
+//	Objects must be forgotten when deleted as GL may hand their name out again.
+class GLState : public Singleton<GLState>
+{
+public:
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Parameters : GLuint program
+	//	---------------------------
+	void useProgram(GLuint program);
+
+	//	Parameters : GLuint vertexArray
+	//	-------------------------------
+	void bindVertexArray(GLuint vertexArray);
+
+	//	Bind a 2D or cube map texture on a unit, other targets aren't cached
+	//	Parameters : GLenum target, GLuint texture, GLuint unit
+	//	-------------------------------------------------------
+	void bindTexture(GLenum target, GLuint texture, GLuint unit);
+
+	//	Bind a texture on the active unit, to create or update it
+	//	Parameters : GLenum target, GLuint texture
+	//	------------------------------------------
+	void bindTexture(GLenum target, GLuint texture);
+
+	//	Parameters : GLuint framebuffer
+	//	-------------------------------
+	void bindFramebuffer(GLuint framebuffer);
+
+	//	Enable or disable a capability, only blend, depth test and face culling are cached
+	//	Parameters : GLenum capability, bool enabled
+	//	--------------------------------------------
+	void setEnabled(GLenum capability, bool enabled);
+
+	void enable(GLenum capability)	{ setEnabled(capability, true); }
+	void disable(GLenum capability) { setEnabled(capability, false); }
+
+	//	Parameters : GLenum source, GLenum destination
+	//	----------------------------------------------
+	void blendFunc(GLenum source, GLenum destination);
+
+	//	Parameters : bool write
+	//	-----------------------
+	void depthMask(bool write);
+
+	//	Forget deleted objects, they are unbound by GL
+	//	Parameters : GLuint name
+	//	------------------------
+	void forgetVertexArray(GLuint vertexArray);
+	void forgetTexture(GLuint texture);
+	void forgetFramebuffer(GLuint framebuffer);
+
+	//	Reset the frame counters
+	//	Parameters : None
+	//	-----------------
+	void resetStats();
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	static constexpr int TEXTURE_UNITS = 16;
+
+	//	Capabilities state : -1 unknown, 0 disabled, 1 enabled
+	enum Capability { BLEND, DEPTH_TEST, CULL_FACE, CAPABILITY_COUNT };
+
+	GLuint m_program = 0;
+	GLuint m_vertexArray = 0;
+	GLuint m_framebuffer = 0;
+
+	GLuint m_activeUnit = 0;
+	GLuint m_textures2D[TEXTURE_UNITS] = {};
+	GLuint m_texturesCubeMap[TEXTURE_UNITS] = {};
+
+	int m_capabilities[CAPABILITY_COUNT] = { -1, -1, -1 };
+
+	GLenum m_blendSource = GL_ONE;
+	GLenum m_blendDestination = GL_ZERO;
+	bool m_depthWrite = true;
+
+	int m_issuedCount = 0;
+	int m_filteredCount = 0;
+
+	//	Count a call, return true if it must reach GL
+	bool changed(bool isDifferent);
+
+	//	Make a unit active, returns the texture slot of target, nullptr if it isn't cached
+	GLuint* textureSlot(GLenum target, GLuint unit);
+};
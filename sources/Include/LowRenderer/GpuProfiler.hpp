@@ -0,0 +1,173 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include <Utils/Singleton.h>
+
+//	GPU time of named scopes, measured with GL_TIMESTAMP queries.
+//	Each frame writes its own set of queries, a set is read when the ring of
+//	FRAMES comes back to it : the GPU finished it long ago, reading never stalls.
+//	Scopes are opened on the thread holding the GL context, between beginFrame and endFrame.
+class GpuProfiler : public Singleton<GpuProfiler>
+{
+public:
+	//	Frames in flight before their queries are read
+	static constexpr int FRAMES = 3;
+
+	//	Frames averaged, graphed and kept for the trace
+	static constexpr int HISTORY = 120;
+
+	//	Scopes of a frame kept for the trace, the ones after are only averaged
+	static constexpr int FRAME_SCOPES = 128;
+
+	//	Destructor
+	//	----------
+
+	~GpuProfiler();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Read the oldest frame in flight and open the scope of the new one
+	//	Parameters : None
+	//	-----------------
+	void beginFrame();
+
+	//	Close the frame scope, its queries are read FRAMES frames later
+	//	Parameters : None
+	//	-----------------
+	void endFrame();
+
+	//	Write a timestamp before the next GPU commands, returns the scope to close
+	//	Parameters : const std::string& name
+	//	------------------------------------
+	int beginScope(const std::string& name);
+
+	//	Write a timestamp after the GPU commands of the scope
+	//	Parameters : int scope
+	//	----------------------
+	void endScope(int scope);
+
+	//	GPU time of a scope averaged over HISTORY frames, scopes opened twice a frame are summed
+	//	Parameters : const std::string& name
+	//	------------------------------------
+	float getAverageMs(const std::string& name);
+
+	//	GPU time of a scope in the last read frame, 0 before it's read
+	//	Parameters : const std::string& name
+	//	------------------------------------
+	float getLastMs(const std::string& name);
+
+	//	Write the scopes of the kept frames as Chrome trace events, in the steady_clock time of the CPU
+	//	Parameters : std::ostream& out, bool& first (no comma before the first event of the list)
+	//	-----------------------------------------------------------------------------------------
+	void writeTraceEvents(std::ostream& out, bool& first);
+
+	//	Show the GPU frame graph, the timeline of the last read frame and the scope averages
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+private:
+
+	//	Scope written by a frame in flight
+	struct ScopeRecord
+	{
+		int name = 0;
+		int depth = 0;
+		unsigned int query = 0;		//	Begin query, the end one follows
+	};
+
+	struct Frame
+	{
+		std::vector<GLuint> queries;
+		unsigned int usedQueries = 0;
+
+		std::vector<ScopeRecord> scopes;
+
+		//	Taken together when the frame began, they put the GPU timestamps on the CPU clock
+		GLint64 gpuReference = 0;
+		double cpuReference = 0.0;
+
+		bool pending = false;
+	};
+
+	//	Scope of a read frame, in microseconds of the CPU clock
+	struct TraceEvent
+	{
+		int name = 0;
+		int depth = 0;
+		double startUs = 0.0;
+		double durationUs = 0.0;
+	};
+
+	//	Scopes of a read frame, in the ring of the HISTORY last ones
+	struct TraceFrame
+	{
+		TraceEvent events[FRAME_SCOPES];
+		int count = 0;
+	};
+
+	struct ScopeStats
+	{
+		float history[HISTORY] = {};
+		int next = 0;
+		int count = 0;
+
+		float sum = 0.f;
+		float frameMs = 0.f;
+	};
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	Frame m_frames[FRAMES];
+	int m_frameIndex = 0;
+
+	bool m_inFrame = false;
+	int m_frameScope = -1;
+	std::vector<int> m_openScopes;
+
+	//	Read by the ImGui of the main thread
+	std::mutex m_mutex;
+
+	std::vector<std::string> m_names;
+	std::unordered_map<std::string, int> m_nameIds;
+	std::vector<ScopeStats> m_stats;
+
+	//	Same ring as the stats history, filled once per read frame without allocating
+	TraceFrame m_trace[HISTORY];
+	int m_traceNext = 0;
+	int m_traceCount = 0;
+
+	unsigned int m_droppedFrames = 0;
+	unsigned int m_droppedScopes = 0;
+
+	//	Read the queries of a frame, publish its times and trace events
+	void readFrame(Frame& frame);
+
+	//	Index of a scope name, added on its first use
+	int getNameId(const std::string& name);
+};
+
+//	Time the GPU commands issued during its lifetime
+//	GpuScope scope("Opaque");
+class GpuScope
+{
+public:
+	GpuScope(const std::string& name) : m_scope(GpuProfiler::instance()->beginScope(name)) {}
+	~GpuScope() { GpuProfiler::instance()->endScope(m_scope); }
+
+	GpuScope(const GpuScope&) = delete;
+	GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+	int m_scope;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <Core/MemoryTracker.hpp>
+
+//	Stream per frame data to the GPU without implicit synchronisation.
+//	The storage is persistently and coherently mapped once and split in segments,
+//	a segment is fenced when the writer leaves it and waited on before it's reused.
+//	Data written through a Range is visible to the commands issued after the write.
+class GpuRingBuffer
+{
+public:
+	//	Piece of the ring returned by allocate, offset is relative to the buffer start
+	struct Range
+	{
+		void*		data = nullptr;
+		GLintptr	offset = 0;
+		GLsizeiptr	size = 0;
+	};
+
+	//	Constructor & Destructor
+	//	------------------------
+
+	GpuRingBuffer(const std::string& name, GLenum target, GLsizeiptr segmentSize, Core::MemoryTag tag = Core::MemoryTag::RENDERER);
+	~GpuRingBuffer();
+
+	GpuRingBuffer(const GpuRingBuffer&) = delete;
+	GpuRingBuffer& operator=(const GpuRingBuffer&) = delete;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Check if an allocation stays in the current segment, when it doesn't the next
+	//	allocate() fences it: commands reading it must have been issued before
+	//	Parameters : GLsizeiptr size, GLsizeiptr alignment
+	//	--------------------------------------------------
+	bool fits(GLsizeiptr size, GLsizeiptr alignment = 1) const;
+
+	//	Reserve size bytes, waiting for the GPU if the next segment is still in use
+	//	Returns an empty Range if size doesn't fit in a segment
+	//	Parameters : GLsizeiptr size, GLsizeiptr alignment
+	//	--------------------------------------------------
+	Range allocate(GLsizeiptr size, GLsizeiptr alignment = 1);
+
+	//	Bind a range to an indexed target (uniform or shader storage buffers)
+	//	Parameters : GLuint index, const Range& range
+	//	---------------------------------------------
+	void bindRange(GLuint index, const Range& range) const;
+
+	GLuint getBuffer() const { return m_buffer; }
+	GLsizeiptr getAlignment() const { return m_minAlignment; }
+
+
+	//	Reset the frame counters of every ring
+	//	Parameters : None
+	//	-----------------
+	static void resetFrameStats();
+
+	//	Bytes written in every ring since resetFrameStats()
+	//	Parameters : None
+	//	-----------------
+	static long long getFrameBytes();
+
+	//	Show the counters of every ring
+	//	Parameters : None
+	//	-----------------
+	static void showImGui();
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	static constexpr int SEGMENT_COUNT = 3;
+
+	std::string m_name;
+
+	GLenum		m_target = GL_ARRAY_BUFFER;
+	GLuint		m_buffer = 0;
+	GLsizeiptr	m_segmentSize = 0;
+
+	//	Subsystem charged for the buffer
+	Core::MemoryTag m_tag = Core::MemoryTag::RENDERER;
+
+	//	Offset alignment required by the target (uniform and storage buffers)
+	GLsizeiptr	m_minAlignment = 1;
+
+	char*		m_mapped = nullptr;
+	GLsync		m_fences[SEGMENT_COUNT] = {};
+
+	//	Current segment, -1 until the first allocation, and next byte to write
+	int			m_segment = -1;
+	GLintptr	m_cursor = 0;
+
+	long long	m_frameBytes = 0;
+	int			m_frameStalls = 0;
+	int			m_totalStalls = 0;
+
+	//	Every living ring, for the counters
+	static std::vector<GpuRingBuffer*> s_rings;
+
+	//	Fence the current segment and wait until the GPU is done with the next one
+	void enterSegment(int segment);
+};
@@ -50,3 +50,4 @@ public:
 	void loadComponentFromSCNFile(std::istringstream& lineStream) override;
 };
 
+COMPONENT_ID(Light, ComponentType::Light);
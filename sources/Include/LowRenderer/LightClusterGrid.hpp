@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include <Maths/Vector3.h>
+
+//	Influence volume of a light, in view space (the camera looks down -z)
+struct ClusterSphere
+{
+	Maths::Vector3f center;
+	float radius = 0.f;
+};
+
+//	Range of the index list read by a cluster, mirrors uvec2 in the shaders
+struct ClusterRange
+{
+	unsigned int offset = 0;
+	unsigned int count = 0;
+};
+
+//	Split a perspective frustum in X * Y tiles and Z exponential depth slices,
+//	then list for each cluster the spheres touching it.
+//	CPU only, it can be driven without a GL context.
+class LightClusterGrid
+{
+public:
+	static constexpr unsigned int CLUSTER_X = 16;
+	static constexpr unsigned int CLUSTER_Y = 9;
+	static constexpr unsigned int CLUSTER_Z = 24;
+	static constexpr unsigned int CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Set the frustum to divide
+	//	Parameters : float fovY, float aspect, float zNear, float zFar
+	//	--------------------------------------------------------------
+	void setFrustum(float fovY, float aspect, float zNear, float zFar);
+
+	//	Fill the clusters, sphere i is listed as indexBase + i
+	//	Slices are spread over threads when there are enough spheres
+	//	Parameters : const std::vector<ClusterSphere>& spheres, unsigned int indexBase
+	//	------------------------------------------------------------------------------
+	void assign(const std::vector<ClusterSphere>& spheres, unsigned int indexBase = 0);
+
+	//	Cluster holding a view space point, -1 outside of the frustum
+	//	Parameters : const Vector3f& viewPosition
+	//	-----------------------------------------
+	int getClusterIndex(const Maths::Vector3f& viewPosition) const;
+
+	const std::vector<ClusterRange>& getClusters() const { return m_clusters; }
+	const std::vector<unsigned int>& getIndices() const { return m_indices; }
+
+	//	Depth slice = log(depth) * scale + bias, as the fragment shader computes it
+	float getSliceScale() const { return m_sliceScale; }
+	float getSliceBias() const { return m_sliceBias; }
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	float m_tanHalfFovX = 1.f;
+	float m_tanHalfFovY = 1.f;
+	float m_zNear = 0.1f;
+	float m_zFar = 1000.f;
+
+	float m_sliceScale = 0.f;
+	float m_sliceBias = 0.f;
+
+	std::vector<ClusterRange> m_clusters = std::vector<ClusterRange>(CLUSTER_COUNT);
+	std::vector<unsigned int> m_indices;
+
+	//	First and last slice of each sphere, filled before the threads start
+	std::vector<int> m_sphereSlices;
+
+	//	Count (fill == false) or write (fill == true) the indices of slices [first, last)
+	void assignSlices(const std::vector<ClusterSphere>& spheres, unsigned int indexBase, unsigned int first, unsigned int last, bool fill);
+
+	//	Depth of the near plane of a slice
+	float getSliceDepth(unsigned int slice) const;
+};
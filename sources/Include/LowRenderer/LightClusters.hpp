@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <LowRenderer/GpuRingBuffer.hpp>
+#include <LowRenderer/LightClusterGrid.hpp>
+
+class Light;
+class CameraBase;
+
+namespace Resources
+{
+	class Shader;
+}
+
+//	Light as read by the shaders (std430), the w slots carry the scalars
+struct GpuLight
+{
+	float position[3];		float power;
+	float ambient[3];		float cutOff;
+	float diffuse[3];		float outerCutOff;
+	float specular[3];		int	  lightType;
+	float attenuation[3];	float radius;
+	float direction[3];		float padding;
+};
+
+//	Clustered forward lighting : point lights are assigned to the clusters their
+//	attenuation reaches, a fragment only evaluates the lights of its cluster.
+//	Directional and spot lights aren't bounded, every fragment evaluates them.
+class LightClusters
+{
+public:
+	//	Constructor
+	//	-----------
+
+	LightClusters();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Copy the active lights as the shaders read them, on the main thread
+	//	Parameters : const std::unordered_map<int, const Light*>& lights, std::vector<GpuLight>& gpuLights
+	//	--------------------------------------------------------------------------------------------------
+	static void gather(const std::unordered_map<int, const Light*>& lights, std::vector<GpuLight>& gpuLights);
+
+	//	Assign the gathered lights to the clusters of the camera and stream them to the GPU
+	//	Unclustered, every light is global and keeps its gathering index (see LightSelector)
+	//	Parameters : const CameraBase& camera, const std::vector<GpuLight>& lights, bool clustered
+	//	------------------------------------------------------------------------------------------
+	void build(const CameraBase& camera, const std::vector<GpuLight>& lights, bool clustered = true);
+
+	//	Send the cluster grid parameters to a 3D shader, for a scene drawn at renderScale of the window
+	//	Parameters : const Shader& shader, float renderScale
+	//	----------------------------------------------------
+	void setUniforms(const Resources::Shader& shader, float renderScale = 1.f) const;
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+	//	Distance where a point light contribution drops under LIGHT_CUTOFF, -1 if it never does
+	//	Parameters : const Light& light
+	//	-------------------------------
+	static float getInfluenceRadius(const Light& light);
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	LightClusterGrid m_grid;
+	GpuRingBuffer m_ring;
+
+	//	Unbounded lights first, then the clustered ones
+	std::vector<GpuLight> m_gpuLights;
+	std::vector<GpuLight> m_pointLights;
+	std::vector<ClusterSphere> m_spheres;
+
+	unsigned int m_globalCount = 0;
+	bool m_clustered = false;
+
+	double m_assignMs = 0.0;
+	unsigned int m_droppedIndices = 0;
+
+	//	Stream lights, clusters and indices in a single range and bind them
+	void upload();
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include <Maths/Vector3.h>
+
+struct GpuLight;
+
+//	Pick the lights reaching an object the most, for forward shading with a fixed
+//	light budget per draw. Point lights are put in a uniform grid over their bounds,
+//	an object only scores the lights of the cells its sphere overlaps.
+//	Directional and spot lights aren't bounded, every object scores them.
+//	CPU only, it can be driven without a GL context.
+class LightSelector
+{
+public:
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Put the gathered lights in the grid, index i is lights[i]
+	//	Parameters : const std::vector<GpuLight>& lights
+	//	------------------------------------------------
+	void build(const std::vector<GpuLight>& lights);
+
+	//	Write the indices of the maxCount most influential lights on a sphere, most influential first
+	//	Parameters : const Vector3f& center, float radius, unsigned int* indices, unsigned int maxCount
+	//	-----------------------------------------------------------------------------------------------
+	unsigned int select(const Maths::Vector3f& center, float radius, unsigned int* indices, unsigned int maxCount);
+
+	//	Influence of light i on a sphere, 0 if it doesn't reach it
+	//	Parameters : unsigned int i, const Vector3f& center, float radius
+	//	-----------------------------------------------------------------
+	float getInfluence(unsigned int i, const Maths::Vector3f& center, float radius) const;
+
+	unsigned int getLightCount() const { return (unsigned int)m_lights.size(); }
+	float getCellSize() const { return m_cellSize; }
+
+	//	Lights scored per query since the last build
+	float getScoredPerQuery() const { return m_queries ? m_scored / (float)m_queries : 0.f; }
+
+private:
+
+	//	What the scoring reads of a GpuLight
+	struct SelectorLight
+	{
+		Maths::Vector3f position;
+		Maths::Vector3f direction;
+		Maths::Vector3f attenuation;
+		float intensity = 0.f;
+		float radius = -1.f;
+		float cutOff = 0.f;
+		float outerCutOff = 0.f;
+		int lightType = 0;
+	};
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	std::vector<SelectorLight> m_lights;
+
+	//	Scored by every query
+	std::vector<unsigned int> m_unbounded;
+
+	//	Lights of the hashed cells, bucket b is m_cellLights[m_buckets[b], m_buckets[b + 1])
+	std::vector<unsigned int> m_buckets;
+	std::vector<unsigned int> m_cellLights;
+
+	float m_cellSize = 1.f;
+
+	//	A light is scored once per query, when its stamp isn't the query one
+	std::vector<unsigned int> m_stamps;
+	unsigned int m_stamp = 0;
+
+	unsigned int m_queries = 0;
+	unsigned int m_scored = 0;
+
+	//	Score a light and keep it if it's in the maxCount best
+	void consider(unsigned int i, const Maths::Vector3f& center, float radius, unsigned int* indices, float* scores, unsigned int& count, unsigned int maxCount);
+
+	//	Bucket of a grid cell
+	static unsigned int getBucket(int x, int y, int z);
+};
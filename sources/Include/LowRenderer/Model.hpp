@@ -1,17 +1,26 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <Resources/Mesh.hpp>
 #include <Resources/Material.hpp>
 
 #include <Engine/Component.hpp>
 
+class OpaquePass;
+
 class Model : public Component
 {
 private: 
 	//	DEBUG
 	bool debugNormal = false;
+
+	//	Apply the instance values over the material
+	void updateMaterialInstance();
+
+	//	Shader features of the material instance
+	unsigned int getFeatureKey() const;
 public:
 	//	Constructors
 	//	------------
@@ -23,7 +32,15 @@ public:
 	//	Public Internal Functions
 	//	-------------------------
 
-	void draw();
+	//	Submit the model to the opaque pass, the variant is picked by the render thread
+	//	Parameters : OpaquePass& pass
+	//	-----------------------------
+	void gather(OpaquePass& pass);
+
+	//	Build the shader variant draw() will use
+	//	Parameters : None
+	//	-----------------
+	void prewarm();
 	void showImGUI() override;
 	void destroy() override;
 
@@ -50,3 +67,4 @@ public:
 
 };
 
+COMPONENT_ID(Model, ComponentType::Model);
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <Config.hpp>
+
+#include <Maths/Matrix.h>
+#include <Maths/Vector4.h>
+
+class CameraBase;
+class GpuRingBuffer;
+class LightSelector;
+
+namespace Resources
+{
+	class Mesh;
+	class Material;
+	class Shader;
+};
+
+//	Per draw datas of an opaque model, mirrors Object (DefaultVertexShader.vert)
+struct GpuObject
+{
+	float model[16];
+	float normalMatrix[16];		//	Inverse transpose of the model rotation and scale
+
+	GLuint material = 0;		//	Index in the material buffer of the batch
+
+	//	Indices in the light list, when the lights are picked per object
+	GLuint lightCount = 0;
+	GLuint lights[OBJECT_LIGHT_COUNT] = {};
+
+	GLuint padding[2] = {};
+};
+
+static_assert(sizeof(GpuObject) % 16 == 0, "GpuObject must match the std430 size of Object");
+
+//	Material values, mirrors Material (DefaultFragmentShader.frag)
+//	The maps are bound per batch, only their tiling (xy) and offset (zw) are here
+struct GpuMaterial
+{
+	Maths::Vector4f ambient;
+	Maths::Vector4f diffuse;
+	Maths::Vector4f specular;
+	Maths::Vector4f emissive;	//	w : shininess
+
+	Maths::Vector4f diffuseMap;
+	Maths::Vector4f normalMap;
+	Maths::Vector4f specularMap;
+	Maths::Vector4f emissiveMap;
+	Maths::Vector4f maskMap;
+
+	Maths::Vector4f normalMultiplier;
+};
+
+//	Model gathered for the opaque pass
+struct OpaqueItem
+{
+	const Resources::Mesh* mesh = nullptr;
+	Resources::Shader* shader = nullptr;
+	unsigned int featureKey = 0;
+
+	//	Textures of the material, in the order of their units
+	GLuint maps[5] = {};
+
+	GpuObject object;
+	GpuMaterial material;
+
+	//	Set when the pass is drawn
+	Resources::Shader* variant = nullptr;
+};
+
+//	Gather the models of the frame, drop the ones out of the camera frustum and
+//	draw the others with one glMultiDrawElementsIndirect per batch : models sharing
+//	a shader variant, their maps and a page of the mesh arena. Transforms and material
+//	values are streamed in shader storage buffers indexed by the draw index.
+//	Each FramePacket has its own pass, gathered by the main thread and culled on the job system.
+class OpaquePass
+{
+public:
+	//	Constructor & Destructor
+	//	------------------------
+
+	OpaquePass() = default;
+	~OpaquePass() = default;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Clear the previous frame items and set the frustum models are culled against
+	//	With a light selector, each model gets its OBJECT_LIGHT_COUNT most influential lights
+	//	Parameters : const CameraBase& camera, LightSelector* lightSelector
+	//	-------------------------------------------------------------------
+	void begin(const CameraBase& camera, LightSelector* lightSelector = nullptr);
+
+	//	Clear the previous frame items, nothing is culled
+	//	Parameters : None
+	//	-----------------
+	void begin();
+
+	//	Add a model to the pass, culled by end
+	//	Parameters : const Mesh* mesh, Shader* shader, unsigned int featureKey, const Material& material, const Mat4x4& model
+	//	---------------------------------------------------------------------------------------------------------------------
+	void submit(const Resources::Mesh* mesh, Resources::Shader* shader, unsigned int featureKey, const Resources::Material& material, const Maths::Mat4x4& model);
+
+	//	Drop the models out of the frustum and build the normal matrices of the others on every thread,
+	//	then pick the lights of the models left
+	//	Parameters : None
+	//	-----------------
+	void end();
+
+	//	Sort the models by batch, write their datas and commands in the rings and draw them, on the render thread
+	//	Parameters : GpuRingBuffer& storageRing, GpuRingBuffer& commandRing
+	//	-------------------------------------------------------------------
+	void draw(GpuRingBuffer& storageRing, GpuRingBuffer& commandRing);
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui() const;
+
+	int getItemCount() const { return (int)m_items.size(); }
+	int getCulledCount() const { return m_culled; }
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	//	Left, right, bottom, top, near, far : inside when dot(xyz, p) + w >= 0
+	Maths::Vector4f m_planes[6];
+	bool m_cull = false;
+
+	//	Built from the lights of the packet, used while gathering
+	LightSelector* m_lightSelector = nullptr;
+
+	std::vector<OpaqueItem> m_items;
+	std::vector<unsigned int> m_order;
+
+	//	Bounding sphere of each item (w : radius), negative radius when culled
+	std::vector<Maths::Vector4f> m_bounds;
+
+	int m_culled = 0;
+	int m_selectedLights = 0;
+	int m_batches = 0;
+	int m_materials = 0;
+
+	//	Write the datas and commands of m_order[first, last) and draw them
+	void drawBatch(size_t first, size_t last, GpuRingBuffer& storageRing, GpuRingBuffer& commandRing);
+};
@@ -12,6 +12,7 @@ namespace Resources
 };
 
 class GameObject;
+class TranslucentPass;
 
 enum class ParticleSystemPresets
 {
@@ -33,7 +34,13 @@ public:
 	//	Public Members
 	//	-------------------------
 
-	void draw();
+	void gatherTranslucent(TranslucentPass& pass) const;
+
+	int getParticleCount() const { return (int)particles.size(); }
+
+	//	Build the shader variant of the material
+	void prewarm();
+
 	void update()    override;
 	void showImGUI() override;
 	void destroy() override;
@@ -61,8 +68,6 @@ protected:
 	Resources::Shader*   m_shader   = nullptr;
 	Resources::Material* m_material = nullptr;
 
-	unsigned int VAO;
-
 	std::string m_shaderName;
 	std::string m_materialName;
 	std::string m_materialPath;
@@ -95,10 +100,11 @@ protected:
 
 	int  m_maxParticles = 10;
 	bool m_playOnBirth = true;
-	bool m_useLights = true;
+	bool m_collide = true; // bounce on the static colliders
 
-	void initGL();
 	void destroyParticle(int i);
 
 	Timer timer;
-};
\ No newline at end of file
+};
+
+COMPONENT_ID(ParticleSystem, ComponentType::ParticleSystem);
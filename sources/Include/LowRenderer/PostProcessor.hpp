@@ -9,6 +9,11 @@
 //#include <Sprite.h"
 #include <Resources/Shader.hpp>
 
+#include <LowRenderer/RenderGraph.hpp>
+
+//  Levels of the bloom chain, the first one is half the screen size
+#define BLOOM_LEVELS 5
+
 class PostProcessor
 {
 public:
@@ -17,10 +22,8 @@ public:
     //  -------------------------
 
     Resources::Shader* m_shader;
-    Resources::Shader* m_gaussianShader;
-
-    GLuint m_texture[2];
-    GLuint m_pingPongTexture[2];
+    Resources::Shader* m_downsampleShader;
+    Resources::Shader* m_upsampleShader;
 
     //  Constructor
     //  -----------
@@ -30,37 +33,34 @@ public:
     //  Public Internal Variables
     //  -------------------------
 
-    //  Prepares the postprocessor's framebuffer operations before rendering the game
-    void beginRender();
-
-    //  Should be called after rendering the game, so it stores all the rendered data into a texture object
-    void endRender();
+    //  Add the bloom chain and the composite of the scene into output
+    //  The bloom passes are culled by the graph when bloom is off
+    //  A scene drawn under the window size (renderScale < 1) is sharpened as it's upscaled
+    void addPasses(RenderGraph& graph, RenderGraph::Resource sceneColor, RenderGraph::Resource brightColor, RenderGraph::Resource output, float renderScale = 1.f);
 
-    //  Renders the PostProcessor texture quad (as a screen-encompassing large sprite)
-    void render();
+    //  Settings the passes are built with, the graph holding them is rebuilt when it changes
+    int getPassesKey() const { return m_bloomLevels * 2 + (m_bloom ? 1 : 0); }
 
     //  Show ImGui window parameters
     void showImGui();
 
 private:
 
-    GLuint FBO; // FrameBufferObject
-    GLuint RBO; // RenderBufferObject
     GLuint VAO; // VertexArrayObject
 
-    GLuint pingpongFBO[2];
-
     float m_exposure = .80f;
     float m_gamma = .90f;
-    int m_bloomAmount = 10;
+    float m_bloomIntensity = .25f;
+    float m_sharpness = .50f;
+    int m_bloomLevels = BLOOM_LEVELS;
+
+    bool m_bloom = true;
 
-    bool m_bloom = false;
+    //  Scale the passes were added with, read by the composite
+    float m_renderScale = 1.f;
 
     //  Initialize quad for rendering postprocessing texture
     void initRenderData();
-
-    //  Reshape the texture size if screen size is modified
-    void reshape();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <Utils/Singleton.h>
+
+#include <LowRenderer/GpuRingBuffer.hpp>
+
+#include <Maths/Matrix.h>
+#include <Maths/Vector4.h>
+
+namespace Resources
+{
+	class Shader;
+}
+
+//	Vertex layout shared by every batched quad
+struct QuadVertex
+{
+	float position[3];
+	float texCoords[2];
+	float color[4];
+};
+
+//	Quad recorded at extraction, submitted later by the render thread
+struct QuadItem
+{
+	Resources::Shader* shader = nullptr;
+	GLuint texture = 0;
+
+	Maths::Mat4x4 model = Maths::mat4x4Identity();
+	Maths::Vector2f halfSize;
+	Maths::Vector4f uvRect;
+	Maths::Vector4f color;
+};
+
+//	Collect the quads of Sprites, SpriteBillboards and particles and draw the
+//	consecutive ones sharing a shader and a texture with a single draw call.
+//	Vertices are streamed in a GpuRingBuffer, a run is drawn before it leaves its segment.
+class QuadBatcher : public Singleton<QuadBatcher>
+{
+public:
+	//	Constructor & Destructor
+	//	------------------------
+
+	QuadBatcher();
+	~QuadBatcher();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Add a quad, corners are given counter clockwise from the bottom left one
+	//	Quads are drawn in submission order, a change of shader or texture starts a new draw
+	//	Parameters : Shader* shader, GLuint texture, const Vector3f corners[4], const Vector4f& uvRect (u0, v0, u1, v1), const Vector4f& color
+	//	---------------------------------------------------------------------------------------------------------------------------------------
+	void submit(Resources::Shader* shader, GLuint texture, const Maths::Vector3f corners[4], const Maths::Vector4f& uvRect, const Maths::Vector4f& color);
+
+	//	Add a quad of halfSize around the model origin, in the model XY plane
+	//	Parameters : Shader* shader, GLuint texture, const Mat4x4& model, const Vector2f& halfSize, const Vector4f& uvRect, const Vector4f& color
+	//	------------------------------------------------------------------------------------------------------------------------------------------
+	void submit(Resources::Shader* shader, GLuint texture, const Maths::Mat4x4& model, const Maths::Vector2f& halfSize, const Maths::Vector4f& uvRect, const Maths::Vector4f& color);
+
+	//	Add a recorded quad
+	//	Parameters : const QuadItem& item
+	//	---------------------------------
+	void submit(const QuadItem& item) { submit(item.shader, item.texture, item.model, item.halfSize, item.uvRect, item.color); }
+
+	//	Draw the pending quads
+	//	Parameters : None
+	//	-----------------
+	void flush();
+
+	//	Reset the frame counters
+	//	Parameters : None
+	//	-----------------
+	void resetStats();
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	static constexpr int QUADS_PER_SEGMENT = 4096;
+
+	GpuRingBuffer m_ring;
+
+	GLuint VAO = 0;
+	GLuint EBO = 0;
+
+	//	First vertex and vertex count of the pending run
+	int m_runStart = 0;
+	int m_runCount = 0;
+
+	Resources::Shader* m_runShader = nullptr;
+	GLuint m_runTexture = 0;
+
+	int m_quadCount = 0;
+	int m_drawCount = 0;
+};
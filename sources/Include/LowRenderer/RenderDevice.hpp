@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+
+//	Backend the GL functions are loaded from.
+//	Every GL call of the engine goes through the glad function table, load() fills it.
+//	The GL device loads the driver of the current context, the null device loads
+//	functions that only count the objects and draws, no context nor GPU needed.
+class RenderDevice
+{
+public:
+	//	Objects and submissions seen by a tracking device
+	struct Stats
+	{
+		//	Live objects
+		int buffers = 0;
+		int textures = 0;
+		int vertexArrays = 0;
+		int framebuffers = 0;
+		int shaders = 0;
+		int programs = 0;
+		int queries = 0;
+
+		//	Since the last resetFrameStats()
+		int drawCalls = 0;
+		long long vertices = 0;
+		size_t uploadBytes = 0;
+	};
+
+	//	Destructor
+	//	----------
+
+	virtual ~RenderDevice() = default;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Fill the glad function table, false if the backend couldn't be loaded
+	//	Parameters : None
+	//	-----------------
+	virtual bool load() = 0;
+
+	virtual const char* getName() const = 0;
+
+	//	Only the devices counting their calls fill the stats
+	virtual bool isTracking() const { return false; }
+
+	const Stats& getStats() const { return m_stats; }
+
+	//	Reset the draw and upload counters
+	//	Parameters : None
+	//	-----------------
+	void resetFrameStats();
+
+	//	Replace the active device, headless uses the null one
+	//	Parameters : bool headless
+	//	--------------------------
+	static RenderDevice* create(bool headless);
+
+	static RenderDevice* instance() { return s_device; }
+	static void kill();
+
+protected:
+
+	//	Protected Internal Variables
+	//	----------------------------
+
+	Stats m_stats;
+
+private:
+
+	static RenderDevice* s_device;
+};
+
+//	Driver of the GLFW context
+class GLRenderDevice : public RenderDevice
+{
+public:
+	bool load() override;
+	const char* getName() const override { return "OpenGL"; }
+};
+
+//	GL functions doing no rendering : objects get names, queries answer as a
+//	complete 4.5 driver would and persistent mappings point to CPU memory
+class NullRenderDevice : public RenderDevice
+{
+public:
+	~NullRenderDevice();
+
+	bool load() override;
+	const char* getName() const override { return "Null"; }
+	bool isTracking() const override { return true; }
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include <glad/glad.h>
+
+#include <Utils/Singleton.h>
+
+//	Render targets shared by every scene.
+//	A texture is handed out again to any pass asking for the same size and format
+//	once its last reader is done, and deleted when no frame used it for a while.
+class RenderTargetPool : public Singleton<RenderTargetPool>
+{
+public:
+	//	Destructor
+	//	----------
+
+	~RenderTargetPool();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Start a frame, drop the textures unused for EVICT_FRAMES (old window size, disabled passes)
+	//	Parameters : None
+	//	-----------------
+	void beginFrame();
+
+	//	Get a free texture of this size and format, allocate it if there is none
+	//	Parameters : int width, int height, GLenum format
+	//	-------------------------------------------------
+	GLuint acquire(int width, int height, GLenum format);
+
+	//	Give a texture back, it can be acquired by the next passes
+	//	Parameters : GLuint texture
+	//	---------------------------
+	void release(GLuint texture);
+
+	//	Framebuffer with these attachments, 0 in colors leaves the draw buffer to GL_NONE
+	//	Parameters : const std::vector<GLuint>& colors, GLuint depth
+	//	------------------------------------------------------------
+	GLuint getFramebuffer(const std::vector<GLuint>& colors, GLuint depth);
+
+	size_t getAllocatedBytes() const { return m_allocatedBytes; }
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+	//	Depth formats are attached as depth, the others as color
+	static bool isDepthFormat(GLenum format);
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	static constexpr int EVICT_FRAMES = 3;
+
+	struct PooledTexture
+	{
+		GLuint texture = 0;
+		int width = 0;
+		int height = 0;
+		GLenum format = 0;
+		bool inUse = false;
+		int lastFrame = 0;
+	};
+
+	std::vector<PooledTexture> m_textures;
+
+	//	Attachments (colors then depth) -> framebuffer
+	std::map<std::vector<GLuint>, GLuint> m_framebuffers;
+
+	//	Key of the last lookup, kept so a lookup doesn't allocate
+	std::vector<GLuint> m_key;
+
+	int m_frame = 0;
+	size_t m_allocatedBytes = 0;
+	size_t m_peakBytes = 0;
+
+	//	Delete a texture and the framebuffers it's attached to
+	void destroy(const PooledTexture& pooled);
+};
+
+//	Frame described as passes declaring the targets they read and write.
+//	compile() orders the passes, culls the ones nothing visible depends on and
+//	computes when each target is first and last used, execute() binds each pass
+//	framebuffer and viewport, taking the targets from the RenderTargetPool only
+//	between their first and last use.
+class RenderGraph
+{
+public:
+	using Resource = int;
+
+	//	Default framebuffer, always at the window size
+	static constexpr Resource BACKBUFFER = 0;
+
+	//	Constructor
+	//	-----------
+
+	RenderGraph();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Forget the passes and targets of the last frame
+	//	Parameters : None
+	//	-----------------
+	void reset();
+
+	//	Declare a target of the window size times scale, divided by 2^downscale
+	//	Parameters : const std::string& name, GLenum format, int downscale, float scale
+	//	-------------------------------------------------------------------------------
+	Resource createTexture(const std::string& name, GLenum format, int downscale = 0, float scale = 1.f);
+
+	//	Declare a pass, a read sees the last write declared before the pass
+	//	Parameters : const std::string& name, const std::vector<Resource>& reads, const std::vector<Resource>& writes, std::function<void()> execute
+	//	--------------------------------------------------------------------------------------------------------------------------------------------
+	void addPass(const std::string& name, const std::vector<Resource>& reads, const std::vector<Resource>& writes, std::function<void()> execute);
+
+	//	Order and cull the passes, then compute the lifetime of the targets
+	//	Parameters : None
+	//	-----------------
+	void compile();
+
+	//	Run the passes that survived compile()
+	//	Parameters : None
+	//	-----------------
+	void execute();
+
+	//	Texture of a target, only valid while the passes using it run
+	//	Parameters : Resource resource
+	//	------------------------------
+	GLuint getTexture(Resource resource) const;
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+	//	Side of a target declared with this scale and downscale, for a window side of windowSize
+	static int getTargetSize(int windowSize, float scale, int downscale = 0);
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	struct ResourceNode
+	{
+		std::string name;
+		GLenum format = 0;
+		int downscale = 0;
+		float scale = 1.f;
+
+		int width = 0;
+		int height = 0;
+		GLuint texture = 0;
+
+		//	In execution order, -1 if no live pass uses it
+		int firstUse = -1;
+		int lastUse = -1;
+		bool read = false;
+	};
+
+	struct PassNode
+	{
+		std::string name;
+		std::vector<Resource> reads;
+		std::vector<Resource> writes;
+		std::function<void()> execute;
+
+		std::vector<int> dependencies;
+		bool live = false;
+	};
+
+	std::vector<ResourceNode> m_resources;
+	std::vector<PassNode> m_passes;
+
+	//	Index of the live passes, in execution order
+	std::vector<int> m_order;
+
+	//	Color attachments of the pass being bound, kept so binding doesn't allocate
+	std::vector<GLuint> m_colors;
+
+	//	Add the pass dependencies (read after write, write after read or write)
+	void buildDependencies();
+
+	//	Bind the framebuffer and viewport of a pass
+	void bindTargets(const PassNode& pass);
+};
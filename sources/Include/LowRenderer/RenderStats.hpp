@@ -0,0 +1,101 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include <Utils/Singleton.h>
+
+//	What a frame asked of the renderer
+struct FrameStats
+{
+	//	Counted by the render thread while it draws the frame
+	int drawCalls = 0;
+	int instances = 0;
+	long long triangles = 0;
+
+	int shaderBinds = 0;
+	int textureBinds = 0;
+	int uniformUploads = 0;
+	long long streamedBytes = 0;
+
+	//	Counted by the main thread when the frame is extracted
+	int visibleObjects = 0;
+	int culledObjects = 0;
+	int particlesSimulated = 0;
+	int particlesDrawn = 0;
+	int glyphs = 0;
+};
+
+//	Per frame counters of the renderer : an overlay of the last frames, and a CSV
+//	capture of a fixed number of frames to compare two versions of a scene.
+class RenderStats : public Singleton<RenderStats>
+{
+public:
+	//	Frames averaged by the overlay
+	static constexpr int HISTORY = 120;
+
+	//	Destructor
+	//	----------
+
+	~RenderStats();
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Reset the render thread counters, before the frame is drawn
+	//	Parameters : None
+	//	-----------------
+	void beginFrame();
+
+	//	Add the counters of the extraction to the drawn frame and publish it
+	//	Parameters : const FrameStats& extracted
+	//	----------------------------------------
+	void endFrame(const FrameStats& extracted);
+
+	void addDraw(int instances, long long triangles) { m_frame.drawCalls++; m_frame.instances += instances; m_frame.triangles += triangles; }
+	void addShaderBind() { m_frame.shaderBinds++; }
+	void addTextureBind() { m_frame.textureBinds++; }
+	void addUniformUpload() { m_frame.uniformUploads++; }
+
+	//	Write the counters of the next frameCount frames in a CSV file
+	//	Parameters : int frameCount, const std::string& path
+	//	----------------------------------------------------
+	void startCapture(int frameCount, const std::string& path);
+
+	//	Show the counters of the last frame and their average
+	//	Parameters : None
+	//	-----------------
+	void showImGui();
+
+	//	Corner window with the counters, when enabled
+	//	Parameters : None
+	//	-----------------
+	void showOverlay();
+
+	bool m_overlay = false;
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	FrameStats m_frame;
+
+	//	Read by the ImGui of the main thread
+	std::mutex m_mutex;
+	FrameStats m_history[HISTORY];
+	int m_next = 0;
+	int m_count = 0;
+
+	std::vector<FrameStats> m_capture;
+	int m_captureFrames = 0;
+	std::string m_capturePath;
+
+	//	Write the captured frames and stop the capture
+	void writeCapture();
+
+	//	Counters of the last frame and their average
+	void showCounters();
+};
@@ -6,22 +6,32 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <vector>
+
 namespace Resources
 {
     class Shader;
+    struct AtlasRegion;
 }
 
+struct QuadItem;
+
 class Sprite : public Component
 {
 public:
     Sprite(GameObject* in_gameObject);
     Sprite(const char* path, const char* name);
     void draw();
+
+    //  Record the quad draw() would submit, for the render thread
+    void gatherHUD(std::vector<QuadItem>& items);
     void showImGUI() override;
     void destroy() override;
     void saveComponentInSCNFile(std::ofstream& file) override;
     void loadComponentFromSCNFile(std::istringstream& lineStream) override;
-    void updateRenderData();
+
+    //  Use the texture, or its UI atlas region if it was packed
+    void setTexture(const std::string& path, const std::string& name);
 
     //  Public Variables
     //  ----------------
@@ -30,15 +40,19 @@ public:
 
 private:
 
+    //  Quad of the sprite, false if it has nothing to draw
+    bool getQuad(QuadItem& item) const;
+
     //  Private Variables
     //  -----------------
 
-    Resources::Shader* m_shader;
-    Resources::Texture* m_texture;
+    Resources::Shader* m_shader = nullptr;
+    Resources::Texture* m_texture = nullptr;
+    const Resources::AtlasRegion* m_atlasRegion = nullptr;
 
-    Maths::Vector3f m_default_color;
+    std::string m_texturePath;
 
-    unsigned int VAO;
+    Maths::Vector3f m_default_color;
+};
 
-    void initRenderData();
-};
\ No newline at end of file
+COMPONENT_ID(Sprite, ComponentType::Sprite);
@@ -8,28 +8,28 @@ namespace Resources
 	class Shader;
 }
 
+class TranslucentPass;
+
 class SpriteBillboard : public Component
 {
 public:
 	SpriteBillboard() = default;
 	SpriteBillboard(GameObject* in_gameObject);
 
-	void draw();
+	void gatherTranslucent(TranslucentPass& pass) const;
 	void showImGUI() override;
 	void destroy() override;
 	void saveComponentInSCNFile(std::ofstream& file) override;
 	void loadComponentFromSCNFile(std::istringstream& lineStream) override;
 
 private:
-	Resources::Material* m_material;
-	Resources::Shader*  m_shader;
+	Resources::Material* m_material = nullptr;
+	Resources::Shader*  m_shader = nullptr;
 
 	std::string m_materialName;
 	std::string m_materialPath;
 
-	unsigned int VAO;
-
 	Maths::Vector4f m_color = { 1.f, 1.f, 1.f, 1.f };
+};
 
-	void initRenderData();
-};
\ No newline at end of file
+COMPONENT_ID(SpriteBillboard, ComponentType::SpriteBillboard);
@@ -3,6 +3,7 @@
 #include "Resources/Shader.hpp"
 #include "Maths/Vector3.h"
 #include "Utils/Singleton.h"
+#include "LowRenderer/GpuRingBuffer.hpp"
 #include <vector>
 
 
@@ -10,25 +11,29 @@
 
 class TextRender : public Singleton<TextRender>
 {
-private :
+public :
 
-	//	Private structure
-	//	-----------------
+	//	Public structure
+	//	----------------
 
+	//	Strings in the frame arena of the thread which added the text, valid while the packet is drawn
 	struct TextParameter
 	{
-		std::string font;
-		std::string text;
+		const char* font;
+		const char* text;
 		Maths::Vector2f pos;
 		float size;
 		Maths::Vector3f color;
 	};
 
+private :
+
 	//	Private Variables
 	//	-----------------
 
 	Resources::Shader* m_shader;
-	unsigned int VAO, VBO;
+	unsigned int VAO;
+	GpuRingBuffer m_ring;
 	std::vector<TextParameter> m_textBuffer;
 
 	//	Private functions
@@ -45,7 +50,12 @@ public:
 
 	//	Public Functions
 	//	----------------
-	void AddText(const std::string& font, const std::string& text, const Maths::Vector2f& pos, float scale, const Maths::Vector3f& color);
+	//	font and text are copied, a temporary string can be given
+	void AddText(const char* font, const char* text, const Maths::Vector2f& pos, float scale, const Maths::Vector3f& color);
 	void RenderTextBuffer();
+
+	//	Move the texts added this frame to texts, the render thread draws them with RenderTexts()
+	void TakeTextBuffer(std::vector<TextParameter>& texts);
+	void RenderTexts(const std::vector<TextParameter>& texts);
 };
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include <Maths/Matrix.h>
+#include <Maths/Vector4.h>
+
+#include <Utils/RadixSort.hpp>
+
+namespace Resources
+{
+	class Material;
+	class Shader;
+};
+
+//	Blended quad gathered for the translucent pass
+struct TranslucentItem
+{
+	Resources::Shader* shader = nullptr;
+	unsigned int featureKey = 0;
+	unsigned int texture = 0;
+
+	Maths::Mat4x4 model = Maths::mat4x4Identity();
+	Maths::Vector4f color;
+};
+
+//	Gather every particle and billboard of the frame, sort them back to front
+//	and send them to the quad batcher, which merges the ones sharing a texture.
+//	Each FramePacket has its own pass, gathered by the main thread.
+class TranslucentPass
+{
+public:
+	//	Constructor & Destructor
+	//	------------------------
+
+	TranslucentPass() = default;
+	~TranslucentPass() = default;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Clear the previous frame items and set the view used to compute depth
+	//	Parameters : const Mat4x4& view
+	//	-------------------------------
+	void begin(const Maths::Mat4x4& view);
+
+	//	Add a quad to the pass, textured with the material diffuse map
+	//	The shader variant of featureKey is picked when the pass is drawn
+	//	Parameters : Shader* shader, unsigned int featureKey, const Material* material, const Mat4x4& model, const Vector4f& color
+	//	--------------------------------------------------------------------------------------------------------------------------
+	void submit(Resources::Shader* shader, unsigned int featureKey, const Resources::Material* material, const Maths::Mat4x4& model, const Maths::Vector4f& color);
+
+	//	Sort the gathered quads and draw them, on the render thread
+	//	Parameters : None
+	//	-----------------
+	void draw();
+
+	//	Show ImGui
+	//	Parameters : None
+	//	-----------------
+	void showImGui() const;
+
+	int getItemCount() const { return (int)m_items.size(); }
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	Maths::Mat4x4 m_view = Maths::mat4x4Identity();
+
+	std::vector<TranslucentItem> m_items;
+	std::vector<float> m_keys;
+
+	RadixSorter m_sorter;
+};
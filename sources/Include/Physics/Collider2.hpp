@@ -49,4 +49,7 @@ public:
 
 	void showImGUI() override;
 	void update() override {};
-};
\ No newline at end of file
+};
+
+COMPONENT_ID(Collider2, ComponentType::BoxCollider2D);
+COMPONENT_ID(BoxCollider2D, ComponentType::BoxCollider2D);
@@ -36,6 +36,9 @@ namespace Physics
 		int m_physicsLayer = 0;
 		PhysicsMaterial m_physicsMat;
 
+		//	In the distance field of the PhysicsManager, removing it needs a new bake
+		bool m_baked = false;
+
 		//	Functions
 		//	---------
 
@@ -85,3 +88,7 @@ namespace Physics
 		void showImGUI() override;
 	};
 }
+
+COMPONENT_ID(Physics::Collider3, ComponentType::SphereCollider3D, ComponentType::BoxCollider3D);
+COMPONENT_ID(Physics::SphereCollider3D, ComponentType::SphereCollider3D);
+COMPONENT_ID(Physics::BoxCollider3D, ComponentType::BoxCollider3D);
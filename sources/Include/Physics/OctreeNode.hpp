@@ -3,6 +3,7 @@
 #include <vector>
 
 #include <Physics/Collider3.hpp>
+#include <Core/FrameArena.hpp>
 
 namespace Physics
 {
@@ -22,6 +23,6 @@ namespace Physics
 
 		void scanColliders(std::vector<Collider3*>& colliders);
 
-		void getPotentialColliders(Collider3* target, std::vector<Collider3*>& potentialColliders);
+		void getPotentialColliders(Collider3* target, Core::FrameVector<Collider3*>& potentialColliders);
 	};
 }
\ No newline at end of file
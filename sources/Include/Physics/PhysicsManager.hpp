@@ -6,6 +6,7 @@
 #include <Physics/Collider3.hpp>
 #include <Physics/Rigidbody3.hpp>
 #include <Physics/OctreeNode.hpp>
+#include <Physics/SignedDistanceField.hpp>
 
 namespace Physics
 {
@@ -24,10 +25,18 @@ namespace Physics
 
 		std::vector<Rigidbody3*> m_rigidbodies;
 
+		// Baked from the static boxes once they are registered, used by particles
+		SignedDistanceField m_distanceField;
+		bool m_distanceFieldDirty = false;
+
 		bool m_collisionLayerMatrix[64] = { true };
 
 		void initialize();
 		void setUp();
+		void bakeDistanceField();
+
+		// Bake the distance field first if a static box was (un)registered
+		const SignedDistanceField* getDistanceField();
 
 		void registerCollider(Collider3* collider);
 		void unregisterCollider(Collider3* collider);
@@ -62,4 +62,4 @@ namespace Physics
 	};
 }
 
-
+COMPONENT_ID(Physics::Rigidbody3, ComponentType::RigidBody);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+#include <Physics/Collider3.hpp>
+
+namespace Physics
+{
+	struct DistanceSample
+	{
+		float distance = 0.f;
+		Vector3f normal = { 0.f, 1.f, 0.f };
+		PhysicsMaterial material;
+	};
+
+	// Sparse signed distance grid baked from static boxes
+	// A dense grid of brick indices covers the boxes bounds, only the bricks
+	// crossed by a surface store their (BRICK_CELLS + 1)^3 distance samples.
+	// A lookup is one brick fetch and one trilinear interpolation, its cost
+	// does not depend on the number of baked boxes.
+	class SignedDistanceField
+	{
+	public:
+		static constexpr int BRICK_CELLS = 8;
+		static constexpr int BRICK_SAMPLES = BRICK_CELLS + 1;
+
+		SignedDistanceField() = default;
+
+		void clear();
+
+		// Boxes are gathered then baked at once
+		void addBox(const Box& box, const PhysicsMaterial& material);
+		void bake(float cellSize = 0.25f);
+
+		bool isBaked() const { return m_baked; }
+		size_t getBoxCount() const { return m_boxes.size(); }
+		size_t getBrickCount() const { return m_bricks.size(); }
+		size_t getMemorySize() const;
+
+		// Spacing of the samples, a lookup is off by about one cell at most
+		float getCellSize() const { return m_cellSize; }
+
+		// Return true if the point is near or inside a baked box and fill the sample
+		bool sample(const Vector3f& point, DistanceSample& out) const;
+
+	private:
+		enum BrickState : int
+		{
+			BRICK_EMPTY = -1,
+			BRICK_SOLID = -2
+		};
+
+		struct OrientedBox
+		{
+			Vector3f center;
+			Vector3f axis[3];
+			Vector3f extension;
+		};
+
+		struct Brick
+		{
+			// Quantized in [-brickSize, brickSize]
+			short distances[BRICK_SAMPLES * BRICK_SAMPLES * BRICK_SAMPLES];
+			unsigned short materials[BRICK_SAMPLES * BRICK_SAMPLES * BRICK_SAMPLES];
+		};
+
+		std::vector<Box> m_boxes;
+		std::vector<PhysicsMaterial> m_materials;
+
+		std::vector<int> m_brickIndices;
+		std::vector<Brick> m_bricks;
+
+		Vector3f m_origin;
+		int m_dimensions[3] = { 0, 0, 0 };
+		float m_cellSize = 0.25f;
+		float m_brickSize = 2.f;
+
+		bool m_baked = false;
+
+		float boxDistance(const OrientedBox& box, const Vector3f& point) const;
+		bool bakeBrick(const int brick[3], const std::vector<OrientedBox>& boxes, const std::vector<int>& candidates, Brick& out) const;
+	};
+}
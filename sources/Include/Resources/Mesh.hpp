@@ -5,6 +5,8 @@
 
 #include <Maths/Vector3.h>
 
+#include <Resources/MeshArena.hpp>
+
 #include <Resources/Shader.hpp>
 #include <Resources/Texture.hpp>
 #include <Engine/Transform3.hpp>
@@ -13,13 +15,6 @@
 
 namespace Resources
 {
-	struct Vertex
-	{
-		Maths::Vector3f Position;
-		Maths::Vector3f Normals;
-		Maths::Vector2f TexCoords;
-	};
-
 	class Mesh
 	{
 	public:
@@ -28,16 +23,19 @@ namespace Resources
 		//	--------------------------
 
 		Mesh() = default;
-		Mesh(const std::vector<Vertex> & verticesIn);
-		~Mesh();
+		Mesh(const std::vector<Vertex>& verticesIn, const std::vector<unsigned int>& indicesIn);
+		~Mesh() = default;
 	
 		//	Public Internal Function
 		//	------------------------
 
-		//	Draw mesh with the shader
-		//	Parameters : const Shader* _shader
-		//	----------------------------------
-		void draw();
+		//	Where the mesh is in the arena of the ResourcesManager, page -1 if it's empty
+		const MeshArena::Allocation& getAllocation() const { return m_allocation; }
+
+		//	Bounding sphere in model space
+		const Maths::Vector3f& getBoundsCenter() const { return m_boundsCenter; }
+		float getBoundsRadius() const { return m_boundsRadius; }
+
 		std::string  getPath() const { return m_path; }
 		std::string& setPath() { return m_path; }
 
@@ -48,19 +46,9 @@ namespace Resources
 
 		std::string m_path;
 
-		//	Private Internal Variables
-		//	--------------------------
-
-		//	Vertice list
-		std::vector<Vertex> m_vertices;
-
-		GLuint VAO;
-		GLuint VBO;
-		//GLuint TangentBuffer, BiTangentBuffer;
+		MeshArena::Allocation m_allocation;
 
-		//	Configure mesh with OpenGL
-		//	Parameters : none
-		//	-----------------
-		void setupMesh();	
+		Maths::Vector3f m_boundsCenter;
+		float m_boundsRadius = 0.f;
 	};
 }
\ No newline at end of file
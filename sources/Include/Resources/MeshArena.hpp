@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <Maths/Vector3.h>
+#include <Maths/Vector2.h>
+
+namespace Resources
+{
+	struct Vertex
+	{
+		Maths::Vector3f Position;
+		Maths::Vector3f Normals;
+		Maths::Vector2f TexCoords;
+	};
+
+	//	Large vertex and index buffers every mesh is suballocated from.
+	//	The meshes of a page share one vertex array, so the opaque pass draws all
+	//	of them with a single glMultiDrawElementsIndirect. Pages are only appended
+	//	to, meshes live as long as the ResourcesManager.
+	class MeshArena
+	{
+	public:
+		//	Place of a mesh in the arena
+		struct Allocation
+		{
+			int		page = -1;
+			GLint	baseVertex = 0;
+			GLuint	firstIndex = 0;
+			GLsizei	indexCount = 0;
+		};
+
+		//	Constructor & Destructor
+		//	------------------------
+
+		MeshArena() = default;
+		~MeshArena();
+
+		MeshArena(const MeshArena&) = delete;
+		MeshArena& operator=(const MeshArena&) = delete;
+
+
+		//	Public Internal Functions
+		//	-------------------------
+
+		//	Upload a mesh in the first page with room, a new page is created if none has
+		//	Parameters : const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices
+		//	-----------------------------------------------------------------------------------------
+		Allocation add(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+		//	Bind the vertex array of a page
+		//	Attribute 3 is the draw index, one per instance : the baseInstance of a draw command
+		//	Parameters : int page
+		//	---------------------
+		void bind(int page) const;
+
+		int getPageCount() const { return (int)m_pages.size(); }
+
+		//	Show ImGui
+		//	Parameters : None
+		//	-----------------
+		void showImGui() const;
+
+	private:
+
+		//	Private Internal Variables
+		//	--------------------------
+
+		struct Page
+		{
+			GLuint VAO = 0;
+			GLuint VBO = 0;
+			GLuint IBO = 0;
+
+			GLsizei vertexCapacity = 0;
+			GLsizei indexCapacity = 0;
+			GLsizei vertexCount = 0;
+			GLsizei indexCount = 0;
+		};
+
+		std::vector<Page> m_pages;
+
+		//	0 to MAX_BATCH_DRAWS - 1, shared by the vertex arrays of every page
+		GLuint m_drawIndexBuffer = 0;
+
+		//	Create the buffers and the vertex array of a page
+		int createPage(GLsizei vertexCapacity, GLsizei indexCapacity);
+	};
+}
@@ -3,6 +3,11 @@
 #include <Engine/Transform3.hpp>
 #include <Utils/Timer.hpp>
 
+namespace Physics
+{
+	class SignedDistanceField;
+}
+
 struct ParticleSpecs
 {
 	float lifetime;
@@ -32,7 +37,10 @@ namespace Resources
 		//	Public Variables
 		//	---------------
 
-		void update();
+		//	Move the particle, and bounce it on the static colliders if a field is given
+		//	Parameters : const SignedDistanceField* field, const Mat4x4& parentMatrix
+		//	-----------------------------------------------------------------------------
+		void update(const Physics::SignedDistanceField* field, const Maths::Mat4x4& parentMatrix);
 
 		Maths::Vector3f velocity;
 		Transform3 transform;
@@ -45,6 +53,8 @@ namespace Resources
 
 	private:
 
+		void collide(const Physics::SignedDistanceField& field, const Maths::Mat4x4& parentMatrix, const Maths::Vector3f& previousPosition);
+
 		Maths::Vector4f color;
 		float speed = 0.f;
 		float gravity_multiplier = 0.f;
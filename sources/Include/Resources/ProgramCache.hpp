@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+namespace Resources
+{
+	//	Linked programs saved with glGetProgramBinary in PROGRAM_CACHE_DIR.
+	//	A program is stored under a hash of its sources and of the driver
+	//	vendor, renderer and version, so a driver update misses the cache.
+	namespace ProgramCache
+	{
+		//	Key of a program, needs a GL context
+		//	Parameters : const std::string& sources
+		//	---------------------------------------
+		std::string getKey(const std::string& sources);
+
+		//	Create the program from the cached binary, 0 if missing or refused by the driver
+		//	Parameters : const std::string& key
+		//	-----------------------------------
+		unsigned int load(const std::string& key);
+
+		//	Save the binary of a linked program, it must have been linked with
+		//	GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+		//	Parameters : const std::string& key, unsigned int program
+		//	---------------------------------------------------------
+		void save(const std::string& key, unsigned int program);
+
+		//	Count the time spent loading a program
+		//	Parameters : bool fromCache, double ms
+		//	--------------------------------------
+		void addLoadTime(bool fromCache, double ms);
+
+		//	Write the programs loaded from the cache or compiled since the last call
+		//	Parameters : None
+		//	-----------------
+		void logStats();
+	}
+}
@@ -6,6 +6,7 @@
 #include <LowRenderer/Model.hpp>
 #include <LowRenderer/Light.hpp>
 #include <LowRenderer/Camera.hpp>
+#include <Resources/TextureAtlas.hpp>
 
 
 namespace Resources
@@ -43,6 +44,8 @@ namespace Resources
 		//	-------------------------
 
 		stringList m_loaded_text;
+
+		bool m_atlasLoaded = false;
 		//std::map<char, Character> m_characters;
 
 		//	Parse a OBJ file
@@ -64,12 +67,16 @@ namespace Resources
 		//	Public Internal Variables
 		//	-------------------------
 
+		//	Vertices and indices of every mesh
+		MeshArena	m_meshArena;
+
 		std::map<std::string, stringList>			m_obj;
 		std::map<std::string, Resources::Mesh>		m_meshName_mesh;
 		std::map<std::string, Resources::Material>	m_materialName_material;
 		std::map<std::string, std::string>			m_meshName_materialName;
 		std::map<std::string, Resources::Shader>	m_shaderName_shader;
 		std::map<std::string, Texture>				m_textureName_texture;
+		std::map<std::string, AtlasRegion>			m_textureName_atlasRegion;
 
 		FontList	m_characterListPerFonts;
 		stringList	m_loaded_file;
@@ -107,6 +114,16 @@ namespace Resources
 		//	-----------------------------------------------------------
 		Resources::Texture* getCubeMapTexture(const std::string& path, const std::string& text_name);
 
+		//	Load the regions of a packed atlas
+		//	Parameters : const std::string& path
+		//	------------------------------------
+		bool loadAtlas(const std::string& path);
+
+		//	Get the UI atlas region of a texture, nullptr if it wasn't packed
+		//	Parameters : const std::string& text_name
+		//	-----------------------------------------
+		const AtlasRegion* getAtlasRegion(const std::string& text_name);
+
 		//	Set Texture
 		//	Parameters : const std::string& textName
 		//	----------------------------------------
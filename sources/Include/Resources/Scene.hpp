@@ -29,6 +29,9 @@ namespace Resources
 		Physics::PhysicsManager m_physicsManager;
 
 		std::unordered_map<int, GameObject*> m_objectList;
+
+		//	Components of each type in the scene, packed (forEachComponent)
+		std::vector<Component*> m_components[(int)ComponentType::COUNT];
 		
 		Sprite m_loader_sprite = Sprite("Assets/Loading.png", "Loading");
 		Transform3 m_loader_transform;
@@ -45,6 +48,44 @@ namespace Resources
 		//	Public Internal Functions
 		//	-------------------------
 		GameObject* findGameObjectInScene(std::string name);
+
+		//	Add a component of one of its gameObjects to the array of its type
+		//	Parameters : Component* component
+		//	---------------------------------
+		void addComponent(Component* component);
+
+		//	Remove a component from the array of its type, the last one takes its place
+		//	Parameters : Component* component
+		//	---------------------------------
+		void removeComponent(Component* component);
+
+		//	Call function on every component of the scene a C* can point to, type after type
+		//	The function must not add nor remove components
+		//	Parameters : F function (void(C*))
+		//	----------------------------------
+		template<typename C, typename F>
+		void forEachComponent(F function)
+		{
+			for (int type = 0; type < (int)ComponentType::COUNT; type++)
+			{
+				if ((ComponentId<C>::mask & (1u << type)) == 0) continue;
+
+				for (Component* component : m_components[type]) function(static_cast<C*>(component));
+			}
+		}
+
+		//	First component of the scene a C* can point to, nullptr if there is none
+		//	Parameters : None
+		//	-----------------
+		template<typename C>
+		C* getFirstComponent()
+		{
+			for (int type = 0; type < (int)ComponentType::COUNT; type++)
+			{
+				if ((ComponentId<C>::mask & (1u << type)) && !m_components[type].empty()) return static_cast<C*>(m_components[type][0]);
+			}
+			return nullptr;
+		}
 		
 
 		//	Update function
@@ -59,10 +100,10 @@ namespace Resources
 		void fixedUpdate();
 		void lateUpdate();
 
-		//	Draw function
-		//	Parameters : none
-		//	-----------------
-		void draw();
+		//	Extract the scene to draw in packet
+		//	Parameters : FramePacket& packet
+		//	--------------------------------
+		void draw(FramePacket& packet);
 		void drawLoading();
 		//	Save current scene in the typed path
 		//	Parameters : const char* path
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <sstream>
 
+#include <memory>
 #include <iostream>
 #include <unordered_map>
 
@@ -25,6 +26,19 @@ namespace Resources
         POST_PROCESS,
     };
 
+    //  Compile time features, listed after FEATURES in a .shad
+    //  Each one is a bit of the permutation key and a #define in the variant
+    enum ShaderFeature
+    {
+        DIFFUSE_MAP  = 1 << 0,
+        NORMAL_MAP   = 1 << 1,
+        SPECULAR_MAP = 1 << 2,
+        EMISSIVE_MAP = 1 << 3,
+        MASK_MAP     = 1 << 4,
+        SHOW_NORMAL  = 1 << 5,
+        OBJECT_LIGHTS = 1 << 6,
+    };
+
     class Shader
     {
     public:
@@ -40,58 +54,104 @@ namespace Resources
         unsigned int ID = 0;
         int m_type = 0;
 
+        std::string m_name;
+
+        //  Features the sources know about, the others are ignored by getVariant
+        unsigned int m_featureMask = 0;
+
         //  Public Internal Functions
         //  -------------------------
 
-        //  Use/Activate the shader
+        //  Use/Activate the shader, waits for the driver if it's still compiling it
         //  Parameters : none
         //  -----------------
         void use();
 
+        //  False while the driver compiles the program
+        //  Parameters : none
+        //  -----------------
+        bool isReady() const;
+
+        //  Names are taken as char*, a long name built a heap string on every upload
+
         //  Send a Boolean value to the shader
-        //  Parameteters : const string& name, const bool value
+        //  Parameteters : const char* name, const bool value
         //  --------------------------------------------------------
-        void setBool(const std::string& name, const bool value) const;
+        void setBool(const char* name, const bool value) const;
 
         //  Send a Integer value to the shader
-        //  Parameteters : const string& name, const int value
+        //  Parameteters : const char* name, const int value
         //  -------------------------------------------------------
-        void setInt(const std::string& name, const int value) const;
+        void setInt(const char* name, const int value) const;
 
         //  Send a Floating value to the shader
-        //  Parameteters : const string& name, const float value
+        //  Parameteters : const char* name, const float value
         //  ---------------------------------------------------------
-        void setFloat(const std::string& name, const float value) const;
+        void setFloat(const char* name, const float value) const;
 
         //  Send a Vector2 value to the shader
-        //  Parameteters : const string& name, const Vector2 value
+        //  Parameteters : const char* name, const Vector2 value
         //  ---------------------------------------------------------
-        void setFloat2(const std::string& name, const Maths::Vector2f& value) const;
+        void setFloat2(const char* name, const Maths::Vector2f& value) const;
 
         //  Send a Vector3 to the shader
-        //  Parameteters : const string& name, const Vector3 value
+        //  Parameteters : const char* name, const Vector3 value
         //  -----------------------------------------------------------
-        void setFloat3(const std::string& name, const Maths::Vector3f& value) const;
+        void setFloat3(const char* name, const Maths::Vector3f& value) const;
 
         //  Send a Vector4 to the shader
-        //  Parameteters : const string& name, const Vector4 value
+        //  Parameteters : const char* name, const Vector4 value
         //  -----------------------------------------------------------
-        void setFloat4(const std::string& name, const Maths::Vector4f& value) const;
+        void setFloat4(const char* name, const Maths::Vector4f& value) const;
 
         //  Send a Matrix 4x4 to the shader
-        //  Parameteters : const string& name, const Mat4 value
+        //  Parameteters : const char* name, const Mat4 value
         //  ---------------------------------------------------
-        void setMat4(const std::string& name, const Maths::Mat4x4& value) const;
+        void setMat4(const char* name, const Maths::Mat4x4& value) const;
 
-        //  Send Light list to the shader
-        //  Parameteters : const vector<Light>& list
-        //  ----------------------------------------
-        void setLights(const std::unordered_map<int, const Light*>& list) const;
+        //  Get the variant compiled with the features of the key, build it on first use
+        //  The shader itself is the variant without any feature, and the fallback until the variant is ready
+        //  Parameters : unsigned int featureKey
+        //  ------------------------------------
+        Shader* getVariant(unsigned int featureKey);
 
-        //  Send Material to the shader
-        //  Parameters : const Material* in_material
+        const std::unordered_map<unsigned int, std::unique_ptr<Shader>>& getVariants() const { return m_variants; }
+
+        //  Features a material needs
+        //  Parameters : const Material& in_material
         //  ----------------------------------------
-        void setMaterial(const Resources::Material& in_material) const;
+        static unsigned int getFeatureKey(const Resources::Material& in_material);
+
+        //  Feature of a .shad keyword, 0 if unknown
+        //  Parameters : const std::string& keyword
+        //  ---------------------------------------
+        static unsigned int getFeatureBit(const std::string& keyword);
+
+        static unsigned int getVariantCount() { return s_variantCount; }
+
+        //  Check the programs the driver finished compiling, or wait for all of them
+        //  Parameters : bool wait
+        //  ----------------------
+        static void resolvePending(bool wait);
+
+    private:
+
+        //  Private Internal Variables
+        //  --------------------------
+
+        std::string m_vertexCode;
+        std::string m_fragmentCode;
+        std::string m_geometryCode;
+
+        std::unordered_map<unsigned int, std::unique_ptr<Shader>> m_variants;
+
+        //  Variants built by every shader
+        static unsigned int s_variantCount;
+
+        //  Compile and link the sources with the defines of the features
+        //  Parameters : unsigned int featureKey
+        //  ------------------------------------
+        unsigned int compile(unsigned int featureKey) const;
     };
 
     void loadShader(std::string shaderName);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include <Maths/Vector4.h>
+
+namespace Resources
+{
+	class Texture;
+
+	//	Part of an atlas page used by a packed texture
+	struct AtlasRegion
+	{
+		Texture* page = nullptr;
+		Maths::Vector4f uvRect = { 0.f, 0.f, 1.f, 1.f }; // u0, v0, u1, v1
+	};
+
+	namespace TextureAtlas
+	{
+		//	Pack the images listed in a file (one path per line) into pages
+		//	Writes <outputName>_<page>.tga and the <outputName>.atlas description
+		//	Parameters : const std::string& listPath, const std::string& outputName
+		//	-----------------------------------------------------------------------
+		bool pack(const std::string& listPath, const std::string& outputName);
+	}
+}
@@ -42,4 +42,6 @@ public:
 	Sprite* m_sprite = nullptr;
 
 	ButtonAction* m_action = nullptr;
-};
\ No newline at end of file
+};
+
+COMPONENT_ID(Button, ComponentType::Button);
@@ -45,3 +45,5 @@ public:
 	void saveComponentInSCNFile(std::ofstream& file) override;
 	void loadComponentFromSCNFile(std::istringstream& lineStream) override;
 };
+
+COMPONENT_ID(Enemy, ComponentType::Enemy);
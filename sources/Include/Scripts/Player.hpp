@@ -65,4 +65,6 @@ public:
     Vector3f m_playerDirection = Vector3f::zero();
     float displacement_speed = DISPLACEMENT_SPEED;
     float jump_speed = JUMP_SPEED;
-};
\ No newline at end of file
+};
+
+COMPONENT_ID(Player, ComponentType::Player);
@@ -44,4 +44,6 @@ public:
 	void showImGUI() override;
 	void saveComponentInSCNFile(std::ofstream& file) override;
 	void loadComponentFromSCNFile(std::istringstream& lineStream) override;
-};
\ No newline at end of file
+};
+
+COMPONENT_ID(Weapon, ComponentType::Weapon);
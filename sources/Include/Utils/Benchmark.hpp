@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+//	CPU benchmarks runnable from the command line without opening a window
+//	Usage : Engine.exe --bench <name|all>
+namespace Benchmark
+{
+	//	Run the benchmark with this name, "all" runs every benchmark
+	//	Return false if no benchmark has this name or one of their checks failed
+	//	Parameters : const std::string& name
+	//	------------------------------------
+	bool run(const std::string& name);
+
+	//	Write the name of every benchmark in the log
+	//	Parameters : None
+	//	-----------------
+	void list();
+}
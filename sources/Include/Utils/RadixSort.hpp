@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+//	LSD radix sorter on float keys (3 passes of 11 bits)
+//	Scratch buffers are kept between calls, so sorting the same amount of keys
+//	each frame does not allocate once the sorter has warmed up.
+class RadixSorter
+{
+public:
+	//	Constructor & Destructor
+	//	------------------------
+
+	RadixSorter() = default;
+	~RadixSorter() = default;
+
+
+	//	Public Internal Functions
+	//	-------------------------
+
+	//	Grow the scratch buffers to hold at least count keys
+	//	Parameters : unsigned int count
+	//	-------------------------------
+	void reserve(unsigned int count);
+
+	//	Sort the keys by ascending order and return the sorted indices
+	//	The returned array stays valid until the next call to sort
+	//	Parameters : const float* keys, unsigned int count
+	//	--------------------------------------------------
+	const unsigned int* sort(const float* keys, unsigned int count);
+
+private:
+
+	//	Private Internal Variables
+	//	--------------------------
+
+	static constexpr unsigned int RADIX_BITS	= 11;
+	static constexpr unsigned int RADIX_SIZE	= 1 << RADIX_BITS;
+	static constexpr unsigned int RADIX_MASK	= RADIX_SIZE - 1;
+	static constexpr unsigned int RADIX_PASSES	= 3;
+
+	std::vector<unsigned int> m_keys;
+	std::vector<unsigned int> m_keysScratch;
+	std::vector<unsigned int> m_indices;
+	std::vector<unsigned int> m_indicesScratch;
+
+	unsigned int m_histogram[RADIX_PASSES][RADIX_SIZE];
+};
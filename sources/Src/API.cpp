@@ -2,6 +2,8 @@
 
 #include <fstream>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -13,11 +15,24 @@
 #include <Core/TimeManager.h>
 #include <Core/InputsManager.hpp>
 #include <Core/GameManager.hpp>
+#include <Core/RenderThread.hpp>
 #include <LowRenderer/Text.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/GpuProfiler.hpp>
+#include <LowRenderer/RenderStats.hpp>
+#include <LowRenderer/RenderGraph.hpp>
+#include <LowRenderer/RenderDevice.hpp>
 
 #include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/FrameArena.hpp>
+#include <Core/ObjectPool.hpp>
 #include <Resources/Texture.hpp>
 #include <Resources/Shader.hpp>
+#include <Physics/Collider3.hpp>
 #include <Core/Graph.hpp>
 
 struct mode
@@ -36,8 +51,14 @@ int API::init()
 {
 	Core::Window* _window = Core::Window::instance();
 
+	//	Workers for physics, particles and the renderer, this thread helps them when it waits
+	Core::JobSystem::instance()->start();
+
 	//  Setup Dear ImGui
 	m_editor.init(_window->m_window);
+
+	//	Create the ImGui GL objects now, NewFrame() runs without the context when the render thread has it
+	ImGui_ImplOpenGL3_CreateDeviceObjects();
 	
 	return 0;
 }
@@ -64,27 +85,28 @@ static void newFrame()
 
 static void endFrame()
 {
+	RenderStats::instance()->showOverlay();
+
+	//	Lists are drawn with the frame packet
 	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
-void API::windowLoop()
+void API::windowLoop(const std::string& tracePath)
 {
 	Core::TimeManager* _time     = Core::TimeManager::instance();
 	Core::Window* _window		 = Core::Window::instance();
 	Core::Graph* _graph			 = Core::Graph::instance();
-	Core::Log* _log				 = Core::Log::instance();
 
 	Core::InputsManager* _inputs = Core::InputsManager::instance();
 	Core::GameManager* _manager  = Core::GameManager::instance();
-	TextRender* _textRender      = TextRender::instance();
+	Core::RenderThread* _renderThread = Core::RenderThread::instance();
 
 	m_editor.m_graph = _graph;
 	m_editor.setTheme();
 
 	_inputs->init();
 
-	Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
+	PROFILE_THREAD("Main");
 
 	_graph->loadScene("Assets/MainMenu.scn");
 	_graph->m_mode = EngineMode::FULLPLAYMODE;
@@ -93,42 +115,362 @@ void API::windowLoop()
 
 	while (!glfwWindowShouldClose(_window->m_window) && _graph->m_quit == false)
 	{
+		PROFILE_BEGIN_FRAME();
+		PROFILE_SCOPE("Frame");
+		Core::MemoryTracker::beginFrame();
+
 		//	Set Time
-		_window->update();
-		_time->setDeltaTime();
-		_inputs->updateInputs();
-		_manager->update();
+		{
+			PROFILE_SCOPE("Inputs");
+
+			_window->update();
+			_time->setDeltaTime();
+			_inputs->updateInputs();
+			_manager->update();
+		}
 
 		newFrame();
 
-		glClearColor(0.330f, 0.315f, 0.305f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		//	Update the scene while the render thread draws the previous frame
+		FramePacket* packet;
+		{
+			PROFILE_SCOPE("Wait packet");
+			packet = &_renderThread->beginFrame();
+		}
+
+		//	The packet of two frames ago is drawn, its texts can be overwritten
+		Core::FrameArena::get().reset();
 
-		_graph->graphLoop();
+		_graph->graphLoop(*packet);
 
 		if (_graph->m_mode != EngineMode::FULLPLAYMODE)
 		{
+			//	The editor loads resources and reads the renderer, it draws on this thread
+			_renderThread->acquireContext();
 			m_editor.updateEditorWindows();
 		}
 
 		endFrame();
-		glfwSwapBuffers(_window->m_window);
+
+		{
+			PROFILE_SCOPE("Submit");
+			_renderThread->submit(_graph->m_mode == EngineMode::FULLPLAYMODE);
+		}
+
 		glfwPollEvents();
 	}
 
+	_renderThread->stop();
+
+	//	Both threads are stopped, the last frames are kept in the profilers
+	if (!tracePath.empty()) Core::Profiler::instance()->saveTrace(tracePath);
+
 	m_editor.popTheme();
-	
-	_textRender->kill();
-	_resources->kill();
-	_manager->kill();
-	_inputs->kill();
-	_graph->kill();
-	_time->kill();
+
+	shutdown();
+}
+
+
+/*==================================================================================*/
+/*===================================- HEADLESS -===================================*/
+/*==================================================================================*/
+
+int API::runHeadless(const std::string& scenePath, int frameCount, bool assertNoAlloc)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Core::Log* _log				 = Core::Log::instance();
+	Core::TimeManager* _time	 = Core::TimeManager::instance();
+	Core::Window* _window		 = Core::Window::instance();
+	Core::InputsManager* _inputs = Core::InputsManager::instance();
+	Core::GameManager* _manager  = Core::GameManager::instance();
+	Core::RenderThread* _renderThread = Core::RenderThread::instance();
+
+	RenderDevice* _device = RenderDevice::instance();
+	if (_window->m_window || !_device || !_device->isTracking())
+	{
+		_log->writeFailure("Headless run needs the null render device");
+		shutdown();
+		return -1;
+	}
+
+	Core::JobSystem::instance()->start();
+
+	loading();
+	_inputs->init();
+
+	Core::Graph* _graph = Core::Graph::instance();
+	_graph->m_mode = EngineMode::FULLPLAYMODE;
+
+	Clock::time_point loadStart = Clock::now();
+	bool loaded = _graph->loadScene(scenePath);
+	double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+	if (!loaded)
+	{
+		shutdown();
+		return -1;
+	}
+
+	double updateMs = 0.0;
+	double renderMs = 0.0;
+	double minFrameMs = 0.0;
+	double maxFrameMs = 0.0;
+	long long drawCalls = 0;
+	long long vertices = 0;
+
+	int playedFrames = 0;
+	int allocatingFrames = 0;
+	unsigned long long maxFrameAllocations = 0;
+
+	//	Allocations of the frame closed by beginFrame, steady frames must not allocate
+	auto checkAllocations = [&](int frame)
+	{
+		Core::MemoryTracker::beginFrame();
+
+		unsigned long long allocations = Core::MemoryTracker::getFrameAllocations();
+		if (frame < HEADLESS_WARMUP_FRAMES || allocations == 0) return;
+
+		allocatingFrames++;
+		maxFrameAllocations = std::max(maxFrameAllocations, allocations);
+	};
+
+	PROFILE_THREAD("Main");
+
+	for (int i = 0; i < frameCount && !_graph->m_quit; i++)
+	{
+		PROFILE_BEGIN_FRAME();
+		PROFILE_SCOPE("Frame");
+		checkAllocations(i - 1);
+
+		//	Same step every frame, two runs simulate the same game
+		_time->setDeltaTime(HEADLESS_DELTA_TIME);
+		_manager->update();
+		_device->resetFrameStats();
+
+		Clock::time_point start = Clock::now();
+
+		FramePacket& packet = _renderThread->beginFrame();
+		Core::FrameArena::get().reset();
+		_graph->graphLoop(packet);
+
+		Clock::time_point update = Clock::now();
+
+		_renderThread->submit(false);
+
+		Clock::time_point end = Clock::now();
+
+		double frameMs = std::chrono::duration<double, std::milli>(end - start).count();
+		updateMs += std::chrono::duration<double, std::milli>(update - start).count();
+		renderMs += std::chrono::duration<double, std::milli>(end - update).count();
+
+		minFrameMs = i == 0 ? frameMs : std::min(minFrameMs, frameMs);
+		maxFrameMs = std::max(maxFrameMs, frameMs);
+
+		drawCalls += _device->getStats().drawCalls;
+		vertices += _device->getStats().vertices;
+
+		playedFrames++;
+	}
+
+	//	The last frame is checked once rendered, before stop() logs the run
+	_renderThread->acquireContext();
+	checkAllocations(playedFrames - 1);
+	_renderThread->stop();
+
+	const RenderDevice::Stats& stats = _device->getStats();
+
+	//	A quitting scene plays fewer frames than asked
+	int frames = std::max(playedFrames, 1);
+
+	char line[256];
+	snprintf(line, sizeof(line), "Headless %s : %d frames of %.4f s, scene loaded in %.2f ms",
+		scenePath.c_str(), playedFrames, HEADLESS_DELTA_TIME, loadMs);
+	_log->write(line);
+
+	snprintf(line, sizeof(line), "Per frame : update %.3f ms, render %.3f ms, frame %.3f ms (min %.3f, max %.3f)",
+		updateMs / frames, renderMs / frames, (updateMs + renderMs) / frames, minFrameMs, maxFrameMs);
+	_log->write(line);
+
+	snprintf(line, sizeof(line), "Per frame : %lld draw calls, %lld vertices",
+		drawCalls / frames, vertices / frames);
+	_log->write(line);
+
+	snprintf(line, sizeof(line), "Live objects : %d buffers, %d textures, %d vertex arrays, %d framebuffers, %d programs, %d queries",
+		stats.buffers, stats.textures, stats.vertexArrays, stats.framebuffers, stats.programs, stats.queries);
+	_log->write(line);
+
+	int result = 0;
+	if (assertNoAlloc)
+	{
+#if ENABLE_MEMORY_TRACKING
+		if (playedFrames <= HEADLESS_WARMUP_FRAMES)
+		{
+			_log->writeWarning("No allocation checked, the run is not longer than the " + std::to_string(HEADLESS_WARMUP_FRAMES) + " frames of warmup");
+		}
+		else if (allocatingFrames > 0)
+		{
+			snprintf(line, sizeof(line), "%d steady frames allocated, up to %llu allocations in a frame", allocatingFrames, maxFrameAllocations);
+			_log->writeFailure(line);
+			result = -1;
+		}
+		else
+		{
+			_log->writeSuccess("No allocation in the " + std::to_string(playedFrames - HEADLESS_WARMUP_FRAMES) + " steady frames");
+		}
+#else
+		_log->writeWarning("No allocation checked, ENABLE_MEMORY_TRACKING is 0 in Config.hpp");
+#endif
+	}
+
+	shutdown();
+
+	return result;
+}
+
+
+//	Objects in groups of 8, a parent and its 7 children, each with two colliders
+static Resources::Scene* createSyntheticScene(int objectCount)
+{
+	Resources::Scene* scene = new Resources::Scene();
+
+	GameObject* parent = nullptr;
+	for (int i = 0; i < objectCount; i++)
+	{
+		int key = (int)scene->m_objectList.size();
+		GameObject* go = scene->m_objectList[key] = new GameObject(scene);
+
+		go->m_name = "Synthetic_" + std::to_string(i);
+		go->m_transform->m_position = { (float)(i % 100), 0.f, (float)(i / 100) };
+
+		go->addComponent<BoxCollider3D>();
+		go->addComponent<SphereCollider3D>();
+
+		if (i % 8 == 0)
+		{
+			parent = go;
+			continue;
+		}
+
+		go->m_transform->m_parent = parent->m_transform;
+		parent->m_transform->m_childList.push_back(go->m_transform);
+	}
+
+	return scene;
+}
+
+int API::runSceneBenchmark(const std::string& scenePath, int loadCount)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Core::Log* _log			= Core::Log::instance();
+	Core::Window* _window	= Core::Window::instance();
+
+	RenderDevice* _device = RenderDevice::instance();
+	if (_window->m_window || !_device || !_device->isTracking())
+	{
+		_log->writeFailure("Scene benchmark needs the null render device");
+		shutdown();
+		return -1;
+	}
+
+	Core::JobSystem::instance()->start();
+
+	loading();
+
+	Core::Graph* _graph = Core::Graph::instance();
+	_graph->m_mode = EngineMode::FULLPLAYMODE;
+
+	bool synthetic = scenePath == "synthetic";
+
+	double firstLoadMs = 0.0;
+	double loadMs = 0.0;
+	double unloadMs = 0.0;
+	size_t objectCount = 0;
+	size_t slabCount = 0;
+
+	for (int i = 0; i < loadCount; i++)
+	{
+		Clock::time_point start = Clock::now();
+
+		Resources::Scene* scene = nullptr;
+		if (synthetic)
+		{
+			scene = createSyntheticScene(SYNTHETIC_SCENE_OBJECTS);
+		}
+		else if (_graph->loadScene(scenePath))
+		{
+			scene = _graph->getCurrentScene();
+		}
+
+		if (!scene)
+		{
+			shutdown();
+			return -1;
+		}
+
+		//	The first load also reads the resources, the next ones find them loaded
+		double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (i == 0) firstLoadMs = elapsed;
+		else		loadMs += elapsed;
+
+		objectCount = scene->m_objectList.size();
+		slabCount = Core::ObjectPool<GameObject>::get().getSlabCount();
+
+		start = Clock::now();
+
+		if (synthetic)	delete scene;
+		else			_graph->unloadCurrentScene();
+
+		unloadMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	char line[256];
+	snprintf(line, sizeof(line), "Scene %s : %zu objects in %zu slabs of %d, first load %.2f ms",
+		scenePath.c_str(), objectCount, slabCount, POOL_SLAB_OBJECTS, firstLoadMs);
+	_log->write(line);
+
+	snprintf(line, sizeof(line), "Per load : load %.2f ms (without the first), unload %.2f ms, over %d loads",
+		loadCount > 1 ? loadMs / (loadCount - 1) : firstLoadMs, unloadMs / std::max(loadCount, 1), loadCount);
+	_log->write(line);
+
+	shutdown();
+
+	return 0;
+}
+
+
+/*==================================================================================*/
+/*===================================- SHUTDOWN -===================================*/
+/*==================================================================================*/
+
+void API::shutdown()
+{
+	Core::Log* _log = Core::Log::instance();
+	Core::Window* _window = Core::Window::instance();
+
+	TextRender::instance()->kill();
+	QuadBatcher::kill();
+	Resources::ResourcesManager::instance()->kill();
+	Core::GameManager::instance()->kill();
+	Core::InputsManager::instance()->kill();
+	Core::Graph::instance()->kill();
+	Core::RenderThread::instance()->kill();
+	Core::JobSystem::kill();
+	RenderTargetPool::kill();
+	GpuProfiler::kill();
+	RenderStats::kill();
+	Core::Profiler::kill();
+	GLState::kill();
+	Core::TimeManager::instance()->kill();
 	_log->kill();
 
 	_window->kill();
+	RenderDevice::kill();
 
 	// glfw: terminate, clearing all previously allocated GLFW resources.
 	glfwTerminate();
-	ImGui::DestroyContext();
+
+	//	No context when headless
+	if (ImGui::GetCurrentContext()) ImGui::DestroyContext();
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <Core/FrameArena.hpp>
+
+#include <imgui.h>
+
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+
+Core::FrameArena::~FrameArena()
+{
+	for (Frame& frame : m_frames)
+	{
+		Block* block = frame.first;
+		while (block)
+		{
+			Block* next = block->next;
+			delete[] (char*)block;
+			block = next;
+		}
+	}
+}
+
+Core::FrameArena& Core::FrameArena::get()
+{
+	static thread_local FrameArena arena;
+	return arena;
+}
+
+Core::FrameArena::Block* Core::FrameArena::createBlock(size_t size)
+{
+	Block* block = (Block*)new char[sizeof(Block) + size];
+	block->next = nullptr;
+	block->size = size;
+	return block;
+}
+
+void* Core::FrameArena::allocate(size_t size, size_t alignment)
+{
+	Frame& frame = m_frames[m_current];
+
+	//	Created on the first allocation, threads asking for the arena without using it cost nothing
+	if (!frame.first) frame.first = frame.current = createBlock(FRAME_ARENA_SIZE);
+
+	uintptr_t base = (uintptr_t)(frame.current + 1);
+	uintptr_t address = (base + frame.used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+	if (address + size > base + frame.current->size)
+	{
+		Block* block = createBlock(std::max((size_t)FRAME_ARENA_SIZE, size + alignment));
+		frame.current->next = block;
+		frame.current = block;
+		m_overflowBlocks++;
+
+		base = (uintptr_t)(block + 1);
+		address = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+
+	frame.used = address + size - base;
+	frame.bytes += size;
+
+	return (void*)address;
+}
+
+const char* Core::FrameArena::copy(const char* text)
+{
+	size_t length = strlen(text);
+
+	char* result = allocate<char>(length + 1);
+	memcpy(result, text, length + 1);
+
+	return result;
+}
+
+const char* Core::FrameArena::format(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+
+	va_list measure;
+	va_copy(measure, args);
+	int length = std::max(vsnprintf(nullptr, 0, format, measure), 0);
+	va_end(measure);
+
+	char* result = allocate<char>(length + 1);
+	vsnprintf(result, length + 1, format, args);
+	va_end(args);
+
+	return result;
+}
+
+void Core::FrameArena::reset()
+{
+	m_lastBytes = m_frames[m_current].bytes;
+	m_peakBytes = std::max(m_peakBytes, m_lastBytes);
+
+	m_current = (m_current + 1) % FRAME_ARENA_FRAMES;
+
+	//	Only the first block is kept, a frame needing more each time shows in the overflow count
+	Frame& frame = m_frames[m_current];
+	if (frame.first)
+	{
+		Block* block = frame.first->next;
+		while (block)
+		{
+			Block* next = block->next;
+			delete[] (char*)block;
+			block = next;
+		}
+
+		frame.first->next = nullptr;
+	}
+
+	frame.current = frame.first;
+	frame.used = 0;
+	frame.bytes = 0;
+}
+
+void Core::FrameArena::showImGui()
+{
+	ImGui::Text("Frame arena : %.1f KB last frame, %.1f KB peak, %.0f KB per frame", m_lastBytes / 1024.f, m_peakBytes / 1024.f, FRAME_ARENA_SIZE / 1024.f);
+
+	if (m_overflowBlocks) ImGui::TextColored({ 1.f, 0.3f, 0.3f, 1.f }, "Heap blocks chained : %llu, FRAME_ARENA_SIZE is too small", m_overflowBlocks);
+}
@@ -8,8 +8,12 @@
 #include <imgui_impl_opengl3.h>
 
 #include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
 #include <Core/TimeManager.h>
 #include <Core/Graph.hpp>
+#include <Core/RenderThread.hpp>
+#include <Core/Window.hpp>
 
 
 #include <Engine/Layers.hpp>
@@ -21,7 +25,9 @@ Core::Graph::Graph()
 {
 	ComponentTypeInfo* _componentManager = ComponentTypeInfo::instance();
 	LayerDatas* _layers = LayerDatas::instance();
-	AudioPlayer = irrklang::createIrrKlangDevice();
+
+	//	Headless runs play every sound on the null driver
+	AudioPlayer = irrklang::createIrrKlangDevice(Core::Window::s_headless ? irrklang::ESOD_NULL : irrklang::ESOD_AUTO_DETECT);
 }
 
 Core::Graph::~Graph()
@@ -59,6 +65,9 @@ void Core::Graph::newScene(const std::string name)
 
 bool Core::Graph::loadScene(const std::string& path)
 {
+	PROFILE_SCOPE("Load scene");
+	MEMORY_TAG(SCENE);
+
 	Core::Log* _log = Core::Log::instance();
 
 	std::string name = path;
@@ -117,14 +126,17 @@ void Core::Graph::unloadCurrentScene()
 }
 
 
-void Core::Graph::graphLoop()
+void Core::Graph::graphLoop(FramePacket& packet)
 {
+	PROFILE_SCOPE("Graph");
+	MEMORY_TAG(SCENE);
+
 	updateCurrentScene();
 
-	drawCurrentScene();
+	drawCurrentScene(packet);
 }
 
-void Core::Graph::drawCurrentScene()
+void Core::Graph::drawCurrentScene(FramePacket& packet)
 {
 	//	If scene list is empty, return
 	if (m_sceneList.empty()) return;
@@ -132,7 +144,7 @@ void Core::Graph::drawCurrentScene()
 	//	If current list index is valide draw the current scene
 	if (m_sceneList[m_current_scene])
 	{
-		m_sceneList[m_current_scene]->draw();
+		m_sceneList[m_current_scene]->draw(packet);
 	}
 }
 
@@ -145,6 +157,9 @@ void Core::Graph::updateCurrentScene()
 
 	if(m_nextScene != m_current_scene)
 	{
+		//	Loading and unloading call GL, the previous scene may still be drawn
+		Core::RenderThread::instance()->acquireContext();
+
 		if (getCurrentScene())
 			getCurrentScene()->ambientStarted = false;
 		std::string oldScene = m_current_scene;
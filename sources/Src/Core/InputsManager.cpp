@@ -65,7 +65,10 @@ namespace Core
 
 	void InputsManager::updateInputs()
 	{
+		//	No window when headless, the inputs stay released
 		GLFWwindow* window = Core::Window::instance()->m_window;
+		if (!window) return;
+
 		for (auto key : m_key)
 		{
 			key.second->getState(window);
@@ -82,27 +85,33 @@ namespace Core
 
 	Maths::Vector2f InputsManager::getMousePosition()
 	{
+		GLFWwindow* window = Core::Window::instance()->m_window;
+		if (!window) return Maths::Vector2f(0.f, 0.f);
+
 		double dx, dy;
-		glfwGetCursorPos(Core::Window::instance()->m_window, &dx, &dy);
+		glfwGetCursorPos(window, &dx, &dy);
 
 		return Maths::Vector2f((float)dx, (float)dy);
 	}
 
 	void InputsManager::resetOldMouse()
 	{
-		glfwGetCursorPos(Core::Window::instance()->m_window, &m_oldMouseX, &m_oldMouseY);
+		GLFWwindow* window = Core::Window::instance()->m_window;
+		if (window) glfwGetCursorPos(window, &m_oldMouseX, &m_oldMouseY);
 	}
 
 
 	void InputsManager::hideMouse()
 	{
-		glfwSetInputMode(Core::Window::instance()->m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		GLFWwindow* window = Core::Window::instance()->m_window;
+		if (window) glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 	}
 
 
 	void InputsManager::displayMouse()
 	{
-		glfwSetInputMode(Core::Window::instance()->m_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+		GLFWwindow* window = Core::Window::instance()->m_window;
+		if (window) glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 	}
 
 
@@ -111,7 +120,7 @@ namespace Core
 		bool oldDown = down;
 		bool oldUp = up;
 		 
-		down = glfwGetKey(in_window, keyID);
+		down = in_window && glfwGetKey(in_window, keyID);
 
 		up = !down;
 
@@ -128,7 +137,7 @@ namespace Core
 		bool oldDown = down;
 		bool oldUp = up;
 
-		down = glfwGetMouseButton(in_window, keyID);
+		down = in_window && glfwGetMouseButton(in_window, keyID);
 
 		up = !down;
 
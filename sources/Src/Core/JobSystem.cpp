@@ -0,0 +1,397 @@
+#include <Core/JobSystem.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/Log.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+#define JOB_SPIN 64		// Empty looks for a job before a worker sleeps
+
+
+std::atomic<unsigned int> Core::JobSystem::s_generation{ 0 };
+
+//	Slot of the calling thread, valid while its generation is the running one
+static thread_local unsigned int t_generation = 0;
+static thread_local unsigned int t_slot = 0;
+
+
+//	Job queue
+//	---------
+
+bool Core::JobSystem::JobQueue::push(Job* job)
+{
+	long long bottom = m_bottom.load(std::memory_order_relaxed);
+	long long top = m_top.load(std::memory_order_acquire);
+
+	if (bottom - top >= JOB_QUEUE_SIZE) return false;
+
+	m_jobs[bottom & (JOB_QUEUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+
+	//	Publishes the job to the thieves
+	m_bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+Core::JobSystem::Job* Core::JobSystem::JobQueue::pop()
+{
+	//	Taken back before reading the top, a thief can't take the same job
+	long long bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_seq_cst);
+	long long top = m_top.load(std::memory_order_seq_cst);
+
+	if (top > bottom)
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = m_jobs[bottom & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+	//	Last job, raced with the thieves
+	if (top == bottom)
+	{
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+Core::JobSystem::Job* Core::JobSystem::JobQueue::steal()
+{
+	long long top = m_top.load(std::memory_order_seq_cst);
+	long long bottom = m_bottom.load(std::memory_order_seq_cst);
+
+	if (top >= bottom) return nullptr;
+
+	Job* job = m_jobs[top & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+	//	Another thief or the owner took it first
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+
+	return job;
+}
+
+bool Core::JobSystem::JobQueue::isEmpty() const
+{
+	return m_bottom.load(std::memory_order_seq_cst) <= m_top.load(std::memory_order_seq_cst);
+}
+
+
+//	Job system
+//	----------
+
+Core::JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void Core::JobSystem::start(unsigned int workerCount)
+{
+	if (m_running) stop();
+
+	if (workerCount == 0)
+	{
+		unsigned int hardware = std::thread::hardware_concurrency();
+		workerCount = hardware > 1 ? hardware - 1 : 1;
+	}
+
+	m_workerCount = workerCount;
+	m_slotCount = workerCount + 1 + JOB_EXTERNAL_THREADS;
+	m_slots.reset(new ThreadSlot[m_slotCount]);
+
+	for (unsigned int i = 0; i < m_slotCount; i++) m_slots[i].random = i * 2654435761u + 1u;
+
+	//	Slot 0 is the calling thread, then one per worker
+	m_nextSlot.store(workerCount + 1);
+	m_quit.store(false);
+	m_running = true;
+
+	t_generation = ++s_generation;
+	t_slot = 0;
+
+#if ENABLE_PROFILER
+	//	Created here, the workers name themselves in it when they start
+	Core::Profiler::instance();
+#endif
+
+	for (unsigned int i = 1; i <= workerCount; i++) m_workers.emplace_back(&JobSystem::threadLoop, this, i);
+
+	Core::Log::instance()->write("Job system started with " + std::to_string(workerCount) + " workers");
+}
+
+void Core::JobSystem::stop()
+{
+	if (!m_running) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_quit.store(true);
+	}
+	m_wake.notify_all();
+
+	for (std::thread& worker : m_workers) worker.join();
+	m_workers.clear();
+
+	//	Jobs nobody waited for still run, their counters may be read after
+	ThreadSlot* slot = getThreadSlot();
+	while (Job* job = slot ? getJob(*slot) : nullptr) execute(*slot, job);
+
+	m_running = false;
+	m_slots.reset();
+	m_slotCount = 0;
+}
+
+Core::JobSystem::ThreadSlot* Core::JobSystem::getThreadSlot()
+{
+	if (!m_running) return nullptr;
+
+	unsigned int generation = s_generation.load(std::memory_order_relaxed);
+	if (t_generation == generation) return &m_slots[t_slot];
+
+	//	First job of a thread that isn't a worker
+	unsigned int slot = m_nextSlot.fetch_add(1);
+	if (slot >= m_slotCount) return nullptr;
+
+	t_generation = generation;
+	t_slot = slot;
+
+	return &m_slots[slot];
+}
+
+Core::JobSystem::Job* Core::JobSystem::allocateJob(ThreadSlot& slot)
+{
+	Job* job = &slot.jobs[slot.nextJob % JOB_QUEUE_SIZE];
+
+	//	The ring came back to a job still running, this one runs on the spot
+	if (job->active.load(std::memory_order_acquire)) return nullptr;
+
+	slot.nextJob++;
+
+	job->active.store(true, std::memory_order_relaxed);
+	job->tag = MemoryTracker::getThreadTag();
+
+	return job;
+}
+
+void Core::JobSystem::submit(ThreadSlot& slot, Job* job)
+{
+	job->counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	//	Not queued before its dependency is done, the job bringing it to 0 pushes it
+	if (JobCounter* dependency = job->dependency)
+	{
+		dependency->lock();
+		bool held = dependency->m_pending.load(std::memory_order_acquire) > 0;
+		if (held)
+		{
+			job->nextWaiting = dependency->m_waiting;
+			dependency->m_waiting = job;
+		}
+		dependency->unlock();
+
+		if (held) return;
+	}
+
+	push(slot, job);
+}
+
+void Core::JobSystem::push(ThreadSlot& slot, Job* job)
+{
+	if (!slot.queue.push(job))
+	{
+		execute(slot, job);
+		return;
+	}
+
+	//	Seen by a worker going to sleep, or it sees the job
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleeping.load(std::memory_order_relaxed) > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_wake.notify_one();
+	}
+}
+
+Core::JobSystem::Job* Core::JobSystem::getJob(ThreadSlot& slot)
+{
+	Job* job = slot.queue.pop();
+	if (job) return job;
+
+	//	Thieves start at a random thread, they don't all empty the same one
+	slot.random ^= slot.random << 13;
+	slot.random ^= slot.random >> 17;
+	slot.random ^= slot.random << 5;
+
+	unsigned int first = slot.random % m_slotCount;
+	for (unsigned int i = 0; i < m_slotCount; i++)
+	{
+		ThreadSlot& victim = m_slots[(first + i) % m_slotCount];
+		if (&victim == &slot) continue;
+
+		job = victim.queue.steal();
+		if (job)
+		{
+			slot.stolen.fetch_add(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void Core::JobSystem::execute(ThreadSlot& slot, Job* job)
+{
+	{
+		MemoryScope scope(job->tag);
+		job->function(*this, *job);
+	}
+
+	slot.executed.fetch_add(1, std::memory_order_relaxed);
+
+	//	The ring can reuse the job and the waiter leave once the counter is down, nothing is read after
+	JobCounter* counter = job->counter;
+	job->active.store(false, std::memory_order_release);
+
+	//	The last job takes the ones held by the counter, the lock keeps it from looking done until then
+	counter->lock();
+	Job* waiting = nullptr;
+	if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		waiting = counter->m_waiting;
+		counter->m_waiting = nullptr;
+	}
+	counter->unlock();
+
+	while (waiting)
+	{
+		Job* next = waiting->nextWaiting;
+		waiting->nextWaiting = nullptr;
+		push(slot, waiting);
+		waiting = next;
+	}
+}
+
+void Core::JobSystem::wait(JobCounter& counter)
+{
+	ThreadSlot* slot = getThreadSlot();
+
+	while (!counter.isDone())
+	{
+		Job* job = slot ? getJob(*slot) : nullptr;
+
+		if (job) execute(*slot, job);
+		else std::this_thread::yield();
+	}
+}
+
+void Core::JobSystem::executeRange(JobSystem& system, Job& job)
+{
+	RangeJob range = *(RangeJob*)job.data;
+	ThreadSlot* slot = system.getThreadSlot();
+
+	while (range.begin < range.end)
+	{
+		//	Cut in two only when the queue was stolen empty, the other threads want work
+		while (slot && range.end - range.begin > range.grain * 2 && slot->queue.isEmpty())
+		{
+			Job* half = system.allocateJob(*slot);
+			if (!half) break;
+
+			unsigned int middle = range.begin + (range.end - range.begin) / 2;
+
+			RangeJob* split = new (half->data) RangeJob(range);
+			split->begin = middle;
+
+			half->function = &executeRange;
+			half->counter = job.counter;
+			half->dependency = nullptr;
+			system.submit(*slot, half);
+
+			range.end = middle;
+		}
+
+		unsigned int end = std::min(range.begin + range.grain, range.end);
+		range.invoke(range.body, range.begin, end);
+		range.begin = end;
+	}
+}
+
+bool Core::JobSystem::hasWork() const
+{
+	for (unsigned int i = 0; i < m_slotCount; i++)
+	{
+		if (!m_slots[i].queue.isEmpty()) return true;
+	}
+	return false;
+}
+
+void Core::JobSystem::threadLoop(unsigned int slotIndex)
+{
+	t_generation = s_generation.load();
+	t_slot = slotIndex;
+
+	char name[32];
+	snprintf(name, sizeof(name), "Worker %u", slotIndex);
+	PROFILE_THREAD(name);
+
+	ThreadSlot& slot = m_slots[slotIndex];
+
+	int idle = 0;
+	while (!m_quit.load(std::memory_order_acquire))
+	{
+		Job* job = getJob(slot);
+		if (job)
+		{
+			execute(slot, job);
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < JOB_SPIN)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		//	Checked again once counted as sleeping, a job pushed meanwhile wakes us
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+		if (!m_quit.load() && !hasWork()) m_wake.wait(lock);
+
+		m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+		idle = 0;
+	}
+}
+
+void Core::JobSystem::showImGui()
+{
+	if (!m_running)
+	{
+		ImGui::Text("Not started");
+		return;
+	}
+
+	ImGui::Text("%u workers, %d sleeping", m_workerCount, m_sleeping.load());
+
+	ImGui::Columns(3, "Jobs", false);
+	ImGui::Text("Thread");		ImGui::NextColumn();
+	ImGui::Text("Ran");			ImGui::NextColumn();
+	ImGui::Text("Stolen");		ImGui::NextColumn();
+
+	unsigned int slotCount = std::min(m_nextSlot.load(), m_slotCount);
+	for (unsigned int i = 0; i < slotCount; i++)
+	{
+		if (i == 0)						ImGui::Text("Main");
+		else if (i <= m_workerCount)	ImGui::Text("Worker %u", i);
+		else							ImGui::Text("External %u", i - m_workerCount);
+		ImGui::NextColumn();
+
+		ImGui::Text("%llu", m_slots[i].executed.load(std::memory_order_relaxed));	ImGui::NextColumn();
+		ImGui::Text("%llu", m_slots[i].stolen.load(std::memory_order_relaxed));		ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+}
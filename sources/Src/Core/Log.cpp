@@ -1,118 +1,330 @@
 #include <iostream>
 #include <ctime>
-
-
-#include <fstream>
-#include <sstream>
+#include <csignal>
+#include <cstring>
+#include <algorithm>
 
 #include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+
+#include <imgui.h>
 
 #define MAX_S 64
+#define WRITER_PERIOD_MS 20		// Lines are batched this long before the writer thread wakes up
+#define DRAIN_BATCH_SIZE 8192	// Bytes of lines written at once by a drain
+
+
+//	Log the crash handler drains, null once it's killed
+static Core::Log* s_crashLog = nullptr;
+
+static const int s_crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+
+static void writeBatch(FILE* file, const char* batch, size_t size)
+{
+	fwrite(batch, 1, size, stdout);
+	fflush(stdout);
+
+	if (file)
+	{
+		fwrite(batch, 1, size, file);
+		fflush(file);
+	}
+}
 
 
-void getTime(char* c)
+void getTime(char* c, time_t now, const char* format)
 {
 	//	Set Time
-	time_t now = time(0);
 	struct tm time;
 
 	#if defined(__unix__)
-		localtime_r(&time, &now);
+		localtime_r(&now, &time);
 	#elif defined(_MSC_VER)
 		localtime_s(&time, &now);
 	#endif
 
-	//	Create char array c with a specific time format -> HH:MM:SS
-	strftime(c, MAX_S, "%H:%M:%S", &time);
+	//	Create char array c with a specific time format
+	strftime(c, MAX_S, format, &time);
 }
 
 Core::Log::Log()
 {
 	//	Get time
 	char c[MAX_S];
+	getTime(c, time(0), "%H_%M_%S");
 
-	//	Set Time
-	time_t now = time(0);
-	struct tm time;
+	//	Set log name
+	m_logName = "Resource/Log/Log_" + std::string(c) + ".log";
 
-	#if defined(__unix__)
-		localtime_r(&time, &now);
-	#elif defined(_MSC_VER)
-		localtime_s(&time, &now);
-	#endif
+	//	Streamed, the lines written before a crash stay in the file
+	m_file = fopen(m_logName.c_str(), "a");
 
-	//	Create char array c with a specific time format -> HH_MM_SS
-	strftime(c, MAX_S, "%H_%M_%S", &time);
+	{
+		MEMORY_TAG(LOG);
+		m_ring.reset(new Record[LOG_RING_SIZE]);
+	}
+	for (unsigned long long i = 0; i < LOG_RING_SIZE; i++) m_ring[i].sequence.store(i, std::memory_order_relaxed);
 
-	//	Set log name
-	m_logName = "Resource/Log/Log_" + std::string(c) + ".log";
+	s_crashLog = this;
+	for (int signal : s_crashSignals) std::signal(signal, &Log::onCrash);
+
+	m_thread = std::thread(&Log::threadLoop, this);
+
+	if (!m_file) writeError("Unable to create log file - The log won't be saved");
 }
 
 Core::Log::~Log()
 {
-	//	Write its content in a file at he end
-	//	-------------------------------------
+	write("Closing program...");
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_quit = true;
+	}
+	m_wake.notify_all();
 
-	std::ofstream file(m_logName);
+	if (m_thread.joinable()) m_thread.join();
+
+	for (int signal : s_crashSignals) std::signal(signal, SIG_DFL);
+	s_crashLog = nullptr;
+
+	if (m_file) fclose(m_file);
+}
+
+
+long long Core::Log::push(LogLevel level, const char* tag, const char* line, size_t length)
+{
+	unsigned long long position = m_pushed.load(std::memory_order_relaxed);
+	Record* record;
 
-	if (file.is_open() == false)
+	//	Claim the next record, the writer frees it once written
+	while (true)
 	{
-		writeError("Unable to create log file - The log won't be saved");
-		return;
+		record = &m_ring[position % LOG_RING_SIZE];
+		long long turn = (long long)(record->sequence.load(std::memory_order_acquire) - position);
+
+		if (turn == 0)
+		{
+			if (m_pushed.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+		}
+		else if (turn < 0)
+		{
+			m_dropped++;
+			return -1;
+		}
+		else
+		{
+			position = m_pushed.load(std::memory_order_relaxed);
+		}
 	}
 
-	write("Closing program...");
+	size_t tagLength = std::min(strlen(tag), (size_t)LOG_RECORD_SIZE);
+	size_t lineLength = std::min(length, LOG_RECORD_SIZE - tagLength);
+
+	record->time = time(0);
+	record->level = level;
+	record->length = (unsigned short)(tagLength + lineLength);
+	memcpy(record->text, tag, tagLength);
+	memcpy(record->text + tagLength, line, lineLength);
+
+	record->sequence.store(position + 1, std::memory_order_release);
+
+	return (long long)position;
+}
+
+void Core::Log::drain()
+{
+	char batch[DRAIN_BATCH_SIZE];
+	size_t size = 0;
+
+	time_t lastTime = 0;
+	char c[MAX_S] = "";
+
+	while (true)
+	{
+		Record& record = m_ring[m_popped % LOG_RING_SIZE];
+		if (record.sequence.load(std::memory_order_acquire) != m_popped + 1) break;
+
+		//	Lines of the same second share their time
+		if (record.time != lastTime)
+		{
+			getTime(c, record.time, "%H:%M:%S");
+			lastTime = record.time;
+		}
 
-	file << m_content;
+		//	Room for the time, the record and the line break
+		if (size + MAX_S + LOG_RECORD_SIZE + 4 > sizeof(batch))
+		{
+			writeBatch(m_file, batch, size);
+			size = 0;
+		}
 
-	file.close();
+		size += snprintf(batch + size, sizeof(batch) - size, "[%s]\t", c);
+		memcpy(batch + size, record.text, record.length);
+		size += record.length;
+		batch[size++] = '\n';
+
+		record.sequence.store(m_popped + LOG_RING_SIZE, std::memory_order_release);
+		m_popped++;
+	}
+
+	unsigned long long dropped = m_dropped.load();
+	if (dropped != m_reportedDrops)
+	{
+		if (size + MAX_S * 2 + 64 > sizeof(batch))
+		{
+			writeBatch(m_file, batch, size);
+			size = 0;
+		}
+
+		getTime(c, time(0), "%H:%M:%S");
+		size += snprintf(batch + size, sizeof(batch) - size, "[%s]\tWARNING | %llu log lines dropped, the ring was full\n", c, dropped - m_reportedDrops);
+		m_reportedDrops = dropped;
+	}
+
+	if (size) writeBatch(m_file, batch, size);
+
+	m_written.store(m_popped, std::memory_order_release);
 }
 
+void Core::Log::threadLoop()
+{
+	MEMORY_TAG(LOG);
+
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+	while (true)
+	{
+		bool quit = m_quit;
+		m_flushRequested = false;
+		lock.unlock();
+
+		{
+			std::lock_guard<std::mutex> drainLock(m_drainMutex);
+			drain();
+		}
+
+		lock.lock();
+		m_flushed.notify_all();
+
+		if (quit) break;
+
+		m_wake.wait_for(lock, std::chrono::milliseconds(WRITER_PERIOD_MS), [this]() { return m_quit || m_flushRequested; });
+	}
+}
 
-void Core::Log::writeInContent(const std::string& in_line)
+void Core::Log::onCrash(int signal)
 {
-	//	Get time
-	char c[MAX_S];
-	getTime(c);
+	Log* log = s_crashLog;
+
+	if (log)
+	{
+		//	Formatted on the stack, nothing is allocated in the handler
+		char line[32];
+		int length = snprintf(line, sizeof(line), "Crash, signal %d", signal);
+		log->push(LogLevel::LEVEL_ERROR, "ERROR   | ", line, (size_t)std::max(length, 0));
+
+		//	The writer thread may be in the middle of a batch, it's done soon.
+		//	Drained only once it let go, a crash of the writer itself leaves the ring as it is
+		bool locked = false;
+		if (std::this_thread::get_id() != log->m_thread.get_id())
+		{
+			for (int i = 0; i < 100 && !(locked = log->m_drainMutex.try_lock()); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (locked)
+		{
+			log->drain();
+			log->m_drainMutex.unlock();
+		}
+	}
+
+	std::signal(signal, SIG_DFL);
+	std::raise(signal);
+}
+
+
+void Core::Log::flush()
+{
+	unsigned long long target = m_pushed.load();
 
-	//	Create new line
-	std::string new_line = "[" + std::string(c) + "]" + "\t" + in_line + "\n";
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	m_flushRequested = true;
+	m_wake.notify_all();
 
-	//	Display in console
-	std::cout << new_line;
+	m_flushed.wait(lock, [this, target]() { return m_written.load(std::memory_order_acquire) >= target || m_quit; });
+}
+
+void Core::Log::writeLine(LogLevel level, const std::string& in_line)
+{
+	if ((int)level < m_level.load(std::memory_order_relaxed)) return;
 
-	//	Add in content
-	m_content += new_line;
+	static const char* const tags[] = { "INFO    | ", "SUCCESS | ", "WARNING | ", "FAILURE | ", "ERROR   | " };
+
+	long long position = push(level, tags[(int)level], in_line.data(), in_line.size());
+
+	//	Failures and errors may come before a crash, they're written before the game goes on
+	if (level >= LogLevel::LEVEL_FAILURE)
+	{
+		flush();
+		if (position < 0 && push(level, tags[(int)level], in_line.data(), in_line.size()) >= 0) flush();
+	}
+	else if (m_pushed.load(std::memory_order_relaxed) - m_written.load(std::memory_order_relaxed) > LOG_RING_SIZE / 2)
+	{
+		//	Filling up, don't wait for the next batch
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_flushRequested = true;
+		}
+		m_wake.notify_one();
+	}
 }
 
 void Core::Log::write(const std::string& in_line)
 {
-	writeInContent("INFO    | " + in_line);
+	writeLine(LogLevel::LEVEL_INFO, in_line);
 }
 
 void Core::Log::writeSuccess(const std::string& in_line)
 {
-	writeInContent("SUCCESS | " + in_line);
+	writeLine(LogLevel::LEVEL_SUCCESS, in_line);
 }
 
 void Core::Log::writeFailure(const std::string& in_line)
 {
-	writeInContent("FAILURE | " + in_line);
+	writeLine(LogLevel::LEVEL_FAILURE, in_line);
 }
 
 void Core::Log::writeWarning(const std::string& in_line)
 {
-	writeInContent("WARNING | " + in_line);
+	writeLine(LogLevel::LEVEL_WARNING, in_line);
 }
 
 void Core::Log::writeError(const std::string& in_line)
 {
-	writeInContent("ERROR   | " + in_line);
+	writeLine(LogLevel::LEVEL_ERROR, in_line);
 }
 
 void Core::Log::breakLine()
 {
-	writeInContent("        |");
-	writeInContent("        |------------------------------------------------------------------------");
-	writeInContent("        |");
-}
\ No newline at end of file
+	if (m_level.load(std::memory_order_relaxed) > (int)LogLevel::LEVEL_INFO) return;
+
+	static const char separator[] = "------------------------------------------------------------------------";
+
+	push(LogLevel::LEVEL_INFO, "        |", "", 0);
+	push(LogLevel::LEVEL_INFO, "        |", separator, sizeof(separator) - 1);
+	push(LogLevel::LEVEL_INFO, "        |", "", 0);
+}
+
+void Core::Log::showImGui()
+{
+	static const char* const levels[] = { "Info", "Success", "Warning", "Failure", "Error", "None" };
+
+	int level = m_level.load();
+	if (ImGui::Combo("Log level", &level, levels, IM_ARRAYSIZE(levels))) setLevel((LogLevel)level);
+
+	unsigned long long pushed = m_pushed.load();
+	unsigned long long written = m_written.load();
+
+	ImGui::Text("Log lines : %llu written, %llu waiting, %llu dropped", written, pushed - written, m_dropped.load());
+}
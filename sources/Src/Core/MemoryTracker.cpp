@@ -0,0 +1,260 @@
+#include <Core/MemoryTracker.hpp>
+#include <Core/Log.hpp>
+
+#include <imgui.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#define TAG_COUNT ((int)Core::MemoryTag::COUNT)
+#define FRAME_HISTORY 120		// Frames graphed by the panel
+
+
+//	Before each block : its size and tag, 16 bytes keep the alignment of malloc
+struct alignas(16) BlockHeader
+{
+	size_t size;
+	unsigned int tag;
+};
+
+//	Zero initialized before any constructor runs, new works from the first static
+static std::atomic<long long> s_bytes[TAG_COUNT];
+static std::atomic<long long> s_blocks[TAG_COUNT];
+static std::atomic<long long> s_peakBytes[TAG_COUNT];
+static std::atomic<unsigned long long> s_allocations[TAG_COUNT];
+static std::atomic<long long> s_gpuBytes[TAG_COUNT];
+
+static thread_local Core::MemoryTag s_threadTag = Core::MemoryTag::UNTAGGED;
+
+//	Main thread only : beginFrame and the panel
+static unsigned long long s_frameStart[TAG_COUNT];
+static unsigned long long s_frameTagAllocations[TAG_COUNT];
+static unsigned long long s_frameAllocations = 0;
+static float s_frameHistory[FRAME_HISTORY];
+static int s_frameNext = 0;
+
+
+static void formatBytes(char* out, size_t outSize, long long bytes)
+{
+	if (bytes >= 1024ll * 1024ll)	snprintf(out, outSize, "%.2f MB", bytes / (1024.0 * 1024.0));
+	else if (bytes >= 1024ll)		snprintf(out, outSize, "%.2f KB", bytes / 1024.0);
+	else							snprintf(out, outSize, "%lld B", bytes);
+}
+
+
+void* Core::MemoryTracker::allocate(size_t size, MemoryTag tag)
+{
+	BlockHeader* header = (BlockHeader*)malloc(sizeof(BlockHeader) + size);
+	if (!header) return nullptr;
+
+	header->size = size;
+	header->tag = (unsigned int)tag;
+
+	int index = (int)tag;
+	long long bytes = s_bytes[index].fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+	s_blocks[index].fetch_add(1, std::memory_order_relaxed);
+	s_allocations[index].fetch_add(1, std::memory_order_relaxed);
+
+	long long peak = s_peakBytes[index].load(std::memory_order_relaxed);
+	while (bytes > peak && !s_peakBytes[index].compare_exchange_weak(peak, bytes, std::memory_order_relaxed));
+
+	return header + 1;
+}
+
+void Core::MemoryTracker::release(void* pointer)
+{
+	if (!pointer) return;
+
+	BlockHeader* header = (BlockHeader*)pointer - 1;
+
+	s_bytes[header->tag].fetch_sub((long long)header->size, std::memory_order_relaxed);
+	s_blocks[header->tag].fetch_sub(1, std::memory_order_relaxed);
+
+	free(header);
+}
+
+void Core::MemoryTracker::addGpuBytes(MemoryTag tag, long long bytes)
+{
+	s_gpuBytes[(int)tag].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+Core::MemoryTag Core::MemoryTracker::setThreadTag(MemoryTag tag)
+{
+	MemoryTag previous = s_threadTag;
+	s_threadTag = tag;
+	return previous;
+}
+
+Core::MemoryTag Core::MemoryTracker::getThreadTag()
+{
+	return s_threadTag;
+}
+
+void Core::MemoryTracker::beginFrame()
+{
+	s_frameAllocations = 0;
+
+	for (int i = 0; i < TAG_COUNT; i++)
+	{
+		unsigned long long total = s_allocations[i].load(std::memory_order_relaxed);
+
+		s_frameTagAllocations[i] = total - s_frameStart[i];
+		s_frameAllocations += s_frameTagAllocations[i];
+		s_frameStart[i] = total;
+	}
+
+	s_frameHistory[s_frameNext] = (float)s_frameAllocations;
+	s_frameNext = (s_frameNext + 1) % FRAME_HISTORY;
+}
+
+unsigned long long Core::MemoryTracker::getFrameAllocations()
+{
+	return s_frameAllocations;
+}
+
+const char* Core::MemoryTracker::getTagName(MemoryTag tag)
+{
+	static const char* const names[TAG_COUNT] = { "Untagged", "Resources", "Physics", "Renderer", "Scene", "Particles", "Text", "Log" };
+	return names[(int)tag];
+}
+
+void Core::MemoryTracker::logLiveAllocations()
+{
+	//	Read before the log is created, its own blocks are not leaks
+	long long blockCounts[TAG_COUNT], byteCounts[TAG_COUNT];
+	for (int i = 0; i < TAG_COUNT; i++)
+	{
+		blockCounts[i] = s_blocks[i].load();
+		byteCounts[i] = s_bytes[i].load();
+	}
+
+	Core::Log* _log = Core::Log::instance();
+
+	for (int i = 0; i < TAG_COUNT; i++)
+	{
+		long long blocks = blockCounts[i];
+		if (blocks == 0) continue;
+
+		char bytes[32];
+		formatBytes(bytes, sizeof(bytes), byteCounts[i]);
+
+		_log->writeWarning(std::string(getTagName((MemoryTag)i)) + " : " + std::to_string(blocks) + " blocks still allocated (" + bytes + ")");
+	}
+}
+
+void Core::MemoryTracker::showImGui()
+{
+#if !ENABLE_MEMORY_TRACKING
+	ImGui::Text("new and delete not tracked, ENABLE_MEMORY_TRACKING is 0 in Config.hpp");
+#endif
+
+	//	Allocations of the last frames, oldest first
+	//	--------------------------------------------
+
+	char overlay[64];
+	snprintf(overlay, sizeof(overlay), "Allocations this frame : %llu", s_frameAllocations);
+
+	float maxCount = *std::max_element(s_frameHistory, s_frameHistory + FRAME_HISTORY);
+	ImGui::PlotHistogram("##Frame allocations", s_frameHistory, FRAME_HISTORY, s_frameNext, overlay, 0.f, std::max(maxCount * 1.2f, 1.f), ImVec2(0.f, 60.f));
+
+	//	Per subsystem
+	//	-------------
+
+	ImGui::Columns(6, "Memory", false);
+	ImGui::Text("Subsystem");	ImGui::NextColumn();
+	ImGui::Text("Heap");		ImGui::NextColumn();
+	ImGui::Text("Peak");		ImGui::NextColumn();
+	ImGui::Text("Blocks");		ImGui::NextColumn();
+	ImGui::Text("Frame");		ImGui::NextColumn();
+	ImGui::Text("GPU");			ImGui::NextColumn();
+
+	long long heapSum = 0, gpuSum = 0;
+	for (int i = 0; i < TAG_COUNT; i++)
+	{
+		long long heap = s_bytes[i].load(std::memory_order_relaxed);
+		long long gpu = s_gpuBytes[i].load(std::memory_order_relaxed);
+		heapSum += heap;
+		gpuSum += gpu;
+
+		char heapText[32], peakText[32], gpuText[32];
+		formatBytes(heapText, sizeof(heapText), heap);
+		formatBytes(peakText, sizeof(peakText), s_peakBytes[i].load(std::memory_order_relaxed));
+		formatBytes(gpuText, sizeof(gpuText), gpu);
+
+		ImGui::Text("%s", getTagName((MemoryTag)i));									ImGui::NextColumn();
+		ImGui::Text("%s", heapText);													ImGui::NextColumn();
+		ImGui::Text("%s", peakText);													ImGui::NextColumn();
+		ImGui::Text("%lld", s_blocks[i].load(std::memory_order_relaxed));				ImGui::NextColumn();
+		ImGui::Text("%llu", s_frameTagAllocations[i]);									ImGui::NextColumn();
+		ImGui::Text("%s", gpuText);														ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+
+	char heapText[32], gpuText[32];
+	formatBytes(heapText, sizeof(heapText), heapSum);
+	formatBytes(gpuText, sizeof(gpuText), gpuSum);
+	ImGui::Text("Total : %s on the heap, %s on the GPU", heapText, gpuText);
+}
+
+
+#if ENABLE_MEMORY_TRACKING
+
+//	Global new and delete, every allocation of the engine goes through the tracker
+//	------------------------------------------------------------------------------
+
+void* operator new(size_t size)
+{
+	void* pointer = Core::MemoryTracker::allocate(size, s_threadTag);
+	if (!pointer) throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Core::MemoryTracker::allocate(size, s_threadTag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Core::MemoryTracker::allocate(size, s_threadTag);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	Core::MemoryTracker::release(pointer);
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include <Core/ObjectPool.hpp>
+#include <Core/MemoryTracker.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+
+Core::PoolBase::PoolBase(const char* name, size_t objectSize, size_t alignment)
+	: m_name(name)
+{
+	//	A free slot holds the next one, slots keep the alignment of the type
+	m_stride = std::max(objectSize, sizeof(Slot));
+	m_stride = (m_stride + alignment - 1) / alignment * alignment;
+
+	PoolBase*& pools = getPools();
+	m_nextPool = pools;
+	pools = this;
+}
+
+Core::PoolBase::~PoolBase()
+{
+	//	Pools die after main, objects still alive are not destroyed
+	m_live = 0;
+	trim();
+
+	PoolBase** pool = &getPools();
+	while (*pool && *pool != this) pool = &(*pool)->m_nextPool;
+	if (*pool) *pool = m_nextPool;
+}
+
+Core::PoolBase*& Core::PoolBase::getPools()
+{
+	static PoolBase* pools = nullptr;
+	return pools;
+}
+
+void* Core::PoolBase::allocate()
+{
+	if (!m_free)
+	{
+		MEMORY_TAG(SCENE);
+
+		Slab* slab = (Slab*)new char[sizeof(Slab) + m_stride * POOL_SLAB_OBJECTS];
+		slab->next = m_slabs;
+		m_slabs = slab;
+		m_slabCount++;
+
+		//	Listed backward, the slots are given in the order of the memory
+		char* first = (char*)(slab + 1);
+		for (int i = POOL_SLAB_OBJECTS - 1; i >= 0; i--)
+		{
+			Slot* slot = (Slot*)(first + i * m_stride);
+			slot->next = m_free;
+			m_free = slot;
+		}
+	}
+
+	Slot* slot = m_free;
+	m_free = slot->next;
+
+	m_live++;
+	m_peakLive = std::max(m_peakLive, m_live);
+
+	return slot;
+}
+
+void Core::PoolBase::release(void* object)
+{
+	if (!object) return;
+
+	Slot* slot = (Slot*)object;
+	slot->next = m_free;
+	m_free = slot;
+
+	m_live--;
+}
+
+void Core::PoolBase::trim()
+{
+	if (m_live) return;
+
+	while (m_slabs)
+	{
+		Slab* next = m_slabs->next;
+		delete[] (char*)m_slabs;
+		m_slabs = next;
+	}
+
+	m_free = nullptr;
+	m_slabCount = 0;
+}
+
+void Core::PoolBase::trimAll()
+{
+	for (PoolBase* pool = getPools(); pool; pool = pool->m_nextPool) pool->trim();
+}
+
+void Core::PoolBase::showImGui()
+{
+	ImGui::Columns(4, "Object pools", false);
+	ImGui::Text("Pool");		ImGui::NextColumn();
+	ImGui::Text("Objects");		ImGui::NextColumn();
+	ImGui::Text("Peak");		ImGui::NextColumn();
+	ImGui::Text("Slabs");		ImGui::NextColumn();
+
+	for (PoolBase* pool = getPools(); pool; pool = pool->m_nextPool)
+	{
+		ImGui::Text("%s", pool->m_name);								ImGui::NextColumn();
+		ImGui::Text("%zu", pool->m_live);								ImGui::NextColumn();
+		ImGui::Text("%zu", pool->m_peakLive);							ImGui::NextColumn();
+		ImGui::Text("%zu (%.1f KB)", pool->m_slabCount,
+			pool->m_slabCount * (sizeof(Slab) + pool->m_stride * POOL_SLAB_OBJECTS) / 1024.f);	ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+}
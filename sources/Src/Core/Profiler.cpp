@@ -0,0 +1,290 @@
+#include <Core/Profiler.hpp>
+#include <Core/Log.hpp>
+
+#include <LowRenderer/GpuProfiler.hpp>
+
+#include <imgui.h>
+
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+
+#define FLAME_ROW 18.f		// Height of a depth of the flame view, in pixels
+
+
+std::atomic<unsigned int> Core::Profiler::s_nextId{ 0 };
+std::atomic<unsigned int> Core::Profiler::s_liveId{ 0 };
+
+
+//	Same color for a name from frame to frame, the literals of two files may not share their pointer
+static float getNameHue(const char* name)
+{
+	unsigned int hash = 2166136261u;
+	for (const char* c = name; *c; c++) hash = (hash ^ (unsigned char)*c) * 16777619u;
+
+	return (hash % 1000) / 1000.f;
+}
+
+
+Core::Profiler::ThreadSlot::~ThreadSlot()
+{
+	//	Rings are deleted with their profiler
+	if (buffer && profiler == s_liveId.load()) buffer->exited.store(true, std::memory_order_release);
+}
+
+Core::Profiler::Profiler()
+	: m_id(++s_nextId)
+{
+	s_liveId.store(m_id);
+}
+
+Core::Profiler::~Profiler()
+{
+	s_liveId.store(0);
+}
+
+long long Core::Profiler::getTicks()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Core::Profiler::ThreadBuffer* Core::Profiler::getThreadBuffer()
+{
+	static thread_local ThreadSlot slot;
+	if (slot.profiler == m_id) return slot.buffer;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	//	Threads started every frame reuse the rings of the ended ones
+	ThreadBuffer* buffer = nullptr;
+	for (size_t i = 0; i < m_threads.size() && !buffer; i++)
+	{
+		if (!m_threads[i]->exited.load(std::memory_order_acquire)) continue;
+
+		buffer = m_threads[i].get();
+		buffer->exited.store(false, std::memory_order_relaxed);
+		buffer->depth = 0;
+		buffer->name = "Thread " + std::to_string(i);
+	}
+
+	if (!buffer)
+	{
+		m_threads.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+		buffer = m_threads.back().get();
+		buffer->name = "Thread " + std::to_string(m_threads.size() - 1);
+	}
+
+	slot.profiler = m_id;
+	slot.buffer = buffer;
+
+	return buffer;
+}
+
+void Core::Profiler::setThreadName(const char* name)
+{
+	ThreadBuffer* buffer = getThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	buffer->name = name;
+}
+
+int Core::Profiler::beginScope()
+{
+	return getThreadBuffer()->depth++;
+}
+
+void Core::Profiler::endScope(const char* name, long long start, int depth)
+{
+	ThreadBuffer* buffer = getThreadBuffer();
+	buffer->depth = depth;
+
+	unsigned long long head = buffer->head.load(std::memory_order_relaxed);
+
+	Event& event = buffer->events[head % THREAD_EVENTS];
+	event.name = name;
+	event.start = start;
+	event.end = getTicks();
+	event.depth = depth;
+
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Core::Profiler::collect(ThreadBuffer& buffer)
+{
+	unsigned long long head = buffer.head.load(std::memory_order_acquire);
+
+	if (head - buffer.tail > THREAD_EVENTS)
+	{
+		buffer.dropped += head - buffer.tail - THREAD_EVENTS;
+		buffer.tail = head - THREAD_EVENTS;
+	}
+
+	if (!m_paused)
+	{
+		unsigned long long first = buffer.historyHead;
+		for (unsigned long long i = buffer.tail; i < head; i++) buffer.history[buffer.historyHead++ % HISTORY_EVENTS] = buffer.events[i % THREAD_EVENTS];
+
+		//	Full, the oldest events are written over
+		if (buffer.historyHead - buffer.historyTail > HISTORY_EVENTS) buffer.historyTail = buffer.historyHead - HISTORY_EVENTS;
+
+		//	The thread may have come around the ring while it was copied, the overwritten events are dropped
+		unsigned long long after = buffer.head.load(std::memory_order_acquire);
+		if (after - buffer.tail > THREAD_EVENTS)
+		{
+			unsigned long long torn = std::min(after - THREAD_EVENTS - buffer.tail, head - buffer.tail);
+			for (unsigned long long i = first + torn; i < buffer.historyHead; i++) buffer.history[(i - torn) % HISTORY_EVENTS] = buffer.history[i % HISTORY_EVENTS];
+
+			buffer.historyHead -= torn;
+			buffer.historyTail = std::min(buffer.historyTail, buffer.historyHead);
+			buffer.dropped += torn;
+		}
+	}
+
+	buffer.tail = head;
+
+	//	A thread ends its scopes in order, the oldest are first
+	if (m_frameCount == 0) return;
+
+	long long oldest = getFrameStart(0);
+	while (buffer.historyTail < buffer.historyHead && buffer.history[buffer.historyTail % HISTORY_EVENTS].end < oldest) buffer.historyTail++;
+}
+
+void Core::Profiler::beginFrame()
+{
+	long long now = getTicks();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_paused)
+	{
+		m_frameStarts[m_frameCount % (FRAMES + 1)] = now;
+		m_frameCount++;
+	}
+
+	for (std::unique_ptr<ThreadBuffer>& buffer : m_threads) collect(*buffer);
+}
+
+void Core::Profiler::writeTraceEvents(std::ostream& out, bool& first)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (const std::unique_ptr<ThreadBuffer>& buffer : m_threads)
+	{
+		for (unsigned long long i = buffer->historyTail; i < buffer->historyHead; i++)
+		{
+			const Event& event = buffer->history[i % HISTORY_EVENTS];
+
+			char line[256];
+			snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":\"%s\"}",
+				event.name, event.start / 1000.0, (event.end - event.start) / 1000.0, buffer->name.c_str());
+
+			out << (first ? "" : ",\n") << line;
+			first = false;
+		}
+	}
+}
+
+void Core::Profiler::saveTrace(const std::string& path)
+{
+	Core::Log* _log = Core::Log::instance();
+
+	std::ofstream file(path);
+	if (!file)
+	{
+		_log->writeError("Can't write the trace in " + path);
+		return;
+	}
+
+	bool first = true;
+	file << "{\"traceEvents\":[\n";
+	writeTraceEvents(file, first);
+	GpuProfiler::instance()->writeTraceEvents(file, first);
+	file << "\n]}\n";
+
+	_log->writeSuccess("Trace saved in " + path);
+}
+
+void Core::Profiler::showImGui()
+{
+#if !ENABLE_PROFILER
+	ImGui::Text("Compiled out, ENABLE_PROFILER is 0 in Config.hpp");
+	return;
+#endif
+
+	ImGui::Checkbox("Pause", &m_paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Save trace")) saveTrace(TRACE_FILE);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	int frameCount = getKeptFrames() - 1;
+	if (frameCount < 1)
+	{
+		ImGui::Text("No frame collected yet");
+		return;
+	}
+
+	//	Main thread frame time, oldest first
+	//	------------------------------------
+
+	float frameMs[FRAMES];
+	float maxMs = 0.f;
+	for (int i = 0; i < frameCount; i++)
+	{
+		frameMs[i] = (getFrameStart(i + 1) - getFrameStart(i)) / 1000000.f;
+		maxMs = std::max(maxMs, frameMs[i]);
+	}
+
+	ImGui::PlotLines("##CPU frame", frameMs, frameCount, 0, "CPU frame", 0.f, maxMs * 1.2f, ImVec2(0.f, 60.f));
+
+	m_frameOffset = std::min(m_frameOffset, frameCount - 1);
+	ImGui::SliderInt("Frames back", &m_frameOffset, 0, frameCount - 1);
+
+	long long frameStart = getFrameStart(frameCount - 1 - m_frameOffset);
+	long long frameEnd = getFrameStart(frameCount - m_frameOffset);
+	double frameDuration = (double)std::max(frameEnd - frameStart, 1ll);
+
+	ImGui::Text("Frame : %.3f ms", frameDuration / 1000000.0);
+
+	//	Flame view, a band per thread and a row per depth
+	//	-------------------------------------------------
+
+	float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	for (const std::unique_ptr<ThreadBuffer>& buffer : m_threads)
+	{
+		int depthCount = 0;
+		for (unsigned long long i = buffer->historyTail; i < buffer->historyHead; i++)
+		{
+			const Event& event = buffer->history[i % HISTORY_EVENTS];
+			if (event.end >= frameStart && event.start <= frameEnd) depthCount = std::max(depthCount, event.depth + 1);
+		}
+
+		if (depthCount == 0) continue;
+
+		if (buffer->dropped)	ImGui::Text("%s (%d scopes dropped)", buffer->name.c_str(), (int)buffer->dropped);
+		else					ImGui::Text("%s", buffer->name.c_str());
+
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImGui::Dummy(ImVec2(width, depthCount * FLAME_ROW));
+
+		for (unsigned long long i = buffer->historyTail; i < buffer->historyHead; i++)
+		{
+			const Event& event = buffer->history[i % HISTORY_EVENTS];
+			if (event.end < frameStart || event.start > frameEnd) continue;
+
+			float x0 = origin.x + (float)(std::max(event.start - frameStart, 0ll) / frameDuration) * width;
+			float x1 = std::max(origin.x + (float)(std::min(event.end - frameStart, frameEnd - frameStart) / frameDuration) * width, x0 + 1.f);
+
+			ImVec2 min = { x0, origin.y + event.depth * FLAME_ROW };
+			ImVec2 max = { x1, min.y + FLAME_ROW - 1.f };
+
+			drawList->AddRectFilled(min, max, ImColor::HSV(getNameHue(event.name), 0.55f, 0.75f));
+
+			if (ImGui::CalcTextSize(event.name).x < x1 - x0 - 4.f) drawList->AddText({ x0 + 2.f, min.y + 1.f }, IM_COL32_WHITE, event.name);
+
+			if (ImGui::IsMouseHoveringRect(min, max)) ImGui::SetTooltip("%s : %.3f ms", event.name, (event.end - event.start) / 1000000.0);
+		}
+	}
+}
@@ -0,0 +1,317 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <Core/RenderThread.hpp>
+#include <Core/RendererManager.hpp>
+#include <Core/Window.hpp>
+#include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+
+#include <LowRenderer/GpuProfiler.hpp>
+#include <LowRenderer/RenderStats.hpp>
+
+#include <imgui.h>
+#include <imgui_impl_opengl3.h>
+
+#include <cstdio>
+#include <algorithm>
+
+#define STATS_FRAMES 120
+
+
+template<typename TimePoint>
+static double getMs(const TimePoint& start, const TimePoint& end)
+{
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+double Core::RenderThread::FrameTimes::getOverlapMs() const
+{
+	if (frames == 0 || mainFrames == 0 || renderFrames == 0) return 0.0;
+
+	return std::max(mainMs / mainFrames + renderMs / renderFrames - frameMs / frames, 0.0);
+}
+
+
+Core::RenderThread::~RenderThread()
+{
+	stop();
+}
+
+FramePacket& Core::RenderThread::beginFrame()
+{
+	Clock::time_point start = Clock::now();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	//	The packet was last used two frames ago, the render thread may still draw the last one
+	m_condition.wait(lock, [this]() { return m_renderedFrames + 1 >= m_submittedFrames; });
+
+	Clock::time_point end = Clock::now();
+
+	if (m_hasFrameStart)
+	{
+		double frameMs = getMs(m_frameStart, start);
+
+		m_window.frameMs += frameMs;
+		m_window.frames++;
+		m_run.frameMs += frameMs;
+		m_run.frames++;
+	}
+
+	m_window.waitMs += getMs(start, end);
+	m_run.waitMs += getMs(start, end);
+
+	if (m_window.frames >= STATS_FRAMES)
+	{
+		m_average = m_window;
+		m_window = FrameTimes();
+	}
+
+	lock.unlock();
+
+	m_frameStart = start;
+	m_hasFrameStart = true;
+	m_mainStart = end;
+
+	FramePacket& packet = m_packets[m_submittedFrames % 2];
+	packet.clear();
+
+	return packet;
+}
+
+void Core::RenderThread::submit(bool threaded)
+{
+	threaded = threaded && m_enabled;
+
+	double mainMs = getMs(m_mainStart, Clock::now());
+
+	//	Draw the frames left before drawing on this thread
+	if (!threaded) acquireContext();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (threaded != m_threaded)
+	{
+		logRun();
+		m_run = FrameTimes();
+		m_threaded = threaded;
+	}
+
+	m_window.mainMs += mainMs;
+	m_window.mainFrames++;
+	m_run.mainMs += mainMs;
+	m_run.mainFrames++;
+
+	FramePacket& packet = m_packets[m_submittedFrames % 2];
+
+	if (!threaded)
+	{
+		lock.unlock();
+
+		//	ImGui lists are still valid until the next NewFrame(), no context when headless
+		packet.imguiData = ImGui::GetCurrentContext() ? ImGui::GetDrawData() : nullptr;
+		render(packet);
+
+		lock.lock();
+		m_submittedFrames++;
+		m_renderedFrames++;
+		addRenderTimes(packet);
+
+		return;
+	}
+
+	lock.unlock();
+
+	packet.copyImGui(ImGui::GetDrawData());
+
+	if (!m_thread.joinable())
+	{
+		m_quit = false;
+		m_thread = std::thread(&RenderThread::threadLoop, this);
+	}
+
+	//	The render thread makes the context current before drawing
+	if (m_mainHasContext)
+	{
+		glfwMakeContextCurrent(nullptr);
+		m_mainHasContext = false;
+	}
+
+	lock.lock();
+	m_submittedFrames++;
+	m_condition.notify_all();
+}
+
+void Core::RenderThread::acquireContext()
+{
+	if (m_mainHasContext) return;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_condition.wait(lock, [this]() { return m_renderedFrames == m_submittedFrames; });
+
+	if (m_renderHasContext)
+	{
+		m_releaseContext = true;
+		m_condition.notify_all();
+		m_condition.wait(lock, [this]() { return !m_renderHasContext; });
+	}
+
+	if (GLFWwindow* window = Core::Window::instance()->m_window) glfwMakeContextCurrent(window);
+	m_mainHasContext = true;
+}
+
+void Core::RenderThread::stop()
+{
+	acquireContext();
+
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_condition.notify_all();
+
+		m_thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	logRun();
+	m_run = FrameTimes();
+}
+
+void Core::RenderThread::render(FramePacket& packet)
+{
+	PROFILE_SCOPE("Render");
+	MEMORY_TAG(RENDERER);
+
+	Clock::time_point start = Clock::now();
+
+	GpuProfiler* _gpuProfiler = GpuProfiler::instance();
+	_gpuProfiler->beginFrame();
+
+	RenderStats* _renderStats = RenderStats::instance();
+	_renderStats->beginFrame();
+
+	glClearColor(0.330f, 0.315f, 0.305f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	if (packet.renderer) packet.renderer->render(packet);
+
+	//	ImGui isn't counted, its backend calls GL directly
+	_renderStats->endFrame(packet.stats);
+
+	if (packet.imguiData)
+	{
+		GpuScope scope("ImGui");
+		ImGui_ImplOpenGL3_RenderDrawData(packet.imguiData);
+	}
+
+	_gpuProfiler->endFrame();
+
+	Clock::time_point swap = Clock::now();
+
+	//	No window when headless
+	if (GLFWwindow* window = Core::Window::instance()->m_window)
+	{
+		PROFILE_SCOPE("Swap");
+		glfwSwapBuffers(window);
+	}
+
+	packet.renderMs = getMs(start, swap);
+	packet.swapMs = getMs(swap, Clock::now());
+}
+
+void Core::RenderThread::threadLoop()
+{
+	PROFILE_THREAD("Render");
+	MEMORY_TAG(RENDERER);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true)
+	{
+		m_condition.wait(lock, [this]() { return m_quit || m_releaseContext || m_renderedFrames < m_submittedFrames; });
+
+		//	Only asked once every frame is drawn
+		if (m_releaseContext)
+		{
+			if (m_renderHasContext) glfwMakeContextCurrent(nullptr);
+
+			m_renderHasContext = false;
+			m_releaseContext = false;
+			m_condition.notify_all();
+			continue;
+		}
+
+		if (m_renderedFrames < m_submittedFrames)
+		{
+			FramePacket& packet = m_packets[m_renderedFrames % 2];
+
+			if (!m_renderHasContext)
+			{
+				glfwMakeContextCurrent(Core::Window::instance()->m_window);
+				m_renderHasContext = true;
+			}
+
+			lock.unlock();
+			render(packet);
+			lock.lock();
+
+			m_renderedFrames++;
+			addRenderTimes(packet);
+			m_condition.notify_all();
+			continue;
+		}
+
+		if (m_quit) break;
+	}
+
+	if (m_renderHasContext)
+	{
+		glfwMakeContextCurrent(nullptr);
+		m_renderHasContext = false;
+	}
+}
+
+void Core::RenderThread::addRenderTimes(const FramePacket& packet)
+{
+	m_window.renderMs += packet.renderMs;
+	m_window.swapMs += packet.swapMs;
+	m_window.renderFrames++;
+
+	m_run.renderMs += packet.renderMs;
+	m_run.swapMs += packet.swapMs;
+	m_run.renderFrames++;
+}
+
+void Core::RenderThread::logRun()
+{
+	if (m_run.frames == 0 || m_run.mainFrames == 0 || m_run.renderFrames == 0) return;
+
+	char line[256];
+	snprintf(line, sizeof(line), "%s : %d frames, %.2f ms per frame, main %.2f ms (%.2f waiting), render %.2f ms + swap %.2f ms, overlap %.2f ms",
+		m_threaded ? "Render thread" : "Single thread", m_run.frames, m_run.frameMs / m_run.frames,
+		m_run.mainMs / m_run.mainFrames, m_run.waitMs / m_run.mainFrames,
+		m_run.renderMs / m_run.renderFrames, m_run.swapMs / m_run.renderFrames, m_run.getOverlapMs());
+
+	Core::Log::instance()->write(line);
+}
+
+void Core::RenderThread::showImGui()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	ImGui::Text("Mode : %s", m_threaded ? "render thread" : (m_enabled ? "single thread (editor)" : "single thread (--single-thread)"));
+
+	if (m_average.frames == 0 || m_average.mainFrames == 0 || m_average.renderFrames == 0) return;
+
+	ImGui::Text("Frame : %.2f ms", m_average.frameMs / m_average.frames);
+	ImGui::Text("Main thread : %.2f ms, %.2f ms waiting", m_average.mainMs / m_average.mainFrames, m_average.waitMs / m_average.mainFrames);
+	ImGui::Text("Render : %.2f ms, swap %.2f ms", m_average.renderMs / m_average.renderFrames, m_average.swapMs / m_average.renderFrames);
+	ImGui::Text("Overlap : %.2f ms", m_average.getOverlapMs());
+}
@@ -3,6 +3,11 @@
 #include <Config.hpp>
 #include <Core/RendererManager.hpp>
 #include <Core/Graph.hpp>
+#include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/RenderThread.hpp>
+#include <Core/Window.hpp>
 
 #include <Resources/ResourcesManager.hpp>
 #include <Resources/Shader.hpp>
@@ -16,13 +21,25 @@
 #include <LowRenderer/ParticleSystem.hpp>
 #include <LowRenderer/SpriteBillboard.h>
 #include <LowRenderer/Text.hpp>
+#include <LowRenderer/FramePacket.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/GpuProfiler.hpp>
+#include <LowRenderer/RenderStats.hpp>
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#include <cstring>
+
+
+#define STORAGE_SEGMENT_SIZE (MAX_BATCH_DRAWS * (sizeof(GpuObject) + sizeof(GpuMaterial)) + 256) // A full batch and the largest storage alignment
+#define COMMAND_SEGMENT_SIZE (MAX_BATCH_DRAWS * 5 * sizeof(GLuint)) // A full batch of DrawElementsIndirectCommand
 
 Core::RendererManager::RendererManager()
+	: m_storageRing("Opaque objects", GL_SHADER_STORAGE_BUFFER, STORAGE_SEGMENT_SIZE),
+	  m_commandRing("Opaque commands", GL_DRAW_INDIRECT_BUFFER, COMMAND_SEGMENT_SIZE)
 {	if(Core::Graph::instance()->m_mode != EngineMode::FULLPLAYMODE) m_cameraList[0] = &m_editorCamera;
 	m_activeCamera = 0;
 
@@ -38,19 +55,12 @@ Core::RendererManager::~RendererManager()
 	delete m_cubeMap;
 }
 
-void Core::RendererManager::sendDatasToGPU(const CameraBase& activeCamera)
+void Core::RendererManager::sendDatasToGPU(const CameraBase& activeCamera, float renderScale)
 {
 	Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
 
-
-	//	Send datas to the Shaders
-	//	-------------------------
-
-	for (auto curr_shader : resources->m_shaderName_shader)
+	auto sendDatas = [&](Resources::Shader* shad)
 	{
-		Resources::Shader* shad = &curr_shader.second;
-		if (shad->m_type == Resources::ShaderType::POST_PROCESS) continue;
-
 		shad->use();
 		if (activeCamera.projectionMode == ORTHOGRAPHIC)
 		{
@@ -65,13 +75,50 @@ void Core::RendererManager::sendDatasToGPU(const CameraBase& activeCamera)
 
 		if (shad->m_type == Resources::ShaderType::SHADER_3D)
 		{
-			shad->setLights(m_lightList);
+			m_lightClusters.setUniforms(*shad, renderScale);
 
 			shad->setFloat3("ViewPos", activeCamera.getPosition());
 		}
+	};
+
+
+	//	Send datas to the Shaders and their variants
+	//	--------------------------------------------
+
+	for (auto& curr_shader : resources->m_shaderName_shader)
+	{
+		Resources::Shader* shad = &curr_shader.second;
+		if (shad->m_type == Resources::ShaderType::POST_PROCESS) continue;
+
+		sendDatas(shad);
+
+		for (auto& variant : shad->getVariants())
+		{
+			//	Not used before it's ready
+			if (variant.second->isReady()) sendDatas(variant.second.get());
+		}
 	}
 }
 
+void Core::RendererManager::prewarmShaders()
+{
+	Core::Log* _log = Core::Log::instance();
+
+	unsigned int variantCount = Resources::Shader::getVariantCount();
+
+	for (auto _model : m_modelList)
+	{
+		if (_model.second) _model.second->prewarm();
+	}
+
+	for (auto _particleSystem : m_particleSystemList)
+	{
+		if (_particleSystem.second) _particleSystem.second->prewarm();
+	}
+
+	_log->write("+ Prewarmed " + std::to_string(Resources::Shader::getVariantCount() - variantCount) + " shader variants (" + std::to_string(Resources::Shader::getVariantCount()) + " in total)");
+}
+
 
 void Core::RendererManager::update()
 {
@@ -82,26 +129,27 @@ void Core::RendererManager::update()
 	m_UICamera.update();
 }
 
-void Core::RendererManager::draw()
+void Core::RendererManager::extract(FramePacket& packet)
 {
+	PROFILE_SCOPE("Extract");
+	MEMORY_TAG(RENDERER);
+
+	m_packet = &packet;
+	packet.renderer = this;
 
 	if (getActiveCamera() != nullptr)
 	{
-		//	Send datas to GPU before Drawing
-		sendDatasToGPU(*getActiveCamera());
-	}
+		packet.hasCamera = true;
+		packet.camera = CameraSnapshot(*getActiveCamera());
 
-	m_postProcess.beginRender();
+		LightClusters::gather(m_lightList, packet.lights);
 
-	if (getActiveCamera() != nullptr)
-	{
-		if(m_cubeMap) m_cubeMap->draw();
+		//	Gather each model in the camera frustum, with its lights when they are picked per object
+		packet.objectLights = m_objectLights;
+		if (m_objectLights) m_lightSelector.build(packet.lights);
 
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glEnable(GL_BLEND);
-		glEnable(GL_DEPTH_TEST);
+		packet.opaquePass.begin(packet.camera, m_objectLights ? &m_lightSelector : nullptr);
 
-		//	Draw each models
 		for (auto _model : m_modelList)
 		{
 			//	Verify if it still exist
@@ -111,10 +159,18 @@ void Core::RendererManager::draw()
 				continue;
 			}
 
-			if (_model.second->isActive()) _model.second->draw();
+			if (_model.second->isActive()) _model.second->gather(packet.opaquePass);
 		}
 
-		//	Draw each particle
+		packet.opaquePass.end();
+
+		packet.stats.visibleObjects = packet.opaquePass.getItemCount();
+		packet.stats.culledObjects = packet.opaquePass.getCulledCount();
+
+		//	Gather every translucent quad of the frame
+		packet.translucentPass.begin(packet.camera.getViewMatrix());
+
+		//	Gather each particle
 		for (auto _particleSystem : m_particleSystemList)
 		{
 			//	Verify if it's still exist
@@ -124,32 +180,29 @@ void Core::RendererManager::draw()
 				continue;
 			}
 
-			if (_particleSystem.second->isActive()) _particleSystem.second->draw();
+			packet.stats.particlesSimulated += _particleSystem.second->getParticleCount();
+			if (_particleSystem.second->isActive()) _particleSystem.second->gatherTranslucent(packet.translucentPass);
 		}
 
-		//	Draw each billboarded sprite 
+		packet.stats.particlesDrawn = packet.translucentPass.getItemCount();
+
+		//	Gather each billboarded sprite 
 		for (auto billsprite : m_spriteBillboardList)
 		{
 			//	Verify if it's still exist
 			if (billsprite.second == nullptr)
 			{
-				m_particleSystemList.erase(billsprite.first);
+				m_spriteBillboardList.erase(billsprite.first);
 				continue;
 			}
 
-			if (billsprite.second->isActive()) billsprite.second->draw();
+			if (billsprite.second->isActive()) billsprite.second->gatherTranslucent(packet.translucentPass);
 		}
-
-		glDisable(GL_BLEND);
 	}
 
-	m_postProcess.endRender();
-	m_postProcess.render();
-
-	sendDatasToGPU(m_UICamera);
-	glClear(GL_DEPTH_BUFFER_BIT);
+	packet.hudCamera = CameraSnapshot(m_UICamera);
 
-	//	Draw each sprite
+	//	Gather each sprite
 	for (auto& _sprite : m_spriteList)
 	{
 		GameObject* obj = nullptr;
@@ -167,11 +220,135 @@ void Core::RendererManager::draw()
 			continue;
 		}
 
-		if (_sprite.second->isActive()) _sprite.second->draw();
+		if (_sprite.second->isActive()) _sprite.second->gatherHUD(packet.hudQuads);
 	}
-	glDisable(GL_DEPTH_TEST);
 
-	TextRender::instance()->RenderTextBuffer();
+	TextRender::instance()->TakeTextBuffer(packet.texts);
+
+	for (const TextRender::TextParameter& text : packet.texts) packet.stats.glyphs += (int)strlen(text.text);
+}
+
+void Core::RendererManager::render(FramePacket& packet)
+{
+	PROFILE_SCOPE("Renderer");
+	MEMORY_TAG(RENDERER);
+
+	GLState* _glState = GLState::instance();
+
+	QuadBatcher::instance()->resetStats();
+	GpuRingBuffer::resetFrameStats();
+	_glState->resetStats();
+
+	//	Swap in the shader variants compiled since the last frame
+	Resources::Shader::resolvePending(false);
+
+	//	Scene scale from the GPU time of the last read frame
+	float renderScale = m_dynamicResolution.update(GpuProfiler::instance()->getLastMs("Frame"));
+
+	if (packet.hasCamera)
+	{
+		//	Cluster the lights seen by the camera, the models index them directly when they're picked per object
+		m_lightClusters.build(packet.camera, packet.lights, !packet.objectLights);
+
+		//	Send datas to GPU before Drawing
+		sendDatasToGPU(packet.camera, renderScale);
+	}
+
+	//	The passes draw the packet of the frame, they don't hold it
+	m_renderedPacket = &packet;
+
+	//	Describe the frame only when it changed, the graph culls what doesn't reach the screen.
+	//	Steady frames run the compiled graph as it is, without allocating
+	Core::Window* _window = Core::Window::instance();
+	int postProcess = m_postProcess.getPassesKey();
+
+	if (renderScale != m_graphScale || _window->m_width != m_graphWidth || _window->m_height != m_graphHeight || postProcess != m_graphPostProcess)
+	{
+		m_graphScale = renderScale;
+		m_graphWidth = _window->m_width;
+		m_graphHeight = _window->m_height;
+		m_graphPostProcess = postProcess;
+
+		m_renderGraph.reset();
+
+		RenderGraph::Resource sceneColor = m_renderGraph.createTexture("Scene color", GL_R11F_G11F_B10F, 0, renderScale);
+		RenderGraph::Resource brightColor = m_renderGraph.createTexture("Bright color", GL_R11F_G11F_B10F, 0, renderScale);
+		RenderGraph::Resource sceneDepth = m_renderGraph.createTexture("Scene depth", GL_DEPTH_COMPONENT24, 0, renderScale);
+
+		m_renderGraph.addPass("Scene", {}, { sceneColor, brightColor, sceneDepth }, [this]() { drawScene(*m_renderedPacket); });
+		m_postProcess.addPasses(m_renderGraph, sceneColor, brightColor, RenderGraph::BACKBUFFER, renderScale);
+		m_renderGraph.addPass("HUD", {}, { RenderGraph::BACKBUFFER }, [this]() { drawHUD(*m_renderedPacket); });
+
+		m_renderGraph.compile();
+	}
+
+	m_renderGraph.execute();
+}
+
+void Core::RendererManager::drawScene(FramePacket& packet)
+{
+	GLState* _glState = GLState::instance();
+
+	glClearColor(0, 0, 0, 0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	if (packet.hasCamera)
+	{
+		if (m_cubeMap)
+		{
+			GpuScope scope("Skybox");
+			m_cubeMap->draw();
+		}
+
+		_glState->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		_glState->enable(GL_BLEND);
+		_glState->enable(GL_DEPTH_TEST);
+
+		//	Draw the models, a multi draw per batch
+		{
+			GpuScope scope("Opaque");
+			packet.opaquePass.draw(m_storageRing, m_commandRing);
+		}
+
+		//	Draw the translucent quads back to front, particles and billboards interleaved
+		{
+			GpuScope scope("Translucent");
+			packet.translucentPass.draw();
+		}
+
+		_glState->disable(GL_BLEND);
+	}
+}
+
+void Core::RendererManager::drawHUD(const FramePacket& packet)
+{
+	GLState* _glState = GLState::instance();
+
+	sendDatasToGPU(packet.hudCamera);
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	//	Batch each sprite
+	_glState->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	_glState->enable(GL_BLEND);
+
+	QuadBatcher* _batcher = QuadBatcher::instance();
+
+	{
+		GpuScope scope("Sprites");
+
+		for (const QuadItem& quad : packet.hudQuads)
+		{
+			_batcher->submit(quad);
+		}
+
+		_batcher->flush();
+	}
+
+	_glState->disable(GL_BLEND);
+	_glState->disable(GL_DEPTH_TEST);
+
+	GpuScope scope("Text");
+	TextRender::instance()->RenderTexts(packet.texts);
 }
 
 
@@ -219,4 +396,79 @@ void Core::RendererManager::showImGUIRendererManager()
 	{
 		m_postProcess.showImGui();
 	}
+
+	if (ImGui::CollapsingHeader("Resolution", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		m_dynamicResolution.showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Render Thread"))
+	{
+		Core::RenderThread::instance()->showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Render Stats"))
+	{
+		RenderStats::instance()->showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("GPU Profiler"))
+	{
+		GpuProfiler::instance()->showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Render Graph"))
+	{
+		m_renderGraph.showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Light Clusters"))
+	{
+		ImGui::Checkbox("Per object lights", &m_objectLights);
+
+		if (m_objectLights)
+		{
+			ImGui::Text("Selection : %d lights, %.2f m cells", (int)m_lightSelector.getLightCount(), m_lightSelector.getCellSize());
+			ImGui::Text("Scored : %.2f lights per model", m_lightSelector.getScoredPerQuery());
+		}
+
+		m_lightClusters.showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Opaque Pass"))
+	{
+		if (m_packet) m_packet->opaquePass.showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Translucency"))
+	{
+		if (m_packet) m_packet->translucentPass.showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Quad Batching"))
+	{
+		QuadBatcher::instance()->showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("GL State"))
+	{
+		GLState::instance()->showImGui();
+	}
+
+	if (ImGui::CollapsingHeader("Shader Variants"))
+	{
+		Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
+
+		ImGui::Text("Variants built : %d", (int)Resources::Shader::getVariantCount());
+		for (auto& curr_shader : resources->m_shaderName_shader)
+		{
+			if (curr_shader.second.m_featureMask == 0) continue;
+			ImGui::Text("%s : %d", curr_shader.first.c_str(), (int)curr_shader.second.getVariants().size() + 1);
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Streaming"))
+	{
+		GpuRingBuffer::showImGui();
+	}
 }
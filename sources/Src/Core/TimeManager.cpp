@@ -14,6 +14,15 @@ void TimeManager::setDeltaTime()
 	deltaTime = deltaTimeUnscaled * timeScale;
 }
 
+void TimeManager::setDeltaTime(float fixedDelta)
+{
+	newTime = oldTime + fixedDelta;
+	deltaTimeUnscaled = fixedDelta;
+	oldTime = newTime;
+
+	deltaTime = deltaTimeUnscaled * timeScale;
+}
+
 void TimeManager::setFixedDeltaTime()
 {
 	timeStock += deltaTime;
@@ -2,15 +2,37 @@
 #include <GLFW/glfw3.h>
 #include <Core/Window.hpp>
 #include <Core/Log.hpp>
+#include <LowRenderer/RenderDevice.hpp>
 #include <Config.hpp>
 
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 
+bool Core::Window::s_headless = false;
+
 Core::Window::Window()
 {
 	Core::Log* _log = Core::Log::instance();
 
+	m_width = SCR_WIDTH;
+	m_height = SCR_HEIGHT;
+
+	m_widthf = (float)SCR_WIDTH;
+	m_heightf = (float)SCR_HEIGHT;
+
+	m_windowCoef = (float)m_height / (float)m_width;
+
+	//	No GLFW at all, the GL calls go to the null device
+	if (s_headless)
+	{
+		_log->write("Headless : loading the null render device");
+
+		if (!RenderDevice::create(true)->load())
+			_log->writeFailure("Failed to load the null render device");
+
+		return;
+	}
+
 	//	GLFW: initialize and configure
 
 	glfwInit();
@@ -20,14 +42,6 @@ Core::Window::Window()
 
 	_log->write("Creating GLFW Window");
 
-	m_width = SCR_WIDTH;
-	m_height = SCR_HEIGHT;
-
-	m_widthf = (float)SCR_WIDTH;
-	m_heightf = (float)SCR_HEIGHT;
-
-	m_windowCoef = (float)m_height / (float)m_width;
-
 	//	GLFW window creation
 	m_window = glfwCreateWindow(m_width, m_height, "FPS - OpenGL", NULL, NULL);
 
@@ -43,7 +57,7 @@ Core::Window::Window()
 
 	// glad: load all OpenGL function pointers
 
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	if (!RenderDevice::create(false)->load())
 	{
 		_log->writeFailure("Failed to initialize GLAD");
 		return;
@@ -53,6 +67,8 @@ Core::Window::Window()
 
 void Core::Window::update()
 {
+	if (!m_window) return;
+
 	int oldW = m_width;
 	int oldH = m_height;
 
@@ -74,5 +90,6 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	// make sure the viewport matches the new window dimensions; note that width and 
 	// height will be significantly larger than specified on retina displays.
-	glViewport(0, 0, width, height);
+	// The render thread may hold the context, its passes set their own viewport.
+	if (glfwGetCurrentContext() == window) glViewport(0, 0, width, height);
 }
@@ -3,6 +3,7 @@
 #include <Engine/GameObject.hpp>
 
 #include <Core/Log.hpp>
+#include <Core/ObjectPool.hpp>
 
 #include <Physics/Collider3.hpp>
 
@@ -44,9 +45,7 @@ ComponentTypeInfo::ComponentTypeInfo()
 
 Component::~Component()
 {
-	//	Log writing
-	Core::Log* _log = Core::Log::instance();
-	_log->write("-\t\tDestroying Component " + m_name);
+
 }
 
 Component::Component(GameObject* in_gameObject)
@@ -91,6 +90,9 @@ bool Component::isActive() const
 
 void Component::destroy()
 {
+	//	Out of the type table of the gameObject and of the scene arrays
+	m_gameObject->unregisterComponent(this);
+
 	//	Get last index (trash index)
 	int lastComp = (int)m_gameObject->m_componentList.size() - 1;
 
@@ -100,11 +102,30 @@ void Component::destroy()
 
 
 	//	Delete last component
-	m_gameObject->m_componentList[lastComp] = nullptr;
-	m_gameObject->m_componentList.erase(lastComp);
+	m_gameObject->m_componentList.pop_back();
+
+	//	Log writing
+	Core::Log* _log = Core::Log::instance();
+	_log->write("-\t\tDestroying Component " + m_name);
 
 	//	Delete self
-	delete this;
+	release();
+}
+
+void Component::release()
+{
+	if (!m_pool)
+	{
+		delete this;
+		return;
+	}
+
+	//	Start of the whole component, the slot of the pool
+	Core::PoolBase* pool = m_pool;
+	void* memory = dynamic_cast<void*>(this);
+
+	this->~Component();
+	pool->release(memory);
 }
 
 
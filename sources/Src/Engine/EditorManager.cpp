@@ -2,6 +2,12 @@
 
 
 #include <Core/Graph.hpp>
+#include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/FrameArena.hpp>
+#include <Core/ObjectPool.hpp>
+#include <Core/JobSystem.hpp>
 
 namespace Core
 {
@@ -84,12 +90,16 @@ namespace Core
 
 	void EditorManager::updateEditorWindows()
 	{
+		PROFILE_SCOPE("Editor");
+
 		if (ImGui::Begin("Parameters"))
 		{
 			if (ImGui::SliderFloat4("Theme", &m_themeColor.x, 0.f, 1.f))
 			{
 				resetTheme();
 			}
+
+			Core::Log::instance()->showImGui();
 		}
 		ImGui::End();
 
@@ -112,6 +122,23 @@ namespace Core
 		}
 		ImGui::End();
 
+		if (ImGui::Begin("Profiler"))
+		{
+			Core::Profiler::instance()->showImGui();
+
+			if (ImGui::CollapsingHeader("Jobs")) Core::JobSystem::instance()->showImGui();
+		}
+		ImGui::End();
+
+		if (ImGui::Begin("Memory"))
+		{
+			Core::MemoryTracker::showImGui();
+			Core::FrameArena::get().showImGui();
+
+			if (ImGui::CollapsingHeader("Object pools")) Core::PoolBase::showImGui();
+		}
+		ImGui::End();
+
 		m_graph->showImGUIResourcesManager();
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <Engine/Transform3.hpp>
 
 #include <Core/Log.hpp>
+#include <Core/ObjectPool.hpp>
 
 #include <LowRenderer/Model.hpp>
 #include <LowRenderer/Light.hpp>
@@ -32,31 +33,114 @@ using namespace Physics;
 #include <typeinfo>
 
 
+//	Every component class, addComponentOfType finds them by their ComponentType
+//	---------------------------------------------------------------------------
+
+template<typename... C>
+struct ComponentTypeList {};
+
+typedef ComponentTypeList<Transform3, Model, Camera, Light, Sprite, ParticleSystem, SpriteBillboard,
+	Rigidbody3, SphereCollider3D, BoxCollider3D, BoxCollider2D, Weapon, Player, Enemy, Button, PauseMenu> ComponentTypes;
+
+typedef Component* (*AddComponentFunction)(GameObject&);
+
+struct ComponentRegistry
+{
+	AddComponentFunction add[(int)ComponentType::COUNT] = {};
+};
+
+template<typename C>
+static Component* addComponentOf(GameObject& gameObject)
+{
+	return gameObject.addComponent<C>();
+}
+
+template<typename... C>
+static ComponentRegistry makeComponentRegistry(ComponentTypeList<C...>)
+{
+	ComponentRegistry registry;
+
+	int unused[] = { 0, (registry.add[ComponentId<C>::type] = &addComponentOf<C>, 0)... };
+	(void)unused;
+
+	return registry;
+}
+
+static const ComponentRegistry s_componentRegistry = makeComponentRegistry(ComponentTypes());
+
+
 GameObject::GameObject()
 {
-	addComponent<Transform3>();
 	m_sceneReference = nullptr;
+	addComponent<Transform3>();
 }
 
 GameObject::GameObject(Resources::Scene* in_sceneReference)
 {
-	addComponent<Transform3>();
+	//	Set first, the transform goes in the arrays of the scene
 	m_sceneReference = in_sceneReference;
-
 	m_key = (int)m_sceneReference->m_objectList.size();
+
+	addComponent<Transform3>();
 }
 
 GameObject::~GameObject()
 {
-	Core::Log* _log = Core::Log::instance();
-	_log->write("-\t Destroying Object : " + m_name);
+	//	Components left are released without their destroy() : only the unload of the scene
+	//	gets here with components, the renderer lists they are in go with the scene
+	for (Component* comp : m_componentList)
+	{
+		if (m_sceneReference) m_sceneReference->removeComponent(comp);
+		comp->release();
+	}
+	m_componentList.clear();
+}
 
-	while (m_componentList.empty() == false)
+void GameObject::registerComponent(Component* component)
+{
+	if (component->m_type < 0) return;
+
+	ComponentMask bit = 1u << component->m_type;
+	if ((m_componentMask & bit) == 0)
 	{
-		m_componentList[0]->destroy();
+		m_componentMask |= bit;
+		m_componentTable[component->m_type] = component;
 	}
 
-	_log->breakLine();
+	if (m_sceneReference) m_sceneReference->addComponent(component);
+}
+
+void GameObject::unregisterComponent(Component* component)
+{
+	if (component->m_type < 0) return;
+
+	if (m_sceneReference) m_sceneReference->removeComponent(component);
+
+	if (m_componentTable[component->m_type] != component) return;
+
+	//	Next component of the same type takes its place, if any
+	m_componentMask &= ~(1u << component->m_type);
+	m_componentTable[component->m_type] = nullptr;
+
+	for (Component* comp : m_componentList)
+	{
+		if (comp != component && comp->m_type == component->m_type)
+		{
+			m_componentMask |= 1u << comp->m_type;
+			m_componentTable[comp->m_type] = comp;
+			break;
+		}
+	}
+}
+
+void* GameObject::operator new(size_t size)
+{
+	return Core::ObjectPool<GameObject>::get().allocate();
+}
+
+void GameObject::operator delete(void* pointer)
+{
+	Core::ObjectPool<GameObject>::get().release(pointer);
 }
 
 bool GameObject::isActive()
@@ -71,32 +155,37 @@ bool GameObject::isActive()
 
 void GameObject::birth()
 {
-	for (auto comp : m_componentList)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		comp.second->birth();
+		m_componentList[i]->birth();
 	}
 }
 
 void GameObject::awake()
 {
-	for (auto comp : m_componentList)
+	//	By index, awake can add components (requireComponent)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		if (comp.second->isActive() && !comp.second->m_hasAwaken)
+		Component* comp = m_componentList[i];
+
+		if (comp->isActive() && !comp->m_hasAwaken)
 		{
-			comp.second->awake();
-			comp.second->m_hasAwaken = true;
+			comp->awake();
+			comp->m_hasAwaken = true;
 		}
 	}
 }
 
 void GameObject::start()
 {
-	for (auto comp : m_componentList)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		if (comp.second->isActive() && !comp.second->m_hasStarted)
+		Component* comp = m_componentList[i];
+
+		if (comp->isActive() && !comp->m_hasStarted)
 		{
-			comp.second->start();
-			comp.second->m_hasStarted = true;
+			comp->start();
+			comp->m_hasStarted = true;
 		}
 	}
 }
@@ -104,11 +193,13 @@ void GameObject::start()
 
 void GameObject::update()
 {
-	for (auto comp : m_componentList)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		if (comp.second->isActive())
+		Component* comp = m_componentList[i];
+
+		if (comp->isActive())
 		{
-			comp.second->update();
+			comp->update();
 		}
 	}
 }
@@ -116,22 +207,26 @@ void GameObject::update()
 
 void GameObject::fixedUpdate()
 {
-	for (auto comp : m_componentList)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		if (comp.second->isActive())
+		Component* comp = m_componentList[i];
+
+		if (comp->isActive())
 		{
-			comp.second->fixedUpdate();
+			comp->fixedUpdate();
 		}
 	}
 }
 
 void GameObject::lateUpdate()
 {
-	for (auto comp : m_componentList)
+	for (size_t i = 0; i < m_componentList.size(); i++)
 	{
-		if (comp.second->isActive())
+		Component* comp = m_componentList[i];
+
+		if (comp->isActive())
 		{
-			comp.second->lateUpdate();
+			comp->lateUpdate();
 		}
 	}
 }
@@ -139,6 +234,8 @@ void GameObject::lateUpdate()
 
 void GameObject::destroy()
 {
+	Core::Log* _log = Core::Log::instance();
+	_log->write("-\t Destroying Object : " + m_name);
 
 	//	Get last index (trash index)
 	int lastComp = (int)m_sceneReference->m_objectList.size() - 1;
@@ -151,6 +248,12 @@ void GameObject::destroy()
 	m_sceneReference->m_objectList[lastComp] = nullptr;
 	m_sceneReference->m_objectList.erase(lastComp);
 
+	//	Each component takes itself out of the renderer lists (Model::destroy, Light::destroy...)
+	while (m_componentList.empty() == false)
+	{
+		m_componentList.back()->destroy();
+	}
+
 	//	Delete self
 	delete this;
 }
@@ -158,50 +261,12 @@ void GameObject::destroy()
 
 bool GameObject::HasUniqueComponentOfType(const int i)
 {
-	int k;	//	unused
-
-	switch (i)
-	{
-	case (int)ComponentType::Transform:			return tryGetComponentIndex<Transform3>(k);
-	case (int)ComponentType::Model:				return tryGetComponentIndex<Model>(k);
-	case (int)ComponentType::Camera:			return tryGetComponentIndex<Camera>(k);
-	case (int)ComponentType::Light:				return tryGetComponentIndex<Light>(k);
-	case (int)ComponentType::RigidBody:			return tryGetComponentIndex<Rigidbody3>(k);
-	case (int)ComponentType::SphereCollider3D:	return tryGetComponentIndex<SphereCollider3D>(k);
-	case (int)ComponentType::BoxCollider3D:		return tryGetComponentIndex<BoxCollider3D>(k);
-	case (int)ComponentType::BoxCollider2D:		return tryGetComponentIndex<BoxCollider2D>(k);
-	case (int)ComponentType::Sprite:			return tryGetComponentIndex<Sprite>(k);
-	case (int)ComponentType::Player:			return tryGetComponentIndex<Player>(k);
-	case (int)ComponentType::Enemy:				return tryGetComponentIndex<Player>(k);
-	case (int)ComponentType::Weapon:			return tryGetComponentIndex<Weapon>(k);
-	case (int)ComponentType::Button:			return tryGetComponentIndex<Button>(k);
-	case (int)ComponentType::PauseMenu:			return tryGetComponentIndex<PauseMenu>(k);
-	default: return false;
-	}
+	return (m_componentMask & (1u << i)) != 0;
 }
 
 void GameObject::addComponentOfType(const int i)
 {
-	switch (i)
-	{
-		case (int)ComponentType::Transform:			addComponent<Transform3>();			break;
-		case (int)ComponentType::Model:				addComponent<Model>();				break;
-		case (int)ComponentType::Camera:			addComponent<Camera>();				break;
-		case (int)ComponentType::Light:				addComponent<Light>();				break;
-		case (int)ComponentType::ParticleSystem:	addComponent<ParticleSystem>();		break;
-		case (int)ComponentType::SpriteBillboard:	addComponent<SpriteBillboard>();	break;
-		case (int)ComponentType::RigidBody:			addComponent<Rigidbody3>();			break;
-		case (int)ComponentType::SphereCollider3D:	addComponent<SphereCollider3D>();	break;
-		case (int)ComponentType::BoxCollider3D:		addComponent<BoxCollider3D>();		break;
-		case (int)ComponentType::BoxCollider2D:		addComponent<BoxCollider2D>();		break;
-		case (int)ComponentType::Sprite:			addComponent<Sprite>();				break;
-		case (int)ComponentType::Player:			addComponent<Player>();				break;
-		case (int)ComponentType::Enemy:				addComponent<Enemy>();				break;
-		case (int)ComponentType::Weapon:			addComponent<Weapon>();				break;
-		case (int)ComponentType::Button:			addComponent<Button>();				break;
-		case (int)ComponentType::PauseMenu:			addComponent<PauseMenu>();			break;
-		default: break;
-	}
+	if (i >= 0 && i < (int)ComponentType::COUNT && s_componentRegistry.add[i]) s_componentRegistry.add[i](*this);
 }
 
 
@@ -213,8 +278,6 @@ void GameObject::addComponentOfType(const int i)
 
 void GameObject::loadOBJModelFromStringStream(std::istringstream& lineStream)
 {
-	Core::Log* _log = Core::Log::instance();
-
 	std::string directory;
 	std::string file;
 	FileParser::separatePathAndName(directory, file, lineStream);
@@ -229,7 +292,7 @@ void GameObject::loadOBJModelFromStringStream(std::istringstream& lineStream)
 
 	//	Load file if not loaded yet
 
-	_log->write("+\t Adding Model to new gameObject");
+	LOG_INFO(LOADING, "+\t Adding Model to new gameObject");
 
 	if (resources->loadOBJ(directory, file) == false) return;
 
@@ -264,8 +327,6 @@ void GameObject::loadOBJModelFromStringStream(std::istringstream& lineStream)
 
 void GameObject::loadSingleModelFromStringStream(std::istringstream& lineStream)
 {
-	Core::Log* _log = Core::Log::instance();
-
 	std::string directory;
 	std::string file;
 
@@ -287,7 +348,7 @@ void GameObject::loadSingleModelFromStringStream(std::istringstream& lineStream)
 
 	//	Load file if not loaded yet
 
-	_log->write("+\t Adding Model to new gameObject");
+	LOG_INFO(LOADING, "+\t Adding Model to new gameObject");
 
 	if (resources->loadOBJ(directory, file) == false) return;
 
@@ -373,8 +434,6 @@ void GameObject::loadFromScnFile(std::ifstream& file, Resources::Scene& sceneRef
 
 void loadGameObject(std::ifstream& file, std::istringstream& lineStream, Resources::Scene& sceneReference)
 {
-	Core::Log* _log = Core::Log::instance();
-
 	//	GameObject out;
 	int i = (int)sceneReference.m_objectList.size();
 	GameObject* go = sceneReference.m_objectList[i] = new GameObject(&sceneReference);
@@ -384,7 +443,7 @@ void loadGameObject(std::ifstream& file, std::istringstream& lineStream, Resourc
 	go->m_isEnabled = FileParser::getBool(lineStream);
 	go->m_isStatic = FileParser::getBool(lineStream);
 	go->m_layer = LayerDatas::instance()->m_layerList[FileParser::getString(lineStream)];
-	_log->write("+ Loading Game Object \"" + go->m_name + "\"");
+	LOG_INFO(LOADING, "+ Loading Game Object \"" + go->m_name + "\"");
 
 	go->loadFromScnFile(file, sceneReference);
 }
@@ -442,23 +501,21 @@ void GameObject::showImGUIGameObject()
 
 	ImGui::Text("Components : ");
 
-	int id = 0;
-	int lastComp = (int)m_componentList.size() - 1;
+	size_t componentCount = m_componentList.size();
 
-	for (auto comp : m_componentList)
+	for (size_t id = 0; id < m_componentList.size(); id++)
 	{
 		ImGui::PushID(("Component" + std::to_string(id)).c_str());
-		Component* c = comp.second;
+		Component* c = m_componentList[id];
 		c->showImGUIComponent();
 
 		ImGui::PopID();
 
-		if(m_componentList.find(lastComp) == m_componentList.end())
+		//	A component was removed, the list moved
+		if (m_componentList.size() != componentCount)
 		{
 			break;
 		}
-
-		id++;
 	}
 
 	const char* componentPreview = "none";
@@ -111,7 +111,7 @@ void Transform3::birth()
 
 			found = true;
 
-			_log->write("+\t Transform parent found");
+			LOG_INFO(LOADING, "+\t Transform parent found");
 
 			break;
 		}
@@ -317,8 +317,7 @@ void Transform3::saveComponentInSCNFile(std::ofstream& file)
 
 void Transform3::loadComponentFromSCNFile(std::istringstream& lineStream)
 {
-	Core::Log* _log = Core::Log::instance();
-	_log->write("+\t Adding transform data to new gameObject");
+	LOG_INFO(LOADING, "+\t Adding transform data to new gameObject");
 
 	//	Set Rotation Coordinate
 	m_position = FileParser::getVector3(lineStream);
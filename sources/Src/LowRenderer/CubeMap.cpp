@@ -1,4 +1,6 @@
 #include <LowRenderer/CubeMap.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/RenderStats.hpp>
 #include <Resources/ResourcesManager.hpp>
 #include <Utils/File.h>
 #include <Utils/StringExtractor.h>
@@ -76,7 +78,7 @@ void LowRenderer::CubeMap::initRenderData()
     glGenBuffers(1, &VBO);
 
     //	Define VBO and VAO
-    glBindVertexArray(VAO);
+    GLState::instance()->bindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
     //	Attach VBO to VAO
@@ -87,7 +89,7 @@ void LowRenderer::CubeMap::initRenderData()
     glEnableVertexAttribArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::instance()->bindVertexArray(0);
 }
 
 
@@ -95,16 +97,17 @@ void LowRenderer::CubeMap::draw()
 {
     if (m_shader && m_texture)
     {
-        glDepthMask(GL_FALSE);
-        m_shader->use();
+        GLState* _glState = GLState::instance();
 
-        glBindVertexArray(VAO);
+        _glState->depthMask(false);
+        m_shader->use();
 
-        glActiveTexture(0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture->getID());
+        _glState->bindVertexArray(VAO);
+        _glState->bindTexture(GL_TEXTURE_CUBE_MAP, m_texture->getID(), 0);
 
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glDepthMask(GL_TRUE);
+        RenderStats::instance()->addDraw(1, 12);
+        _glState->depthMask(true);
 
     }
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <LowRenderer/DynamicResolution.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+#include <imgui.h>
+
+#define SCALE_STEP		0.05f	// Scales are multiples of it, the render target pool sees few sizes
+#define SMOOTHING		0.2f	// Weight of the new frame in the smoothed time
+#define COOLDOWN_FRAMES	15		// Frames measured at the new scale before the next change
+
+#define DOWN_THRESHOLD	1.05f	// Scale drops over target * DOWN_THRESHOLD
+#define UP_THRESHOLD	0.80f	// and climbs under target * UP_THRESHOLD
+
+
+float DynamicResolution::update(float gpuFrameMs)
+{
+	if (!m_enabled)
+	{
+		m_scale = 1.f;
+		m_smoothedMs = 0.f;
+		m_cooldown = 0;
+		return m_scale;
+	}
+
+	if (gpuFrameMs <= 0.f) return m_scale;
+
+	m_smoothedMs = m_smoothedMs > 0.f ? m_smoothedMs + (gpuFrameMs - m_smoothedMs) * SMOOTHING : gpuFrameMs;
+
+	if (m_cooldown > 0)
+	{
+		m_cooldown--;
+		return m_scale;
+	}
+
+	float minScale = std::min(std::max(m_minScale, SCALE_STEP), 1.f);
+	float scale = m_scale;
+
+	if (m_smoothedMs > m_targetMs * DOWN_THRESHOLD)
+	{
+		//	The scene cost follows its pixel count, jump to the scale meeting the target
+		float wanted = m_scale * sqrtf(m_targetMs / m_smoothedMs);
+		scale = std::min(floorf(wanted / SCALE_STEP) * SCALE_STEP, m_scale - SCALE_STEP);
+	}
+	else if (m_smoothedMs < m_targetMs * UP_THRESHOLD)
+	{
+		//	A step adds at most 21% of pixels (0.5 -> 0.55), UP_THRESHOLD * 1.21 stays under DOWN_THRESHOLD
+		scale = m_scale + SCALE_STEP;
+	}
+
+	scale = std::min(std::max(scale, minScale), 1.f);
+
+	if (fabsf(scale - m_scale) > SCALE_STEP * 0.5f)
+	{
+		m_scale = scale;
+		m_cooldown = COOLDOWN_FRAMES;
+		m_changes++;
+	}
+
+	return m_scale;
+}
+
+void DynamicResolution::showImGui()
+{
+	ImGui::Checkbox("Dynamic resolution", &m_enabled);
+
+	if (m_enabled)
+	{
+		ImGui::SliderFloat("Target GPU frame (ms)", &m_targetMs, 2.f, 33.3f);
+		ImGui::SliderFloat("Minimum scale", &m_minScale, SCALE_STEP, 1.f);
+	}
+
+	ImGui::Text("Render scale : %d%% (GPU frame %.2f ms, %d changes)", (int)roundf(m_scale * 100.f), m_smoothedMs, (int)m_changes);
+}
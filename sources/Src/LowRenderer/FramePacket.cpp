@@ -0,0 +1,65 @@
+#include <LowRenderer/FramePacket.hpp>
+
+
+CameraSnapshot::CameraSnapshot(const CameraBase& camera) : CameraBase(camera)
+{
+	m_view = camera.getViewMatrix();
+	m_position = camera.getPosition();
+}
+
+
+FramePacket::~FramePacket()
+{
+	freeImGui();
+}
+
+void FramePacket::clear()
+{
+	renderer = nullptr;
+	hasCamera = false;
+
+	lights.clear();
+	objectLights = false;
+	opaquePass.begin();
+	translucentPass.begin(Maths::mat4x4Identity());
+	hudQuads.clear();
+	texts.clear();
+
+	imguiData = nullptr;
+	freeImGui();
+
+	stats = FrameStats();
+
+	renderMs = 0.0;
+	swapMs = 0.0;
+}
+
+void FramePacket::copyImGui(const ImDrawData* source)
+{
+	freeImGui();
+
+	imguiData = nullptr;
+	if (!source || !source->Valid) return;
+
+	for (int i = 0; i < source->CmdListsCount; i++)
+	{
+		m_imguiLists.push_back(source->CmdLists[i]->CloneOutput());
+	}
+
+	m_imguiCopy = *source;
+	m_imguiCopy.CmdLists = m_imguiLists.Data;
+	m_imguiCopy.OwnerViewport = nullptr;
+
+	imguiData = &m_imguiCopy;
+}
+
+void FramePacket::freeImGui()
+{
+	for (ImDrawList* list : m_imguiLists)
+	{
+		IM_DELETE(list);
+	}
+	m_imguiLists.resize(0);
+
+	m_imguiCopy.Clear();
+}
@@ -0,0 +1,136 @@
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/RenderStats.hpp>
+
+#include <imgui.h>
+
+
+bool GLState::changed(bool isDifferent)
+{
+	if (isDifferent)	m_issuedCount++;
+	else				m_filteredCount++;
+
+	return isDifferent;
+}
+
+GLuint* GLState::textureSlot(GLenum target, GLuint unit)
+{
+	if (unit >= TEXTURE_UNITS) return nullptr;
+
+	if (target == GL_TEXTURE_2D)		return &m_textures2D[unit];
+	if (target == GL_TEXTURE_CUBE_MAP)	return &m_texturesCubeMap[unit];
+
+	return nullptr;
+}
+
+void GLState::useProgram(GLuint program)
+{
+	if (!changed(program != m_program)) return;
+
+	glUseProgram(program);
+	m_program = program;
+
+	RenderStats::instance()->addShaderBind();
+}
+
+void GLState::bindVertexArray(GLuint vertexArray)
+{
+	if (!changed(vertexArray != m_vertexArray)) return;
+
+	glBindVertexArray(vertexArray);
+	m_vertexArray = vertexArray;
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture, GLuint unit)
+{
+	GLuint* slot = textureSlot(target, unit);
+
+	//	Nothing to do if the unit already holds it, whichever unit is active
+	if (slot && !changed(*slot != texture)) return;
+
+	if (unit != m_activeUnit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		m_activeUnit = unit;
+	}
+
+	glBindTexture(target, texture);
+	if (slot) *slot = texture;
+
+	RenderStats::instance()->addTextureBind();
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture)
+{
+	bindTexture(target, texture, m_activeUnit);
+}
+
+void GLState::bindFramebuffer(GLuint framebuffer)
+{
+	if (!changed(framebuffer != m_framebuffer)) return;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	m_framebuffer = framebuffer;
+}
+
+void GLState::setEnabled(GLenum capability, bool enabled)
+{
+	int index = -1;
+	/**/ if (capability == GL_BLEND)		index = BLEND;
+	else if (capability == GL_DEPTH_TEST)	index = DEPTH_TEST;
+	else if (capability == GL_CULL_FACE)	index = CULL_FACE;
+
+	if (index >= 0 && !changed(m_capabilities[index] != (int)enabled)) return;
+
+	if (enabled)	glEnable(capability);
+	else			glDisable(capability);
+
+	if (index >= 0) m_capabilities[index] = (int)enabled;
+}
+
+void GLState::blendFunc(GLenum source, GLenum destination)
+{
+	if (!changed(source != m_blendSource || destination != m_blendDestination)) return;
+
+	glBlendFunc(source, destination);
+	m_blendSource = source;
+	m_blendDestination = destination;
+}
+
+void GLState::depthMask(bool write)
+{
+	if (!changed(write != m_depthWrite)) return;
+
+	glDepthMask(write ? GL_TRUE : GL_FALSE);
+	m_depthWrite = write;
+}
+
+void GLState::forgetVertexArray(GLuint vertexArray)
+{
+	if (m_vertexArray == vertexArray) m_vertexArray = 0;
+}
+
+void GLState::forgetTexture(GLuint texture)
+{
+	for (int unit = 0; unit < TEXTURE_UNITS; unit++)
+	{
+		if (m_textures2D[unit] == texture)		m_textures2D[unit] = 0;
+		if (m_texturesCubeMap[unit] == texture)	m_texturesCubeMap[unit] = 0;
+	}
+}
+
+void GLState::forgetFramebuffer(GLuint framebuffer)
+{
+	if (m_framebuffer == framebuffer) m_framebuffer = 0;
+}
+
+void GLState::resetStats()
+{
+	m_issuedCount = 0;
+	m_filteredCount = 0;
+}
+
+void GLState::showImGui()
+{
+	ImGui::Text("State calls issued : %d", m_issuedCount);
+	ImGui::Text("Redundant calls skipped : %d", m_filteredCount);
+}
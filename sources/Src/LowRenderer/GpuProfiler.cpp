@@ -0,0 +1,297 @@
+#include <LowRenderer/GpuProfiler.hpp>
+
+#include <Config.hpp>
+#include <Core/Profiler.hpp>
+
+#include <imgui.h>
+
+#include <chrono>
+#include <algorithm>
+
+#define QUERY_CHUNK 64			// Queries created at once when a frame runs out
+#define TIMELINE_ROW 18.f		// Height of a depth of the timeline, in pixels
+
+
+static double getCpuUs()
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+GpuProfiler::~GpuProfiler()
+{
+	for (Frame& frame : m_frames)
+	{
+		if (!frame.queries.empty()) glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+	}
+}
+
+int GpuProfiler::getNameId(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto found = m_nameIds.find(name);
+	if (found != m_nameIds.end()) return found->second;
+
+	int id = (int)m_names.size();
+	m_names.push_back(name);
+	m_stats.emplace_back();
+	m_nameIds[name] = id;
+
+	return id;
+}
+
+void GpuProfiler::beginFrame()
+{
+	Frame& frame = m_frames[m_frameIndex];
+
+	//	Written FRAMES frames ago, its queries are about to be reused
+	if (frame.pending) readFrame(frame);
+
+	frame.usedQueries = 0;
+	frame.scopes.clear();
+	frame.pending = false;
+
+	glGetInteger64v(GL_TIMESTAMP, &frame.gpuReference);
+	frame.cpuReference = getCpuUs();
+
+	m_inFrame = true;
+	m_openScopes.clear();
+	m_frameScope = beginScope("Frame");
+}
+
+void GpuProfiler::endFrame()
+{
+	if (!m_inFrame) return;
+
+	//	Scopes left open end with the frame
+	while (!m_openScopes.empty()) endScope(m_openScopes.back());
+
+	m_inFrame = false;
+	m_frames[m_frameIndex].pending = true;
+	m_frameIndex = (m_frameIndex + 1) % FRAMES;
+}
+
+int GpuProfiler::beginScope(const std::string& name)
+{
+	if (!m_inFrame) return -1;
+
+	Frame& frame = m_frames[m_frameIndex];
+
+	if (frame.usedQueries + 2 > frame.queries.size())
+	{
+		size_t first = frame.queries.size();
+		frame.queries.resize(first + QUERY_CHUNK);
+		glGenQueries(QUERY_CHUNK, &frame.queries[first]);
+	}
+
+	ScopeRecord scope;
+	scope.name = getNameId(name);
+	scope.depth = (int)m_openScopes.size();
+	scope.query = frame.usedQueries;
+	frame.usedQueries += 2;
+
+	glQueryCounter(frame.queries[scope.query], GL_TIMESTAMP);
+
+	int index = (int)frame.scopes.size();
+	frame.scopes.push_back(scope);
+	m_openScopes.push_back(index);
+
+	return index;
+}
+
+void GpuProfiler::endScope(int scope)
+{
+	if (!m_inFrame || scope < 0 || m_openScopes.empty() || m_openScopes.back() != scope) return;
+
+	Frame& frame = m_frames[m_frameIndex];
+	glQueryCounter(frame.queries[frame.scopes[scope].query + 1], GL_TIMESTAMP);
+
+	m_openScopes.pop_back();
+}
+
+void GpuProfiler::readFrame(Frame& frame)
+{
+	if (frame.scopes.empty()) return;
+
+	//	The frame scope ends last, the others are done when it is
+	GLint available = 0;
+	glGetQueryObjectiv(frame.queries[frame.scopes[0].query + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+	{
+		m_droppedFrames++;
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	//	Written in the next frame of the ring, the oldest one once it's full
+	TraceFrame& trace = m_trace[m_traceNext];
+	trace.count = (int)std::min(frame.scopes.size(), (size_t)FRAME_SCOPES);
+	m_droppedScopes += (unsigned int)(frame.scopes.size() - trace.count);
+
+	for (size_t i = 0; i < frame.scopes.size(); i++)
+	{
+		const ScopeRecord& scope = frame.scopes[i];
+
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(frame.queries[scope.query], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(frame.queries[scope.query + 1], GL_QUERY_RESULT, &end);
+
+		TraceEvent event;
+		event.name = scope.name;
+		event.depth = scope.depth;
+		event.startUs = frame.cpuReference + ((GLint64)begin - frame.gpuReference) / 1000.0;
+		event.durationUs = end > begin ? (end - begin) / 1000.0 : 0.0;
+
+		if ((int)i < trace.count) trace.events[i] = event;
+
+		//	Summed over the scopes of the name, its first scope of the frame resets it
+		ScopeStats& stats = m_stats[event.name];
+		if (stats.frameMs < 0.f) stats.frameMs = 0.f;
+		stats.frameMs += (float)(event.durationUs / 1000.0);
+	}
+
+	//	Rolling average over the frames the scope was in
+	for (const ScopeRecord& scope : frame.scopes)
+	{
+		ScopeStats& stats = m_stats[scope.name];
+		if (stats.frameMs < 0.f) continue;
+
+		if (stats.count == HISTORY) stats.sum -= stats.history[stats.next];
+		else stats.count++;
+
+		stats.history[stats.next] = stats.frameMs;
+		stats.sum += stats.frameMs;
+		stats.next = (stats.next + 1) % HISTORY;
+
+		//	Counted once per frame
+		stats.frameMs = -1.f;
+	}
+
+	m_traceNext = (m_traceNext + 1) % HISTORY;
+	m_traceCount = std::min(m_traceCount + 1, HISTORY);
+}
+
+float GpuProfiler::getAverageMs(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto found = m_nameIds.find(name);
+	if (found == m_nameIds.end()) return 0.f;
+
+	const ScopeStats& stats = m_stats[found->second];
+	return stats.count ? stats.sum / stats.count : 0.f;
+}
+
+float GpuProfiler::getLastMs(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto found = m_nameIds.find(name);
+	if (found == m_nameIds.end()) return 0.f;
+
+	const ScopeStats& stats = m_stats[found->second];
+	return stats.count ? stats.history[(stats.next + HISTORY - 1) % HISTORY] : 0.f;
+}
+
+void GpuProfiler::writeTraceEvents(std::ostream& out, bool& first)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	//	Oldest frame first
+	for (int f = 0; f < m_traceCount; f++)
+	{
+		const TraceFrame& trace = m_trace[(m_traceNext + HISTORY - m_traceCount + f) % HISTORY];
+
+		for (int i = 0; i < trace.count; i++)
+		{
+			const TraceEvent& event = trace.events[i];
+
+			char line[256];
+			snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"gpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":\"GPU\"}",
+				m_names[event.name].c_str(), event.startUs, event.durationUs);
+
+			out << (first ? "" : ",\n") << line;
+			first = false;
+		}
+	}
+}
+
+void GpuProfiler::showImGui()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	const TraceFrame& last = m_trace[(m_traceNext + HISTORY - 1) % HISTORY];
+	if (m_traceCount == 0 || last.count == 0)
+	{
+		ImGui::Text("No frame read yet");
+		return;
+	}
+
+	//	GPU frame time, oldest first
+	//	----------------------------
+
+	const ScopeStats& frameStats = m_stats[last.events[0].name];
+
+	char overlay[64];
+	snprintf(overlay, sizeof(overlay), "GPU frame : %.3f ms avg", frameStats.count ? frameStats.sum / frameStats.count : 0.f);
+
+	float maxMs = *std::max_element(frameStats.history, frameStats.history + HISTORY);
+	ImGui::PlotLines("##GPU frame", frameStats.history, HISTORY, frameStats.next, overlay, 0.f, maxMs * 1.2f, ImVec2(0.f, 60.f));
+
+	//	Timeline of the last read frame, a row per depth
+	//	------------------------------------------------
+
+	int depthCount = 1;
+	for (int i = 0; i < last.count; i++) depthCount = std::max(depthCount, last.events[i].depth + 1);
+
+	float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImGui::Dummy(ImVec2(width, depthCount * TIMELINE_ROW));
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	double frameStart = last.events[0].startUs;
+	double frameDuration = std::max(last.events[0].durationUs, 0.001);
+
+	for (int i = 0; i < last.count; i++)
+	{
+		const TraceEvent& event = last.events[i];
+
+		float x0 = origin.x + (float)((event.startUs - frameStart) / frameDuration) * width;
+		float x1 = std::max(origin.x + (float)((event.startUs + event.durationUs - frameStart) / frameDuration) * width, x0 + 1.f);
+
+		ImVec2 min = { x0, origin.y + event.depth * TIMELINE_ROW };
+		ImVec2 max = { x1, min.y + TIMELINE_ROW - 1.f };
+
+		//	A color per name, the same from frame to frame
+		ImU32 color = ImColor::HSV((event.name * 0.161f) - (int)(event.name * 0.161f), 0.55f, 0.75f);
+
+		drawList->AddRectFilled(min, max, color);
+
+		const char* name = m_names[event.name].c_str();
+		if (ImGui::CalcTextSize(name).x < x1 - x0 - 4.f) drawList->AddText({ x0 + 2.f, min.y + 1.f }, IM_COL32_WHITE, name);
+
+		if (ImGui::IsMouseHoveringRect(min, max)) ImGui::SetTooltip("%s : %.3f ms", name, event.durationUs / 1000.0);
+	}
+
+	//	Averages, in the order of the last frame
+	//	----------------------------------------
+
+	for (int i = 0; i < last.count; i++)
+	{
+		const TraceEvent& event = last.events[i];
+
+		const ScopeStats& stats = m_stats[event.name];
+		ImGui::Text("%*s%s : %.3f ms (%.3f ms avg)", event.depth * 2, "", m_names[event.name].c_str(), event.durationUs / 1000.0, stats.count ? stats.sum / stats.count : 0.f);
+	}
+
+	if (m_droppedFrames) ImGui::TextColored({ 1.f, 0.3f, 0.3f, 1.f }, "Frames not ready in time : %d", (int)m_droppedFrames);
+	if (m_droppedScopes) ImGui::TextColored({ 1.f, 0.3f, 0.3f, 1.f }, "Scopes past %d a frame, not traced : %d", FRAME_SCOPES, (int)m_droppedScopes);
+
+	//	Chrome trace of the kept frames, with the CPU scopes
+	lock.unlock();
+
+	if (ImGui::Button("Save trace")) Core::Profiler::instance()->saveTrace(TRACE_FILE);
+}
@@ -0,0 +1,153 @@
+#include <LowRenderer/GpuRingBuffer.hpp>
+
+#include <Core/Log.hpp>
+
+#include <algorithm>
+
+#include <imgui.h>
+
+#define FENCE_TIMEOUT 1000000 // 1 ms, in nanoseconds
+
+
+std::vector<GpuRingBuffer*> GpuRingBuffer::s_rings;
+
+static GLintptr alignOffset(GLintptr offset, GLsizeiptr alignment)
+{
+	//	Alignments aren't always powers of two (vertex strides)
+	GLintptr remainder = offset % alignment;
+	return remainder ? offset + alignment - remainder : offset;
+}
+
+GpuRingBuffer::GpuRingBuffer(const std::string& name, GLenum target, GLsizeiptr segmentSize, Core::MemoryTag tag)
+	: m_name(name), m_target(target), m_segmentSize(segmentSize), m_tag(tag)
+{
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	GLsizeiptr size = m_segmentSize * SEGMENT_COUNT;
+
+	//	Mapped once for the whole life of the ring
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(m_target, m_buffer);
+	glBufferStorage(m_target, size, nullptr, flags);
+	m_mapped = (char*)glMapBufferRange(m_target, 0, size, flags);
+	glBindBuffer(m_target, 0);
+
+	Core::MemoryTracker::addGpuBytes(m_tag, size);
+
+	if (!m_mapped) Core::Log::instance()->writeError("Couldn't map the \"" + m_name + "\" ring buffer");
+
+	GLint alignment = 1;
+	if (m_target == GL_UNIFORM_BUFFER)				glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	else if (m_target == GL_SHADER_STORAGE_BUFFER)	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	m_minAlignment = alignment;
+
+	s_rings.push_back(this);
+}
+
+GpuRingBuffer::~GpuRingBuffer()
+{
+	s_rings.erase(std::remove(s_rings.begin(), s_rings.end(), this), s_rings.end());
+
+	for (GLsync& fence : m_fences)
+	{
+		if (fence) glDeleteSync(fence);
+	}
+
+	glBindBuffer(m_target, m_buffer);
+	glUnmapBuffer(m_target);
+	glBindBuffer(m_target, 0);
+
+	glDeleteBuffers(1, &m_buffer);
+	Core::MemoryTracker::addGpuBytes(m_tag, -(long long)(m_segmentSize * SEGMENT_COUNT));
+}
+
+void GpuRingBuffer::enterSegment(int segment)
+{
+	//	The GPU may still read the segment we leave
+	if (m_segment >= 0)
+	{
+		if (m_fences[m_segment]) glDeleteSync(m_fences[m_segment]);
+		m_fences[m_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	//	Wait until the GPU is done with the one we enter
+	if (m_fences[segment])
+	{
+		GLenum status = glClientWaitSync(m_fences[segment], 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			m_frameStalls++;
+			m_totalStalls++;
+			while (glClientWaitSync(m_fences[segment], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT) == GL_TIMEOUT_EXPIRED);
+		}
+
+		glDeleteSync(m_fences[segment]);
+		m_fences[segment] = nullptr;
+	}
+
+	m_segment = segment;
+	m_cursor = segment * m_segmentSize;
+}
+
+bool GpuRingBuffer::fits(GLsizeiptr size, GLsizeiptr alignment) const
+{
+	if (m_segment < 0) return false;
+
+	return alignOffset(m_cursor, std::max(alignment, m_minAlignment)) + size <= (m_segment + 1) * m_segmentSize;
+}
+
+GpuRingBuffer::Range GpuRingBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment)
+{
+	Range range;
+	if (!m_mapped || size > m_segmentSize) return range;
+
+	//	An allocation never straddles two segments
+	if (!fits(size, alignment))
+	{
+		enterSegment((m_segment + 1) % SEGMENT_COUNT);
+		if (!fits(size, alignment)) return range;
+	}
+
+	range.offset = alignOffset(m_cursor, std::max(alignment, m_minAlignment));
+	range.size = size;
+	range.data = m_mapped + range.offset;
+
+	m_cursor = range.offset + size;
+	m_frameBytes += size;
+
+	return range;
+}
+
+void GpuRingBuffer::bindRange(GLuint index, const Range& range) const
+{
+	if (range.data) glBindBufferRange(m_target, index, m_buffer, range.offset, range.size);
+}
+
+void GpuRingBuffer::resetFrameStats()
+{
+	for (GpuRingBuffer* ring : s_rings)
+	{
+		ring->m_frameBytes = 0;
+		ring->m_frameStalls = 0;
+	}
+}
+
+long long GpuRingBuffer::getFrameBytes()
+{
+	long long bytes = 0;
+	for (GpuRingBuffer* ring : s_rings) bytes += ring->m_frameBytes;
+
+	return bytes;
+}
+
+void GpuRingBuffer::showImGui()
+{
+	long long totalBytes = 0;
+
+	for (GpuRingBuffer* ring : s_rings)
+	{
+		ImGui::Text("%s : %.1f KB, %d stall(s) (%d total)", ring->m_name.c_str(), ring->m_frameBytes / 1024.f, ring->m_frameStalls, ring->m_totalStalls);
+		totalBytes += ring->m_frameBytes;
+	}
+
+	ImGui::Text("Streamed : %.1f KB / frame", totalBytes / 1024.f);
+}
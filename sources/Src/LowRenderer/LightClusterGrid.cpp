@@ -0,0 +1,146 @@
+#include <LowRenderer/LightClusterGrid.hpp>
+
+#include <Core/JobSystem.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+#define PARALLEL_MIN_SPHERES 64
+
+
+void LightClusterGrid::setFrustum(float fovY, float aspect, float zNear, float zFar)
+{
+	m_tanHalfFovY = tanf(fovY * 0.5f);
+	m_tanHalfFovX = m_tanHalfFovY * aspect;
+	m_zNear = zNear;
+	m_zFar = zFar;
+
+	//	slice = log(depth / near) / log(far / near) * Z
+	float logRatio = logf(m_zFar / m_zNear);
+	m_sliceScale = CLUSTER_Z / logRatio;
+	m_sliceBias = -(float)CLUSTER_Z * logf(m_zNear) / logRatio;
+}
+
+float LightClusterGrid::getSliceDepth(unsigned int slice) const
+{
+	return m_zNear * powf(m_zFar / m_zNear, (float)slice / CLUSTER_Z);
+}
+
+int LightClusterGrid::getClusterIndex(const Maths::Vector3f& viewPosition) const
+{
+	float depth = -viewPosition.z;
+	if (depth < m_zNear || depth > m_zFar) return -1;
+
+	float ndcX = viewPosition.x / (depth * m_tanHalfFovX);
+	float ndcY = viewPosition.y / (depth * m_tanHalfFovY);
+	if (fabsf(ndcX) > 1.f || fabsf(ndcY) > 1.f) return -1;
+
+	unsigned int x = std::min((unsigned int)((ndcX * 0.5f + 0.5f) * CLUSTER_X), CLUSTER_X - 1);
+	unsigned int y = std::min((unsigned int)((ndcY * 0.5f + 0.5f) * CLUSTER_Y), CLUSTER_Y - 1);
+	unsigned int z = std::min((unsigned int)std::max(logf(depth) * m_sliceScale + m_sliceBias, 0.f), CLUSTER_Z - 1);
+
+	return x + y * CLUSTER_X + z * CLUSTER_X * CLUSTER_Y;
+}
+
+void LightClusterGrid::assignSlices(const std::vector<ClusterSphere>& spheres, unsigned int indexBase, unsigned int first, unsigned int last, bool fill)
+{
+	for (size_t i = 0; i < spheres.size(); i++)
+	{
+		int firstSlice = std::max(m_sphereSlices[i * 2], (int)first);
+		int lastSlice = std::min(m_sphereSlices[i * 2 + 1], (int)last - 1);
+
+		const Maths::Vector3f& center = spheres[i].center;
+		float radius = spheres[i].radius;
+		float depth = -center.z;
+
+		for (int slice = firstSlice; slice <= lastSlice; slice++)
+		{
+			//	Part of the sphere depth range inside the slice
+			float z0 = std::max(getSliceDepth(slice), depth - radius);
+			float z1 = std::min(getSliceDepth(slice + 1), depth + radius);
+
+			//	Widest cross section of the sphere inside the slice
+			float offset = depth < z0 ? z0 - depth : (depth > z1 ? depth - z1 : 0.f);
+			float sliceRadius = sqrtf(std::max(radius * radius - offset * offset, 0.f));
+
+			//	Conservative screen bounds of that cross section box over [z0, z1]
+			float left = center.x - sliceRadius, right = center.x + sliceRadius;
+			float bottom = center.y - sliceRadius, top = center.y + sliceRadius;
+
+			float minX = left / ((left < 0.f ? z0 : z1) * m_tanHalfFovX);
+			float maxX = right / ((right > 0.f ? z0 : z1) * m_tanHalfFovX);
+			float minY = bottom / ((bottom < 0.f ? z0 : z1) * m_tanHalfFovY);
+			float maxY = top / ((top > 0.f ? z0 : z1) * m_tanHalfFovY);
+
+			if (maxX < -1.f || minX > 1.f || maxY < -1.f || minY > 1.f) continue;
+
+			int x0 = std::max((int)floorf((minX * 0.5f + 0.5f) * CLUSTER_X), 0);
+			int x1 = std::min((int)floorf((maxX * 0.5f + 0.5f) * CLUSTER_X), (int)CLUSTER_X - 1);
+			int y0 = std::max((int)floorf((minY * 0.5f + 0.5f) * CLUSTER_Y), 0);
+			int y1 = std::min((int)floorf((maxY * 0.5f + 0.5f) * CLUSTER_Y), (int)CLUSTER_Y - 1);
+
+			for (int y = y0; y <= y1; y++)
+			{
+				ClusterRange* cluster = &m_clusters[x0 + y * CLUSTER_X + slice * CLUSTER_X * CLUSTER_Y];
+				for (int x = x0; x <= x1; x++, cluster++)
+				{
+					if (fill) m_indices[cluster->offset + cluster->count] = indexBase + (unsigned int)i;
+					cluster->count++;
+				}
+			}
+		}
+	}
+}
+
+void LightClusterGrid::assign(const std::vector<ClusterSphere>& spheres, unsigned int indexBase)
+{
+	for (ClusterRange& cluster : m_clusters) cluster = ClusterRange();
+
+	//	Depth slices touched by each sphere
+	m_sphereSlices.resize(spheres.size() * 2);
+	for (size_t i = 0; i < spheres.size(); i++)
+	{
+		float depth = -spheres[i].center.z;
+		float zMin = std::max(depth - spheres[i].radius, m_zNear);
+		float zMax = std::min(depth + spheres[i].radius, m_zFar);
+
+		if (zMin > zMax)
+		{
+			m_sphereSlices[i * 2] = 1;
+			m_sphereSlices[i * 2 + 1] = 0;
+			continue;
+		}
+
+		m_sphereSlices[i * 2] = std::min((int)std::max(logf(zMin) * m_sliceScale + m_sliceBias, 0.f), (int)CLUSTER_Z - 1);
+		m_sphereSlices[i * 2 + 1] = std::min((int)std::max(logf(zMax) * m_sliceScale + m_sliceBias, 0.f), (int)CLUSTER_Z - 1);
+	}
+
+	//	Each job owns whole slices, so clusters are never shared
+	auto runSlices = [&](bool fill)
+	{
+		if (spheres.size() < PARALLEL_MIN_SPHERES)
+		{
+			assignSlices(spheres, indexBase, 0, CLUSTER_Z, fill);
+			return;
+		}
+
+		Core::JobSystem::instance()->parallelFor(CLUSTER_Z, [&](unsigned int first, unsigned int last)
+		{
+			assignSlices(spheres, indexBase, first, last, fill);
+		});
+	};
+
+	//	Count, give each cluster its place in the list, then write the indices
+	runSlices(false);
+
+	unsigned int offset = 0;
+	for (ClusterRange& cluster : m_clusters)
+	{
+		cluster.offset = offset;
+		offset += cluster.count;
+		cluster.count = 0;
+	}
+	m_indices.resize(offset);
+
+	runSlices(true);
+}
@@ -0,0 +1,210 @@
+#include <LowRenderer/LightClusters.hpp>
+#include <LowRenderer/Light.hpp>
+#include <LowRenderer/CameraBase.hpp>
+#include <LowRenderer/RenderGraph.hpp>
+
+#include <Config.hpp>
+#include <Core/Window.hpp>
+
+#include <Resources/Shader.hpp>
+
+#include <Engine/Transform3.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#include <imgui.h>
+
+#define LIGHT_CUTOFF (1.f / 256.f)
+#define LIGHT_SEGMENT_SIZE (4 * 1024 * 1024)
+
+
+static float maxComponent(const Maths::Vector3f& v)
+{
+	return std::max(v.x, std::max(v.y, v.z));
+}
+
+static void copyVector(float out[3], const Maths::Vector3f& v)
+{
+	out[0] = v.x;
+	out[1] = v.y;
+	out[2] = v.z;
+}
+
+static GLsizeiptr alignSize(GLsizeiptr size, GLsizeiptr alignment)
+{
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+
+LightClusters::LightClusters() : m_ring("Lights", GL_SHADER_STORAGE_BUFFER, LIGHT_SEGMENT_SIZE)
+{
+}
+
+float LightClusters::getInfluenceRadius(const Light& light)
+{
+	//	Brightest term the attenuation is applied to (see DefaultFragmentShader)
+	float intensity = std::max(maxComponent(light.ambient), std::max(maxComponent(light.diffuse) * light.power, maxComponent(light.specular)));
+	if (intensity <= 0.f) return 0.f;
+
+	//	Solve constant + linear * d + quadratic * d^2 = intensity / cutoff
+	float constant = light.attenuation.x - intensity / LIGHT_CUTOFF;
+	float linear = light.attenuation.y;
+	float quadratic = light.attenuation.z;
+
+	if (constant >= 0.f) return 0.f;
+
+	if (quadratic > 0.f)
+		return (-linear + sqrtf(linear * linear - 4.f * quadratic * constant)) / (2.f * quadratic);
+
+	if (linear > 0.f)
+		return -constant / linear;
+
+	return -1.f;
+}
+
+void LightClusters::gather(const std::unordered_map<int, const Light*>& lights, std::vector<GpuLight>& gpuLights)
+{
+	for (auto& curr_light : lights)
+	{
+		const Light* light = curr_light.second;
+		if (!light || !light->isActive()) continue;
+
+		GpuLight gpuLight;
+		copyVector(gpuLight.position, light->m_transform->getWorldPosition());
+		copyVector(gpuLight.ambient, light->ambient);
+		copyVector(gpuLight.diffuse, light->diffuse);
+		copyVector(gpuLight.specular, light->specular);
+		copyVector(gpuLight.attenuation, light->attenuation);
+		copyVector(gpuLight.direction, light->direction);
+		gpuLight.power = light->power;
+		gpuLight.cutOff = light->cutOff;
+		gpuLight.outerCutOff = light->outerCutOff;
+		gpuLight.lightType = light->lightType;
+		gpuLight.radius = -1.f;
+		gpuLight.padding = 0.f;
+
+		if (light->lightType == (int)LightType::POINT_LIGHT)
+		{
+			gpuLight.radius = getInfluenceRadius(*light);
+
+			//	Too dim to light anything
+			if (gpuLight.radius == 0.f) continue;
+		}
+
+		gpuLights.push_back(gpuLight);
+	}
+}
+
+void LightClusters::build(const CameraBase& camera, const std::vector<GpuLight>& lights, bool clustered)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	m_clustered = clustered && camera.projectionMode == PERSPECTIVE;
+	m_grid.setFrustum(camera.fovY, camera.aspect, camera.near, camera.far);
+
+	Maths::Mat4x4 view = camera.getViewMatrix();
+
+	m_gpuLights.clear();
+	m_pointLights.clear();
+	m_spheres.clear();
+
+	for (const GpuLight& gpuLight : lights)
+	{
+		if (m_clustered && gpuLight.lightType == (int)LightType::POINT_LIGHT && gpuLight.radius > 0.f)
+		{
+			Maths::Vector3f position = { gpuLight.position[0], gpuLight.position[1], gpuLight.position[2] };
+
+			m_pointLights.push_back(gpuLight);
+			m_spheres.push_back({ (view * Maths::Vector4f(position, 1.f)).xyz, gpuLight.radius });
+			continue;
+		}
+
+		m_gpuLights.push_back(gpuLight);
+	}
+
+	m_globalCount = (unsigned int)m_gpuLights.size();
+	m_gpuLights.insert(m_gpuLights.end(), m_pointLights.begin(), m_pointLights.end());
+
+	m_grid.assign(m_spheres, m_globalCount);
+
+	m_assignMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	upload();
+}
+
+void LightClusters::upload()
+{
+	const std::vector<ClusterRange>& clusters = m_grid.getClusters();
+	const std::vector<unsigned int>& indices = m_grid.getIndices();
+
+	//	Storage buffers can't be empty
+	GLsizeiptr alignment = m_ring.getAlignment();
+	GLsizeiptr lightSize = alignSize(std::max<size_t>(m_gpuLights.size(), 1) * sizeof(GpuLight), alignment);
+	GLsizeiptr clusterSize = alignSize(clusters.size() * sizeof(ClusterRange), alignment);
+	GLsizeiptr indexSize = std::max<size_t>(indices.size(), 1) * sizeof(unsigned int);
+
+	//	Clusters past the end of the segment lose their last lights
+	GLsizeiptr maxIndexSize = LIGHT_SEGMENT_SIZE - lightSize - clusterSize;
+	unsigned int maxIndices = (unsigned int)(maxIndexSize / sizeof(unsigned int));
+	indexSize = std::min(indexSize, maxIndexSize);
+
+	//	One allocation, the three ranges are read by the same draws
+	GpuRingBuffer::Range range = m_ring.allocate(lightSize + clusterSize + indexSize);
+	if (!range.data) return;
+
+	char* data = (char*)range.data;
+
+	memcpy(data, m_gpuLights.data(), m_gpuLights.size() * sizeof(GpuLight));
+
+	m_droppedIndices = 0;
+	ClusterRange* clusterData = (ClusterRange*)(data + lightSize);
+	for (size_t i = 0; i < clusters.size(); i++)
+	{
+		clusterData[i] = clusters[i];
+
+		if (clusters[i].offset + clusters[i].count > maxIndices)
+		{
+			clusterData[i].count = clusters[i].offset < maxIndices ? maxIndices - clusters[i].offset : 0;
+			m_droppedIndices += clusters[i].count - clusterData[i].count;
+		}
+	}
+
+	memcpy(data + lightSize + clusterSize, indices.data(), std::min<size_t>(indices.size(), maxIndices) * sizeof(unsigned int));
+
+	GpuRingBuffer::Range lightRange = { data, range.offset, lightSize };
+	GpuRingBuffer::Range clusterRange = { data + lightSize, range.offset + lightSize, clusterSize };
+	GpuRingBuffer::Range indexRange = { data + lightSize + clusterSize, range.offset + lightSize + clusterSize, indexSize };
+
+	m_ring.bindRange(LIGHT_BINDING, lightRange);
+	m_ring.bindRange(CLUSTER_BINDING, clusterRange);
+	m_ring.bindRange(CLUSTER_INDEX_BINDING, indexRange);
+}
+
+void LightClusters::setUniforms(const Resources::Shader& shader, float renderScale) const
+{
+	Core::Window* _window = Core::Window::instance();
+
+	shader.setInt("GlobalLightNumber", (int)m_globalCount);
+
+	shader.setFloat("ClusterScale", m_grid.getSliceScale());
+	shader.setFloat("ClusterBias", m_grid.getSliceBias());
+	//	gl_FragCoord is in pixels of the scene targets
+	shader.setFloat2("ScreenSize", { (float)RenderGraph::getTargetSize(_window->m_width, renderScale), (float)RenderGraph::getTargetSize(_window->m_height, renderScale) });
+}
+
+void LightClusters::showImGui()
+{
+	const std::vector<ClusterRange>& clusters = m_grid.getClusters();
+
+	unsigned int maxCount = 0;
+	for (const ClusterRange& cluster : clusters) maxCount = std::max(maxCount, cluster.count);
+
+	ImGui::Text("Lights : %d (%d unbounded)", (int)m_gpuLights.size(), (int)m_globalCount);
+	ImGui::Text("Clusters : %d x %d x %d", LightClusterGrid::CLUSTER_X, LightClusterGrid::CLUSTER_Y, LightClusterGrid::CLUSTER_Z);
+	ImGui::Text("Indices : %d, %.2f per cluster, %d max", (int)m_grid.getIndices().size(), m_grid.getIndices().size() / (float)clusters.size(), (int)maxCount);
+	ImGui::Text("Assignment : %.3f ms", m_assignMs);
+
+	if (m_droppedIndices) ImGui::TextColored({ 1.f, 0.3f, 0.3f, 1.f }, "Dropped indices : %d", (int)m_droppedIndices);
+}
@@ -0,0 +1,216 @@
+#include <LowRenderer/LightSelector.hpp>
+#include <LowRenderer/LightClusters.hpp>
+#include <LowRenderer/Light.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <climits>
+
+#define HASH_BUCKETS 4096
+#define MAX_LIGHT_CELLS 64	// A light over more cells is scored by every query
+#define MAX_QUERY_CELLS 64	// A query over more cells scores every light
+#define MAX_SELECTED 32
+
+
+static float maxComponent(const float v[3])
+{
+	return std::max(v[0], std::max(v[1], v[2]));
+}
+
+//	Cells of the grid overlapped by a sphere, returns their count
+static int getCellRange(const Maths::Vector3f& center, float radius, float cellSize, int lo[3], int hi[3])
+{
+	//	Too wide to walk, and the cell coordinates could overflow
+	if (radius > MAX_QUERY_CELLS * cellSize) return INT_MAX;
+
+	int count = 1;
+	for (int i = 0; i < 3; i++)
+	{
+		lo[i] = (int)floorf((center.c[i] - radius) / cellSize);
+		hi[i] = (int)floorf((center.c[i] + radius) / cellSize);
+		count *= hi[i] - lo[i] + 1;
+	}
+	return count;
+}
+
+
+unsigned int LightSelector::getBucket(int x, int y, int z)
+{
+	return ((unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u ^ (unsigned int)z * 83492791u) % HASH_BUCKETS;
+}
+
+void LightSelector::build(const std::vector<GpuLight>& lights)
+{
+	//	clear() keeps the capacity, steady frames don't reallocate
+	m_lights.clear();
+	m_unbounded.clear();
+	m_cellLights.clear();
+	m_buckets.assign(HASH_BUCKETS + 1, 0);
+
+	m_stamps.assign(lights.size(), 0);
+	m_stamp = 0;
+	m_queries = 0;
+	m_scored = 0;
+
+	float radiusSum = 0.f;
+	unsigned int boundedCount = 0;
+
+	for (const GpuLight& gpuLight : lights)
+	{
+		SelectorLight light;
+		light.position = { gpuLight.position[0], gpuLight.position[1], gpuLight.position[2] };
+		light.direction = { gpuLight.direction[0], gpuLight.direction[1], gpuLight.direction[2] };
+		light.attenuation = { gpuLight.attenuation[0], gpuLight.attenuation[1], gpuLight.attenuation[2] };
+		light.radius = gpuLight.radius;
+		light.cutOff = gpuLight.cutOff;
+		light.outerCutOff = gpuLight.outerCutOff;
+		light.lightType = gpuLight.lightType;
+
+		//	Brightest term of the light, as getInfluenceRadius (LightClusters.cpp)
+		light.intensity = std::max(maxComponent(gpuLight.ambient), std::max(maxComponent(gpuLight.diffuse) * gpuLight.power, maxComponent(gpuLight.specular)));
+
+		if (light.direction.squareLength() > 0.f) light.direction = light.direction.normalized();
+
+		if (light.lightType == (int)LightType::POINT_LIGHT && light.radius > 0.f)
+		{
+			radiusSum += light.radius;
+			boundedCount++;
+		}
+
+		m_lights.push_back(light);
+	}
+
+	//	Cells about the size of a light, most lights cover 8 of them
+	m_cellSize = boundedCount ? std::max(2.f * radiusSum / boundedCount, 0.01f) : 1.f;
+
+	//	Counting sort of the lights by bucket : count, offset, then fill
+	for (int fill = 0; fill < 2; fill++)
+	{
+		for (unsigned int i = 0; i < (unsigned int)m_lights.size(); i++)
+		{
+			const SelectorLight& light = m_lights[i];
+
+			int lo[3], hi[3];
+			bool bounded = light.lightType == (int)LightType::POINT_LIGHT && light.radius > 0.f
+				&& getCellRange(light.position, light.radius, m_cellSize, lo, hi) <= MAX_LIGHT_CELLS;
+
+			if (!bounded)
+			{
+				if (fill) m_unbounded.push_back(i);
+				continue;
+			}
+
+			for (int z = lo[2]; z <= hi[2]; z++)
+				for (int y = lo[1]; y <= hi[1]; y++)
+					for (int x = lo[0]; x <= hi[0]; x++)
+					{
+						unsigned int bucket = getBucket(x, y, z);
+						if (fill) m_cellLights[--m_buckets[bucket + 1]] = i;
+						else m_buckets[bucket + 1]++;
+					}
+		}
+
+		if (fill) break;
+
+		//	m_buckets[b + 1] is the end of bucket b, the fill walks it back to its start
+		for (unsigned int bucket = 0; bucket < HASH_BUCKETS; bucket++) m_buckets[bucket + 1] += m_buckets[bucket];
+		m_cellLights.resize(m_buckets[HASH_BUCKETS]);
+	}
+
+	//	Once filled, m_buckets[b + 1] is the start of bucket b
+	for (unsigned int bucket = 0; bucket < HASH_BUCKETS; bucket++) m_buckets[bucket] = m_buckets[bucket + 1];
+	m_buckets[HASH_BUCKETS] = (unsigned int)m_cellLights.size();
+}
+
+float LightSelector::getInfluence(unsigned int i, const Maths::Vector3f& center, float radius) const
+{
+	const SelectorLight& light = m_lights[i];
+
+	//	Lights everything the same
+	if (light.lightType == (int)LightType::DIRECTIONNAL_LIGHT) return light.intensity;
+
+	Maths::Vector3f toObject = center - light.position;
+	float distance = toObject.length();
+
+	//	Not attenuated, only the part of the cone seen by the sphere counts (see setSpotLight)
+	if (light.lightType == (int)LightType::SPOT_LIGHT)
+	{
+		if (distance <= radius) return light.intensity;
+
+		float cosAngle = std::min(std::max(Maths::dotProduct(toObject, light.direction) / distance, -1.f), 1.f);
+		float angle = std::max(acosf(cosAngle) - asinf(radius / distance), 0.f);
+
+		float epsilon = light.cutOff - light.outerCutOff;
+		float theta = cosf(angle);
+		float cone = epsilon > 0.f ? std::min(std::max((theta - light.outerCutOff) / epsilon, 0.f), 1.f) : (theta >= light.outerCutOff ? 1.f : 0.f);
+
+		return light.intensity * cone;
+	}
+
+	//	Point light, attenuated from the nearest point of the sphere
+	float nearest = std::max(distance - radius, 0.f);
+	if (light.radius >= 0.f && nearest > light.radius) return 0.f;
+
+	float attenuation = light.attenuation.x + light.attenuation.y * nearest + light.attenuation.z * nearest * nearest;
+	return attenuation > 0.f ? light.intensity / attenuation : light.intensity;
+}
+
+void LightSelector::consider(unsigned int i, const Maths::Vector3f& center, float radius, unsigned int* indices, float* scores, unsigned int& count, unsigned int maxCount)
+{
+	//	Lights spanning several cells are met several times
+	if (m_stamps[i] == m_stamp) return;
+	m_stamps[i] = m_stamp;
+	m_scored++;
+
+	float score = getInfluence(i, center, radius);
+	if (score <= 0.f) return;
+
+	unsigned int slot;
+	if (count < maxCount) slot = count++;
+	else if (score > scores[count - 1]) slot = count - 1;
+	else return;
+
+	//	Insertion, the list stays sorted by decreasing influence
+	while (slot > 0 && scores[slot - 1] < score)
+	{
+		scores[slot] = scores[slot - 1];
+		indices[slot] = indices[slot - 1];
+		slot--;
+	}
+
+	scores[slot] = score;
+	indices[slot] = i;
+}
+
+unsigned int LightSelector::select(const Maths::Vector3f& center, float radius, unsigned int* indices, unsigned int maxCount)
+{
+	float scores[MAX_SELECTED];
+	maxCount = std::min(maxCount, (unsigned int)MAX_SELECTED);
+
+	unsigned int count = 0;
+	if (maxCount == 0 || m_lights.empty()) return count;
+
+	m_stamp++;
+	m_queries++;
+
+	for (unsigned int i : m_unbounded) consider(i, center, radius, indices, scores, count, maxCount);
+
+	int lo[3], hi[3];
+	if (getCellRange(center, radius, m_cellSize, lo, hi) > MAX_QUERY_CELLS)
+	{
+		//	Big objects score every light instead of walking all their cells
+		for (unsigned int i = 0; i < (unsigned int)m_lights.size(); i++) consider(i, center, radius, indices, scores, count, maxCount);
+		return count;
+	}
+
+	for (int z = lo[2]; z <= hi[2]; z++)
+		for (int y = lo[1]; y <= hi[1]; y++)
+			for (int x = lo[0]; x <= hi[0]; x++)
+			{
+				unsigned int bucket = getBucket(x, y, z);
+				for (unsigned int k = m_buckets[bucket]; k < m_buckets[bucket + 1]; k++)
+					consider(m_cellLights[k], center, radius, indices, scores, count, maxCount);
+			}
+
+	return count;
+}
@@ -4,8 +4,11 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#include <Config.hpp>
 #include <Core/Log.hpp>
 
+#include <LowRenderer/OpaquePass.hpp>
+
 #include <Resources/ResourcesManager.hpp>
 #include <Resources/Scene.hpp>
 
@@ -29,27 +32,46 @@ Model::~Model()
 	std::string a = "test";
 }
 
-void Model::draw()
+void Model::gather(OpaquePass& pass)
 {
 	if (m_shader && m_mesh)
 	{
-		m_shader->use();
-		m_shader->setMat4("Model", m_transform->getTransformMatrix());
+		updateMaterialInstance();
 
-		if (!m_material)
-		{
-			Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
-			m_material = &resources->m_materialName_material["None"];
-		}
-		
-		// Set up material parameters from our local instance
-		Resources::Material mat = *m_material;
-		mat.setMaterialValue(m_materialInstance);
-		m_materialInstance = mat;
-		m_shader->setMaterial(m_materialInstance);
-
-		m_mesh->draw();
+		pass.submit(m_mesh, m_shader, getFeatureKey(), m_materialInstance, m_transform->getTransformMatrix());
+	}
+}
+
+void Model::updateMaterialInstance()
+{
+	if (!m_material)
+	{
+		Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
+		m_material = &resources->m_materialName_material["None"];
 	}
+
+	// Set up material parameters from our local instance
+	// Assigned in place, the instance path keeps its capacity and a steady frame doesn't allocate
+	Resources::Material values;
+	values.setMaterialValue(m_materialInstance);
+	m_materialInstance = *m_material;
+	m_materialInstance.setMaterialValue(values);
+}
+
+unsigned int Model::getFeatureKey() const
+{
+	unsigned int featureKey = Resources::Shader::getFeatureKey(m_materialInstance);
+	if (debugNormal) featureKey |= Resources::ShaderFeature::SHOW_NORMAL;
+
+	return featureKey;
+}
+
+void Model::prewarm()
+{
+	if (!m_shader) return;
+
+	updateMaterialInstance();
+	m_shader->getVariant(getFeatureKey());
 }
 
 
@@ -86,11 +108,7 @@ void Model::showImGUI()
 	Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
 
 	//	DEBUG
-	if (ImGui::Checkbox("Show Normals", &debugNormal))
-	{
-		m_shader->use();
-		m_shader->setBool("showNormal", debugNormal);
-	}
+	ImGui::Checkbox("Show Normals", &debugNormal);
 
 	//	END DEBUG
 	const char* meshPreview = m_mesh ? m_meshName.c_str() : "none";
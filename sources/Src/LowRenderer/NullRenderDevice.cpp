@@ -0,0 +1,496 @@
+#include <glad/glad.h>
+
+#include <LowRenderer/RenderDevice.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+
+
+namespace
+{
+	RenderDevice::Stats* s_stats = nullptr;
+
+	//	Every object type shares the names, 0 stays the default object
+	GLuint s_nextName = 1;
+
+	std::unordered_map<GLenum, GLuint> s_boundBuffers;
+	//	A vector keeps its capacity, enabling in a steady frame doesn't allocate as a set node would
+	std::vector<GLenum> s_enabled;
+
+	//	CPU memory of the buffers created with glBufferStorage, returned by glMapBufferRange
+	std::unordered_map<GLuint, std::vector<char>> s_bufferStorage;
+
+	//	Shader completion is polled through it, the null compile is always done
+	const char* s_extension = "GL_KHR_parallel_shader_compile";
+
+	void genNames(GLsizei n, GLuint* names, int& live)
+	{
+		for (GLsizei i = 0; i < n; i++) names[i] = s_nextName++;
+		live += n;
+	}
+
+	void deleteNames(GLsizei n, const GLuint* names, int& live)
+	{
+		for (GLsizei i = 0; i < n; i++)
+		{
+			if (names[i]) live--;
+		}
+	}
+
+	size_t getPixelSize(GLenum format, GLenum type)
+	{
+		//	Packed types hold the whole pixel
+		if (type == GL_UNSIGNED_INT_10F_11F_11F_REV || type == GL_UNSIGNED_INT_24_8 || type == GL_UNSIGNED_INT_8_8_8_8) return 4;
+
+		size_t components = 4;
+		switch (format)
+		{
+		case GL_RED: case GL_DEPTH_COMPONENT:	components = 1; break;
+		case GL_RG:								components = 2; break;
+		case GL_RGB: case GL_BGR:				components = 3; break;
+		default: break;
+		}
+
+		size_t bytes = 4;
+		switch (type)
+		{
+		case GL_UNSIGNED_BYTE: case GL_BYTE:						bytes = 1; break;
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:	bytes = 2; break;
+		default: break;
+		}
+
+		return components * bytes;
+	}
+
+
+	//	State
+	//	-----
+
+	GLboolean APIENTRY nullIsEnabled(GLenum cap)
+	{
+		return std::find(s_enabled.begin(), s_enabled.end(), cap) != s_enabled.end() ? GL_TRUE : GL_FALSE;
+	}
+
+	void APIENTRY nullEnable(GLenum cap)
+	{
+		if (!nullIsEnabled(cap)) s_enabled.push_back(cap);
+	}
+
+	void APIENTRY nullDisable(GLenum cap)
+	{
+		s_enabled.erase(std::remove(s_enabled.begin(), s_enabled.end(), cap), s_enabled.end());
+	}
+
+	void APIENTRY nullViewport(GLint, GLint, GLsizei, GLsizei) {}
+	void APIENTRY nullScissor(GLint, GLint, GLsizei, GLsizei) {}
+	void APIENTRY nullClearColor(GLfloat, GLfloat, GLfloat, GLfloat) {}
+	void APIENTRY nullClear(GLbitfield) {}
+	void APIENTRY nullClipControl(GLenum, GLenum) {}
+	void APIENTRY nullPolygonMode(GLenum, GLenum) {}
+	void APIENTRY nullDepthMask(GLboolean) {}
+	void APIENTRY nullBlendFunc(GLenum, GLenum) {}
+	void APIENTRY nullBlendFuncSeparate(GLenum, GLenum, GLenum, GLenum) {}
+	void APIENTRY nullBlendEquation(GLenum) {}
+	void APIENTRY nullBlendEquationSeparate(GLenum, GLenum) {}
+	void APIENTRY nullPixelStorei(GLenum, GLint) {}
+
+	const GLubyte* APIENTRY nullGetString(GLenum name)
+	{
+		switch (name)
+		{
+		case GL_VERSION:					return (const GLubyte*)"4.5.0 Null device";
+		case GL_VENDOR:						return (const GLubyte*)"Null";
+		case GL_RENDERER:					return (const GLubyte*)"Null device";
+		case GL_SHADING_LANGUAGE_VERSION:	return (const GLubyte*)"4.50";
+		default:							return (const GLubyte*)"";
+		}
+	}
+
+	const GLubyte* APIENTRY nullGetStringi(GLenum name, GLuint index)
+	{
+		return (const GLubyte*)(name == GL_EXTENSIONS && index == 0 ? s_extension : "");
+	}
+
+	void APIENTRY nullGetIntegerv(GLenum pname, GLint* data)
+	{
+		switch (pname)
+		{
+		case GL_MAJOR_VERSION:							*data = 4; break;
+		case GL_MINOR_VERSION:							*data = 5; break;
+		case GL_NUM_EXTENSIONS:							*data = 1; break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:		*data = 256; break;
+		case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:	*data = 16; break;
+
+		//	No binary to cache
+		case GL_NUM_PROGRAM_BINARY_FORMATS:				*data = 0; break;
+		default:										*data = 0; break;
+		}
+	}
+
+
+	//	Buffers
+	//	-------
+
+	void APIENTRY nullGenBuffers(GLsizei n, GLuint* buffers)			{ genNames(n, buffers, s_stats->buffers); }
+	void APIENTRY nullBindBuffer(GLenum target, GLuint buffer)			{ s_boundBuffers[target] = buffer; }
+	void APIENTRY nullBindBufferRange(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) {}
+
+	void APIENTRY nullDeleteBuffers(GLsizei n, const GLuint* buffers)
+	{
+		deleteNames(n, buffers, s_stats->buffers);
+		for (GLsizei i = 0; i < n; i++) s_bufferStorage.erase(buffers[i]);
+	}
+
+	void APIENTRY nullBufferData(GLenum, GLsizeiptr size, const void* data, GLenum)
+	{
+		if (data) s_stats->uploadBytes += size;
+	}
+
+	void APIENTRY nullBufferSubData(GLenum, GLintptr, GLsizeiptr size, const void* data)
+	{
+		if (data) s_stats->uploadBytes += size;
+	}
+
+	void APIENTRY nullBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield)
+	{
+		std::vector<char>& storage = s_bufferStorage[s_boundBuffers[target]];
+		storage.assign(size, 0);
+
+		if (data)
+		{
+			memcpy(storage.data(), data, size);
+			s_stats->uploadBytes += size;
+		}
+	}
+
+	void* APIENTRY nullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield)
+	{
+		std::vector<char>& storage = s_bufferStorage[s_boundBuffers[target]];
+		if ((size_t)(offset + length) > storage.size()) return nullptr;
+
+		return storage.data() + offset;
+	}
+
+	GLboolean APIENTRY nullUnmapBuffer(GLenum) { return GL_TRUE; }
+
+	GLsync APIENTRY nullFenceSync(GLenum, GLbitfield)				{ return (GLsync)(uintptr_t)s_nextName++; }
+	GLenum APIENTRY nullClientWaitSync(GLsync, GLbitfield, GLuint64)	{ return GL_ALREADY_SIGNALED; }
+	void APIENTRY nullDeleteSync(GLsync) {}
+
+
+	//	Vertex arrays and draws
+	//	-----------------------
+
+	void APIENTRY nullGenVertexArrays(GLsizei n, GLuint* arrays)			{ genNames(n, arrays, s_stats->vertexArrays); }
+	void APIENTRY nullDeleteVertexArrays(GLsizei n, const GLuint* arrays)	{ deleteNames(n, arrays, s_stats->vertexArrays); }
+	void APIENTRY nullBindVertexArray(GLuint) {}
+	void APIENTRY nullEnableVertexAttribArray(GLuint) {}
+	void APIENTRY nullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+	void APIENTRY nullVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) {}
+	void APIENTRY nullVertexAttribDivisor(GLuint, GLuint) {}
+
+	void APIENTRY nullDrawArrays(GLenum, GLint, GLsizei count)
+	{
+		s_stats->drawCalls++;
+		s_stats->vertices += count;
+	}
+
+	void APIENTRY nullDrawElements(GLenum, GLsizei count, GLenum, const void*)
+	{
+		s_stats->drawCalls++;
+		s_stats->vertices += count;
+	}
+
+	void APIENTRY nullDrawElementsBaseVertex(GLenum, GLsizei count, GLenum, const void*, GLint)
+	{
+		s_stats->drawCalls++;
+		s_stats->vertices += count;
+	}
+
+	//	The commands are read back from the CPU memory of the indirect buffer
+	void APIENTRY nullMultiDrawElementsIndirect(GLenum, GLenum, const void* indirect, GLsizei drawcount, GLsizei stride)
+	{
+		s_stats->drawCalls++;
+
+		std::vector<char>& storage = s_bufferStorage[s_boundBuffers[GL_DRAW_INDIRECT_BUFFER]];
+		size_t offset = (size_t)indirect;
+		size_t commandStride = stride ? stride : 5 * sizeof(GLuint);
+
+		for (GLsizei i = 0; i < drawcount; i++)
+		{
+			if (offset + commandStride > storage.size()) break;
+
+			const GLuint* command = (const GLuint*)(storage.data() + offset);
+			s_stats->vertices += (long long)command[0] * command[1];
+
+			offset += commandStride;
+		}
+	}
+
+
+	//	Textures and framebuffers
+	//	-------------------------
+
+	void APIENTRY nullGenTextures(GLsizei n, GLuint* textures)			{ genNames(n, textures, s_stats->textures); }
+	void APIENTRY nullDeleteTextures(GLsizei n, const GLuint* textures)	{ deleteNames(n, textures, s_stats->textures); }
+	void APIENTRY nullActiveTexture(GLenum) {}
+	void APIENTRY nullBindTexture(GLenum, GLuint) {}
+	void APIENTRY nullBindSampler(GLuint, GLuint) {}
+	void APIENTRY nullTexParameteri(GLenum, GLenum, GLint) {}
+	void APIENTRY nullGenerateMipmap(GLenum) {}
+
+	void APIENTRY nullTexImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum format, GLenum type, const void* pixels)
+	{
+		//	Render targets are only allocated
+		if (pixels) s_stats->uploadBytes += (size_t)width * height * getPixelSize(format, type);
+	}
+
+	void APIENTRY nullGenFramebuffers(GLsizei n, GLuint* framebuffers)			{ genNames(n, framebuffers, s_stats->framebuffers); }
+	void APIENTRY nullDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)	{ deleteNames(n, framebuffers, s_stats->framebuffers); }
+	void APIENTRY nullBindFramebuffer(GLenum, GLuint) {}
+	void APIENTRY nullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+	void APIENTRY nullDrawBuffer(GLenum) {}
+	void APIENTRY nullDrawBuffers(GLsizei, const GLenum*) {}
+	GLenum APIENTRY nullCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+
+
+	//	Shaders and programs
+	//	--------------------
+
+	GLuint APIENTRY nullCreateShader(GLenum)
+	{
+		s_stats->shaders++;
+		return s_nextName++;
+	}
+
+	void APIENTRY nullDeleteShader(GLuint shader)
+	{
+		if (shader) s_stats->shaders--;
+	}
+
+	GLuint APIENTRY nullCreateProgram()
+	{
+		s_stats->programs++;
+		return s_nextName++;
+	}
+
+	void APIENTRY nullDeleteProgram(GLuint program)
+	{
+		if (program) s_stats->programs--;
+	}
+
+	void APIENTRY nullShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+	void APIENTRY nullCompileShader(GLuint) {}
+	void APIENTRY nullAttachShader(GLuint, GLuint) {}
+	void APIENTRY nullDetachShader(GLuint, GLuint) {}
+	void APIENTRY nullLinkProgram(GLuint) {}
+	void APIENTRY nullUseProgram(GLuint) {}
+	void APIENTRY nullProgramParameteri(GLuint, GLenum, GLint) {}
+	void APIENTRY nullProgramBinary(GLuint, GLenum, const void*, GLsizei) {}
+	void APIENTRY nullMaxShaderCompilerThreadsKHR(GLuint) {}
+
+	//	Compiled, linked and done
+	void APIENTRY nullGetShaderiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = (pname == GL_COMPILE_STATUS || pname == GL_COMPLETION_STATUS_KHR) ? GL_TRUE : 0;
+	}
+
+	void APIENTRY nullGetProgramiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = (pname == GL_LINK_STATUS || pname == GL_COMPLETION_STATUS_KHR) ? GL_TRUE : 0;
+	}
+
+	void APIENTRY nullGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+	{
+		if (length) *length = 0;
+		if (bufSize > 0) infoLog[0] = '\0';
+	}
+
+	void APIENTRY nullGetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+	{
+		if (length) *length = 0;
+		if (bufSize > 0) infoLog[0] = '\0';
+	}
+
+	void APIENTRY nullGetProgramBinary(GLuint, GLsizei, GLsizei* length, GLenum*, void*)
+	{
+		if (length) *length = 0;
+	}
+
+	GLint APIENTRY nullGetUniformLocation(GLuint, const GLchar*)	{ return 0; }
+	GLint APIENTRY nullGetAttribLocation(GLuint, const GLchar*)	{ return 0; }
+
+	void APIENTRY nullUniform1i(GLint, GLint) {}
+	void APIENTRY nullUniform1f(GLint, GLfloat) {}
+	void APIENTRY nullUniform2f(GLint, GLfloat, GLfloat) {}
+	void APIENTRY nullUniform3f(GLint, GLfloat, GLfloat, GLfloat) {}
+	void APIENTRY nullUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {}
+	void APIENTRY nullUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+
+
+	//	Timer queries
+	//	-------------
+
+	void APIENTRY nullGenQueries(GLsizei n, GLuint* ids)			{ genNames(n, ids, s_stats->queries); }
+	void APIENTRY nullDeleteQueries(GLsizei n, const GLuint* ids)	{ deleteNames(n, ids, s_stats->queries); }
+	void APIENTRY nullQueryCounter(GLuint, GLenum) {}
+
+	void APIENTRY nullGetQueryObjectiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+	}
+
+	void APIENTRY nullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params)
+	{
+		*params = 0;
+	}
+
+	void APIENTRY nullGetInteger64v(GLenum, GLint64* data)
+	{
+		*data = 0;
+	}
+
+
+	//	Functions the engine calls, the others stay null
+	//	------------------------------------------------
+
+	template<typename Function>
+	void* toProc(Function function)
+	{
+		return (void*)function;
+	}
+
+	struct NullFunction
+	{
+		const char* name;
+		void* function;
+	};
+
+	const NullFunction s_functions[] =
+	{
+		{ "glEnable", toProc(nullEnable) },
+		{ "glDisable", toProc(nullDisable) },
+		{ "glIsEnabled", toProc(nullIsEnabled) },
+		{ "glViewport", toProc(nullViewport) },
+		{ "glScissor", toProc(nullScissor) },
+		{ "glClearColor", toProc(nullClearColor) },
+		{ "glClear", toProc(nullClear) },
+		{ "glClipControl", toProc(nullClipControl) },
+		{ "glPolygonMode", toProc(nullPolygonMode) },
+		{ "glDepthMask", toProc(nullDepthMask) },
+		{ "glBlendFunc", toProc(nullBlendFunc) },
+		{ "glBlendFuncSeparate", toProc(nullBlendFuncSeparate) },
+		{ "glBlendEquation", toProc(nullBlendEquation) },
+		{ "glBlendEquationSeparate", toProc(nullBlendEquationSeparate) },
+		{ "glPixelStorei", toProc(nullPixelStorei) },
+		{ "glGetString", toProc(nullGetString) },
+		{ "glGetStringi", toProc(nullGetStringi) },
+		{ "glGetIntegerv", toProc(nullGetIntegerv) },
+
+		{ "glGenBuffers", toProc(nullGenBuffers) },
+		{ "glDeleteBuffers", toProc(nullDeleteBuffers) },
+		{ "glBindBuffer", toProc(nullBindBuffer) },
+		{ "glBindBufferRange", toProc(nullBindBufferRange) },
+		{ "glBufferData", toProc(nullBufferData) },
+		{ "glBufferSubData", toProc(nullBufferSubData) },
+		{ "glBufferStorage", toProc(nullBufferStorage) },
+		{ "glMapBufferRange", toProc(nullMapBufferRange) },
+		{ "glUnmapBuffer", toProc(nullUnmapBuffer) },
+		{ "glFenceSync", toProc(nullFenceSync) },
+		{ "glClientWaitSync", toProc(nullClientWaitSync) },
+		{ "glDeleteSync", toProc(nullDeleteSync) },
+
+		{ "glGenVertexArrays", toProc(nullGenVertexArrays) },
+		{ "glDeleteVertexArrays", toProc(nullDeleteVertexArrays) },
+		{ "glBindVertexArray", toProc(nullBindVertexArray) },
+		{ "glEnableVertexAttribArray", toProc(nullEnableVertexAttribArray) },
+		{ "glVertexAttribPointer", toProc(nullVertexAttribPointer) },
+		{ "glVertexAttribIPointer", toProc(nullVertexAttribIPointer) },
+		{ "glVertexAttribDivisor", toProc(nullVertexAttribDivisor) },
+		{ "glDrawArrays", toProc(nullDrawArrays) },
+		{ "glDrawElements", toProc(nullDrawElements) },
+		{ "glDrawElementsBaseVertex", toProc(nullDrawElementsBaseVertex) },
+		{ "glMultiDrawElementsIndirect", toProc(nullMultiDrawElementsIndirect) },
+
+		{ "glGenTextures", toProc(nullGenTextures) },
+		{ "glDeleteTextures", toProc(nullDeleteTextures) },
+		{ "glActiveTexture", toProc(nullActiveTexture) },
+		{ "glBindTexture", toProc(nullBindTexture) },
+		{ "glBindSampler", toProc(nullBindSampler) },
+		{ "glTexParameteri", toProc(nullTexParameteri) },
+		{ "glTexImage2D", toProc(nullTexImage2D) },
+		{ "glGenerateMipmap", toProc(nullGenerateMipmap) },
+		{ "glGenFramebuffers", toProc(nullGenFramebuffers) },
+		{ "glDeleteFramebuffers", toProc(nullDeleteFramebuffers) },
+		{ "glBindFramebuffer", toProc(nullBindFramebuffer) },
+		{ "glFramebufferTexture2D", toProc(nullFramebufferTexture2D) },
+		{ "glDrawBuffer", toProc(nullDrawBuffer) },
+		{ "glDrawBuffers", toProc(nullDrawBuffers) },
+		{ "glCheckFramebufferStatus", toProc(nullCheckFramebufferStatus) },
+
+		{ "glCreateShader", toProc(nullCreateShader) },
+		{ "glDeleteShader", toProc(nullDeleteShader) },
+		{ "glCreateProgram", toProc(nullCreateProgram) },
+		{ "glDeleteProgram", toProc(nullDeleteProgram) },
+		{ "glShaderSource", toProc(nullShaderSource) },
+		{ "glCompileShader", toProc(nullCompileShader) },
+		{ "glAttachShader", toProc(nullAttachShader) },
+		{ "glDetachShader", toProc(nullDetachShader) },
+		{ "glLinkProgram", toProc(nullLinkProgram) },
+		{ "glUseProgram", toProc(nullUseProgram) },
+		{ "glProgramParameteri", toProc(nullProgramParameteri) },
+		{ "glProgramBinary", toProc(nullProgramBinary) },
+		{ "glMaxShaderCompilerThreadsKHR", toProc(nullMaxShaderCompilerThreadsKHR) },
+		{ "glGetShaderiv", toProc(nullGetShaderiv) },
+		{ "glGetProgramiv", toProc(nullGetProgramiv) },
+		{ "glGetShaderInfoLog", toProc(nullGetShaderInfoLog) },
+		{ "glGetProgramInfoLog", toProc(nullGetProgramInfoLog) },
+		{ "glGetProgramBinary", toProc(nullGetProgramBinary) },
+		{ "glGetUniformLocation", toProc(nullGetUniformLocation) },
+		{ "glGetAttribLocation", toProc(nullGetAttribLocation) },
+		{ "glUniform1i", toProc(nullUniform1i) },
+		{ "glUniform1f", toProc(nullUniform1f) },
+		{ "glUniform2f", toProc(nullUniform2f) },
+		{ "glUniform3f", toProc(nullUniform3f) },
+		{ "glUniform4f", toProc(nullUniform4f) },
+		{ "glUniformMatrix4fv", toProc(nullUniformMatrix4fv) },
+
+		{ "glGenQueries", toProc(nullGenQueries) },
+		{ "glDeleteQueries", toProc(nullDeleteQueries) },
+		{ "glQueryCounter", toProc(nullQueryCounter) },
+		{ "glGetQueryObjectiv", toProc(nullGetQueryObjectiv) },
+		{ "glGetQueryObjectui64v", toProc(nullGetQueryObjectui64v) },
+		{ "glGetInteger64v", toProc(nullGetInteger64v) },
+	};
+
+	void* getProcAddress(const char* name)
+	{
+		for (const NullFunction& function : s_functions)
+		{
+			if (strcmp(function.name, name) == 0) return function.function;
+		}
+
+		//	Never called by the engine, a call would crash on the null pointer
+		return nullptr;
+	}
+}
+
+
+NullRenderDevice::~NullRenderDevice()
+{
+	if (s_stats == &m_stats) s_stats = nullptr;
+
+	s_boundBuffers.clear();
+	s_bufferStorage.clear();
+	s_enabled.clear();
+}
+
+bool NullRenderDevice::load()
+{
+	s_stats = &m_stats;
+
+	return gladLoadGLLoader(getProcAddress) != 0;
+}
@@ -0,0 +1,362 @@
+#include <LowRenderer/OpaquePass.hpp>
+#include <LowRenderer/CameraBase.hpp>
+#include <LowRenderer/GpuRingBuffer.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/LightSelector.hpp>
+#include <LowRenderer/RenderStats.hpp>
+
+#include <Config.hpp>
+#include <Core/JobSystem.hpp>
+#include <Resources/ResourcesManager.hpp>
+#include <Resources/Shader.hpp>
+#include <Resources/Material.hpp>
+#include <Resources/Mesh.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+//	Read by glMultiDrawElementsIndirect
+struct DrawElementsCommand
+{
+	GLuint	count;
+	GLuint	instanceCount;
+	GLuint	firstIndex;
+	GLint	baseVertex;
+	GLuint	baseInstance;	//	Draw index of the command, see MeshArena::bind
+};
+
+static Maths::Vector4f getMapTransform(const Resources::TextureMap& map)
+{
+	return { map.m_tiling.x, map.m_tiling.y, map.m_offset.x, map.m_offset.y };
+}
+
+static GpuMaterial getGpuMaterial(const Resources::Material& material)
+{
+	GpuMaterial gpuMaterial;
+
+	gpuMaterial.ambient = Maths::Vector4f(material.m_ambient, 0.f);
+	gpuMaterial.diffuse = Maths::Vector4f(material.m_diffuse, 0.f);
+	gpuMaterial.specular = Maths::Vector4f(material.m_specular, 0.f);
+	gpuMaterial.emissive = Maths::Vector4f(material.m_emissive, material.m_shininess);
+
+	gpuMaterial.diffuseMap = getMapTransform(material.m_text_diffuse);
+	gpuMaterial.normalMap = getMapTransform(material.m_text_bump);
+	gpuMaterial.specularMap = getMapTransform(material.m_text_specular);
+	gpuMaterial.emissiveMap = getMapTransform(material.m_text_emissive);
+	gpuMaterial.maskMap = getMapTransform(material.m_text_dissolve);
+
+	gpuMaterial.normalMultiplier = Maths::Vector4f(material.m_text_bump.m_multiplier);
+
+	return gpuMaterial;
+}
+
+//	Inverse transpose of the upper 3x3 (column-major), stored as the 3 columns of a mat4
+static void setNormalMatrix(const Maths::Mat4x4& model, float* out)
+{
+	const float* m = model.e;
+
+	//	Cofactors of the 3x3, the inverse transpose is cofactor / determinant
+	float c00 = m[5] * m[10] - m[6] * m[9];
+	float c01 = m[6] * m[8] - m[4] * m[10];
+	float c02 = m[4] * m[9] - m[5] * m[8];
+	float c10 = m[9] * m[2] - m[10] * m[1];
+	float c11 = m[10] * m[0] - m[8] * m[2];
+	float c12 = m[8] * m[1] - m[9] * m[0];
+	float c20 = m[1] * m[6] - m[2] * m[5];
+	float c21 = m[2] * m[4] - m[0] * m[6];
+	float c22 = m[0] * m[5] - m[1] * m[4];
+
+	float determinant = m[0] * c00 + m[4] * c10 + m[8] * c20;
+	float inverse = determinant != 0.f ? 1.f / determinant : 0.f;
+
+	memset(out, 0, 16 * sizeof(float));
+
+	//	Column i of the inverse transpose is the cofactor of column i of the model
+	out[0] = c00 * inverse;	out[1] = c01 * inverse;	out[2] = c02 * inverse;
+	out[4] = c10 * inverse;	out[5] = c11 * inverse;	out[6] = c12 * inverse;
+	out[8] = c20 * inverse;	out[9] = c21 * inverse;	out[10] = c22 * inverse;
+	out[15] = 1.f;
+}
+
+//	Models of a batch share their variant, maps and arena page
+static bool lessBatch(const OpaqueItem& a, const OpaqueItem& b)
+{
+	if (a.variant != b.variant) return a.variant < b.variant;
+
+	int pageA = a.mesh->getAllocation().page;
+	int pageB = b.mesh->getAllocation().page;
+	if (pageA != pageB) return pageA < pageB;
+
+	return memcmp(a.maps, b.maps, sizeof(a.maps)) < 0;
+}
+
+static bool sameBatch(const OpaqueItem& a, const OpaqueItem& b)
+{
+	return a.variant == b.variant
+		&& a.mesh->getAllocation().page == b.mesh->getAllocation().page
+		&& memcmp(a.maps, b.maps, sizeof(a.maps)) == 0;
+}
+
+static GLsizeiptr alignSize(GLsizeiptr size, GLsizeiptr alignment)
+{
+	GLsizeiptr remainder = size % alignment;
+	return remainder ? size + alignment - remainder : size;
+}
+
+
+void OpaquePass::begin(const CameraBase& camera, LightSelector* lightSelector)
+{
+	begin();
+
+	m_lightSelector = lightSelector;
+
+	Maths::Mat4x4 projection = camera.projectionMode == ORTHOGRAPHIC ? camera.getOrthographicProjection() : camera.getPerspectiveProjection();
+	Maths::Mat4x4 viewProjection = projection * camera.getViewMatrix();
+
+	//	Planes from the rows of the view projection (column-major, row i is e[i], e[4 + i], ...)
+	const float* m = viewProjection.e;
+	for (int i = 0; i < 3; i++)
+	{
+		for (int side = 0; side < 2; side++)
+		{
+			float sign = side == 0 ? 1.f : -1.f;
+			Maths::Vector4f plane = { m[3] + sign * m[i], m[7] + sign * m[4 + i], m[11] + sign * m[8 + i], m[15] + sign * m[12 + i] };
+
+			//	Normalized so the distance compares with a radius
+			float length = plane.xyz.length();
+			if (length > 0.f) plane = plane * (1.f / length);
+
+			m_planes[i * 2 + side] = plane;
+		}
+	}
+
+	m_cull = true;
+}
+
+void OpaquePass::begin()
+{
+	//	clear() keeps the capacity, steady frames don't reallocate
+	m_items.clear();
+	m_order.clear();
+	m_bounds.clear();
+
+	m_cull = false;
+	m_culled = 0;
+
+	m_lightSelector = nullptr;
+	m_selectedLights = 0;
+}
+
+void OpaquePass::submit(const Resources::Mesh* mesh, Resources::Shader* shader, unsigned int featureKey, const Resources::Material& material, const Maths::Mat4x4& model)
+{
+	if (!mesh || !shader || mesh->getAllocation().page < 0) return;
+
+	OpaqueItem item;
+	item.mesh = mesh;
+	item.shader = shader;
+	item.featureKey = featureKey;
+
+	//	Units of the samplers, see setSamplers (Shader.cpp)
+	item.maps[0] = material.m_text_diffuse.getTextureID();
+	item.maps[1] = material.m_text_bump.getTextureID();
+	item.maps[2] = material.m_text_specular.getTextureID();
+	item.maps[3] = material.m_text_emissive.getTextureID();
+	item.maps[4] = material.m_text_dissolve.getTextureID();
+
+	memcpy(item.object.model, model.e, sizeof(item.object.model));
+	item.material = getGpuMaterial(material);
+
+	m_items.push_back(item);
+}
+
+void OpaquePass::end()
+{
+	m_bounds.resize(m_items.size());
+
+	//	Each item only writes its own bounds and normal matrix
+	Core::JobSystem::instance()->parallelFor((unsigned int)m_items.size(), [this](unsigned int first, unsigned int last)
+	{
+		for (unsigned int i = first; i < last; i++)
+		{
+			OpaqueItem& item = m_items[i];
+			Maths::Mat4x4 model = Maths::mat4x4Identity();
+			memcpy(model.e, item.object.model, sizeof(model.e));
+
+			//	Sphere of the mesh moved by the model, its radius scaled by the largest axis
+			Maths::Vector3f center = (model * Maths::Vector4f(item.mesh->getBoundsCenter(), 1.f)).xyz;
+			float scale = std::max(model.c[0].xyz.squareLength(), std::max(model.c[1].xyz.squareLength(), model.c[2].xyz.squareLength()));
+			float radius = item.mesh->getBoundsRadius() * sqrtf(scale);
+
+			bool visible = true;
+			if (m_cull)
+			{
+				for (const Maths::Vector4f& plane : m_planes)
+				{
+					if (Maths::dotProduct(plane.xyz, center) + plane.w < -radius)
+					{
+						visible = false;
+						break;
+					}
+				}
+			}
+
+			m_bounds[i] = Maths::Vector4f(center, visible ? radius : -1.f);
+			if (visible) setNormalMatrix(model, item.object.normalMatrix);
+		}
+	}, 64);
+
+	//	Packed in their gathering order, the selector isn't shared between threads
+	size_t kept = 0;
+	for (size_t i = 0; i < m_items.size(); i++)
+	{
+		const Maths::Vector4f& bounds = m_bounds[i];
+		if (bounds.w < 0.f)
+		{
+			m_culled++;
+			continue;
+		}
+
+		if (kept != i) m_items[kept] = m_items[i];
+		OpaqueItem& item = m_items[kept++];
+
+		//	The variant reads the lights of its draw instead of the clusters
+		if (m_lightSelector)
+		{
+			item.featureKey |= Resources::ShaderFeature::OBJECT_LIGHTS;
+			item.object.lightCount = m_lightSelector->select(bounds.xyz, bounds.w, item.object.lights, OBJECT_LIGHT_COUNT);
+			m_selectedLights += item.object.lightCount;
+		}
+	}
+
+	m_items.resize(kept);
+}
+
+void OpaquePass::draw(GpuRingBuffer& storageRing, GpuRingBuffer& commandRing)
+{
+	m_batches = 0;
+	m_materials = 0;
+
+	if (m_items.empty()) return;
+
+	//	Variant compiled for the maps of each material
+	for (OpaqueItem& item : m_items)
+	{
+		item.variant = item.shader->getVariant(item.featureKey);
+	}
+
+	m_order.resize(m_items.size());
+	for (unsigned int i = 0; i < (unsigned int)m_order.size(); i++) m_order[i] = i;
+
+	//	The models of a batch keep their gathering order
+	//	Ties fall back on the index, stable_sort would allocate its merge buffer every frame
+	std::sort(m_order.begin(), m_order.end(), [this](unsigned int a, unsigned int b)
+	{
+		if (lessBatch(m_items[a], m_items[b])) return true;
+		if (lessBatch(m_items[b], m_items[a])) return false;
+		return a < b;
+	});
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandRing.getBuffer());
+
+	size_t first = 0;
+	while (first < m_order.size())
+	{
+		size_t last = first + 1;
+		while (last < m_order.size() && last - first < MAX_BATCH_DRAWS && sameBatch(m_items[m_order[first]], m_items[m_order[last]])) last++;
+
+		drawBatch(first, last, storageRing, commandRing);
+		first = last;
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void OpaquePass::drawBatch(size_t first, size_t last, GpuRingBuffer& storageRing, GpuRingBuffer& commandRing)
+{
+	GLsizei count = (GLsizei)(last - first);
+
+	//	Objects and materials in one allocation, so the ring can't fence one before the draw
+	GLsizeiptr objectsSize = alignSize(count * sizeof(GpuObject), storageRing.getAlignment());
+	GLsizeiptr materialsSize = count * sizeof(GpuMaterial);
+
+	GpuRingBuffer::Range storage = storageRing.allocate(objectsSize + materialsSize);
+	GpuRingBuffer::Range commands = commandRing.allocate(count * sizeof(DrawElementsCommand), sizeof(GLuint));
+	if (!storage.data || !commands.data) return;
+
+	GpuRingBuffer::Range objects = storage;
+	objects.size = objectsSize;
+
+	GpuRingBuffer::Range materials = storage;
+	materials.data = (char*)storage.data + objectsSize;
+	materials.offset = storage.offset + objectsSize;
+	materials.size = materialsSize;
+
+	GpuObject* objectData = (GpuObject*)objects.data;
+	GpuMaterial* materialData = (GpuMaterial*)materials.data;
+	DrawElementsCommand* commandData = (DrawElementsCommand*)commands.data;
+
+	//	The rings are write only, consecutive models compare their materials on the CPU side
+	const GpuMaterial* previousMaterial = nullptr;
+	GLuint materialCount = 0;
+	long long triangles = 0;
+
+	for (GLsizei i = 0; i < count; i++)
+	{
+		const OpaqueItem& item = m_items[m_order[first + i]];
+
+		if (!previousMaterial || memcmp(previousMaterial, &item.material, sizeof(GpuMaterial)) != 0)
+		{
+			materialData[materialCount++] = item.material;
+			previousMaterial = &item.material;
+		}
+
+		GpuObject object = item.object;
+		object.material = materialCount - 1;
+		objectData[i] = object;
+
+		const Resources::MeshArena::Allocation& allocation = item.mesh->getAllocation();
+
+		DrawElementsCommand command;
+		command.count = allocation.indexCount;
+		command.instanceCount = 1;
+		command.firstIndex = allocation.firstIndex;
+		command.baseVertex = allocation.baseVertex;
+		command.baseInstance = i;
+		commandData[i] = command;
+
+		triangles += allocation.indexCount / 3;
+	}
+
+	const OpaqueItem& batch = m_items[m_order[first]];
+
+	batch.variant->use();
+
+	GLState* _glState = GLState::instance();
+	for (GLuint unit = 0; unit < 5; unit++)
+	{
+		_glState->bindTexture(GL_TEXTURE_2D, batch.maps[unit], unit);
+	}
+
+	storageRing.bindRange(OBJECT_BINDING, objects);
+	storageRing.bindRange(MATERIAL_BINDING, materials);
+
+	Resources::ResourcesManager::instance()->m_meshArena.bind(batch.mesh->getAllocation().page);
+
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)commands.offset, count, 0);
+	RenderStats::instance()->addDraw(count, triangles);
+
+	m_batches++;
+	m_materials += materialCount;
+}
+
+void OpaquePass::showImGui() const
+{
+	ImGui::Text("Models : %d drawn, %d culled", (int)m_items.size(), m_culled);
+	ImGui::Text("Multi draws : %d, %d materials", m_batches, m_materials);
+
+	if (m_lightSelector && !m_items.empty())
+		ImGui::Text("Lights per model : %.2f / %d", m_selectedLights / (float)m_items.size(), OBJECT_LIGHT_COUNT);
+}
@@ -1,5 +1,6 @@
 
 #include <LowRenderer/ParticleSystem.hpp>
+#include <LowRenderer/TranslucentPass.hpp>
 
 #include <Resources/Shader.hpp>
 #include <Resources/Material.hpp>
@@ -9,6 +10,8 @@
 #include <Engine/GameObject.hpp>
 
 #include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/JobSystem.hpp>
 
 #include <Maths/Random.hpp>
 
@@ -18,13 +21,15 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#define PARTICLE_GRAIN 256	// Particles a job moves at least, smaller systems stay on the calling thread
+
 using namespace Resources;
 
 void ParticleSystem::showImGUI()
 {
 	Resources::ResourcesManager* resources = Resources::ResourcesManager::instance();
 	ImGui::Checkbox("Active", &m_active);
-	ImGui::Checkbox("Use Lights", &m_useLights);
+	ImGui::Checkbox("Collide", &m_collide);
 	ImGui::Checkbox("Loop", &m_loop);
 	
 	if (!m_loop)
@@ -170,10 +175,25 @@ void ParticleSystem::ApplyPreset(ParticleSystemPresets preset)
 
 void ParticleSystem::update() 
 {
+	MEMORY_TAG(PARTICLES);
+
 	timer.setEndTime(Maths::randRange(m_spawnrateRange.x, m_spawnrateRange.y));
 
-	for (int i = 0; i < particles.size(); i++)
-		particles[i].timer.ended() ? destroyParticle(i) : particles[i].update();
+	const Physics::SignedDistanceField* field = nullptr;
+	if (m_collide) field = m_gameObject->m_sceneReference->m_physicsManager.getDistanceField();
+
+	Maths::Mat4x4 parentMatrix = pos.getTransformMatrix();
+
+	//	Dead particles first, the living ones are moved independently on the workers
+	for (int i = (int)particles.size() - 1; i >= 0; i--)
+	{
+		if (particles[i].timer.ended()) destroyParticle(i);
+	}
+
+	Core::JobSystem::instance()->parallelFor((unsigned int)particles.size(), [&](unsigned int first, unsigned int last)
+	{
+		for (unsigned int i = first; i < last; i++) particles[i].update(field, parentMatrix);
+	}, PARTICLE_GRAIN);
 
 	if (!m_active) return;
 	
@@ -193,29 +213,27 @@ void ParticleSystem::update()
 		m_active = false;
 }
 
-void ParticleSystem::draw() 
+void ParticleSystem::gatherTranslucent(TranslucentPass& pass) const
 {
 	if (!m_shader || !m_material) return;
-	m_shader->use(); 
-	m_shader->setMaterial(*m_material);
+
+	//	Same material for every particle, one variant for the system
+	unsigned int featureKey = Resources::Shader::getFeatureKey(*m_material);
 	for (const Particle& particle : particles) 
 	{
-		m_shader->setBool("is_affected_by_light", m_useLights);
-		m_shader->setFloat4("ParticleColor", particle.getColor());
-		m_shader->setMat4("Model", particle.transform.getTransformMatrix());
-
-		glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-
-		glBindVertexArray(0);
+		pass.submit(m_shader, featureKey, m_material, particle.transform.getTransformMatrix(), particle.getColor());
 	}
 }
 
+void ParticleSystem::prewarm()
+{
+	if (m_shader && m_material) m_shader->getVariant(Resources::Shader::getFeatureKey(*m_material));
+}
+
 ParticleSystem::ParticleSystem(GameObject* in_gameObject) : Component(in_gameObject)
 {
     init(ComponentType::ParticleSystem);
 
-    initGL();
     m_gameObject->m_sceneReference->m_rendererManager.m_particleSystemList[(int)m_gameObject->m_sceneReference->m_rendererManager.m_particleSystemList.size()] = this;
 	pos.m_gameObject = in_gameObject;
 
@@ -252,42 +270,6 @@ void ParticleSystem::destroyParticle(int i)
 	particles.pop_back();
 }
 
-void ParticleSystem::initGL()
-{
-    // configure VAO/VBO
-    unsigned int VBO;
-    float vertices[] = {
-        // pos      // tex
-        -0.5f,  0.5f, 0.0f, 1.0f,
-         0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f, 0.0f, 0.0f,
-
-       -0.5f,  0.5f, 0.0f, 1.0f,
-         0.5f,  0.5f, 1.0f, 1.0f,
-         0.5f, -0.5f, 1.0f, 0.0f
-    };
-
-    //	Create VAO - Vertex Array Object
-    glGenVertexArrays(1, &VAO);
-
-    //	Create VBO - Vertex Buffer Object
-    glGenBuffers(1, &VBO);
-
-    //	Define VBO and VAO
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    //	Attach VBO to VAO / Bind attributes (texCoord) in VAO
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    //	Position & texCoord
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-	
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
 void ParticleSystem::saveComponentInSCNFile(std::ofstream& file)
 {
 	file << "PARTICLESYSTEM\t";
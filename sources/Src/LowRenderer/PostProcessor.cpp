@@ -1,4 +1,7 @@
 #include <LowRenderer/PostProcessor.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/GpuProfiler.hpp>
+#include <LowRenderer/RenderStats.hpp>
 #include <Resources/ResourcesManager.hpp>
 
 #include <Core/Window.hpp>
@@ -14,100 +17,30 @@
 
 PostProcessor::~PostProcessor()
 {
-    glDeleteRenderbuffers(1, &RBO);
-    glDeleteFramebuffers(1, &FBO);
 }
 
 PostProcessor::PostProcessor()
 {
     Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
-    Core::Window* _window = Core::Window::instance();
-    //Core::InputsManager* _inputs = Core::InputsManager::instance();
-    Core::Log* _log = Core::Log::instance();
 
     Resources::loadShader("PostProcess");
     m_shader = &_resources->m_shaderName_shader["PostProcess"];
 
-    Resources::loadShader("GaussianBlur");
-    m_gaussianShader = &_resources->m_shaderName_shader["GaussianBlur"];
+    Resources::loadShader("BloomDownsample");
+    m_downsampleShader = &_resources->m_shaderName_shader["BloomDownsample"];
 
-    //_inputs->getWindowSize(m_width, m_height);
+    Resources::loadShader("BloomUpsample");
+    m_upsampleShader = &_resources->m_shaderName_shader["BloomUpsample"];
 
-    //  Generate Frame Buffer Object
-    //  ----------------------------
-
-    glGenFramebuffers(1, &FBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-
-    //  Generate Texture
-    //  ----------------
-
-    glActiveTexture(GL_TEXTURE0);
-    glGenTextures(2, m_texture);
-
-    for (unsigned int i = 0; i < 2; i++)
-    {
-        glBindTexture(GL_TEXTURE_2D, m_texture[i]);
-
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, _window->m_width, _window->m_height, 0, GL_RGBA, GL_FLOAT, NULL);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_texture[i], 0);
-    }
-
-    //  Generate Render Buffer Object
-    //  -----------------------------
-
-    glGenRenderbuffers(1, &RBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, _window->m_width, _window->m_height);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, RBO);
-
-
-    unsigned int attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
-    glDrawBuffers(2, attachments);
-
-    if ((glCheckFramebufferStatus(GL_FRAMEBUFFER)) != GL_FRAMEBUFFER_COMPLETE)
-    {
-        _log->writeError("POSTPROCESSOR -> Incomplete frameBuffer");
-    }
-
-   glGenFramebuffers(2, pingpongFBO);
-   glGenTextures(2, m_pingPongTexture);
-   for (unsigned int i = 0; i < 2; i++)
-   {
-       glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
-       glBindTexture(GL_TEXTURE_2D, m_pingPongTexture[i]);
-       glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, _window->m_width, _window->m_height, 0, GL_RGBA, GL_FLOAT, NULL);
-
-       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-       glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_pingPongTexture[i], 0 );
-   }
-
-   glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-
-   m_shader->use();
-   m_shader->setInt("Scene", 0);
-   m_shader->setInt("BloomBlur", 1);
-   m_shader->setFloat("Exposure", m_exposure);
-   m_shader->setFloat("Gamma", m_gamma);
-   m_shader->setBool("Bloom", m_bloom);
-
-
-   m_gaussianShader->use();
-   m_gaussianShader->setInt("Image", 0);
-   
-   initRenderData();
+    m_shader->use();
+    m_shader->setInt("Scene", 0);
+    m_shader->setInt("BloomBlur", 1);
+    m_shader->setFloat("Exposure", m_exposure);
+    m_shader->setFloat("Gamma", m_gamma);
+    m_shader->setFloat("BloomIntensity", m_bloomIntensity);
+    m_shader->setBool("Bloom", m_bloom);
+
+    initRenderData();
 }
 
 
@@ -132,130 +65,103 @@ void PostProcessor::initRenderData()
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glBindVertexArray(VAO);
+    GLState::instance()->bindVertexArray(VAO);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glBindVertexArray(0);
+    GLState::instance()->bindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 
-void PostProcessor::reshape()
+void PostProcessor::addPasses(RenderGraph& graph, RenderGraph::Resource sceneColor, RenderGraph::Resource brightColor, RenderGraph::Resource output, float renderScale)
 {
-    //Core::InputsManager* _inputs = Core::InputsManager::instance();
-    Core::Window* _window = Core::Window::instance();
-
-    /*int oldWidth  = m_width;
-    int oldHeight = m_height;
-    _inputs->getWindowSize(m_width, m_height);*/
+    //  Each pass is timed by the graph, see GpuProfiler
+    //  The graph keeps the passes across frames, they read the settings changed since when they run
+    int levelCount = m_bloomLevels;
+    m_renderScale = renderScale;
 
-    //if (oldWidth == m_width && oldHeight == m_height) return;
+    //  Bloom chain, each level is half the size of the previous one
+    //  ------------------------------------------------------------
 
-    if (_window->m_wasReshaped == false) return;
-
-    for (unsigned int i = 0; i < 2; i++)
+    RenderGraph::Resource levels[BLOOM_LEVELS];
+    for (int i = 0; i < levelCount; i++)
     {
-        glBindTexture(GL_TEXTURE_2D, m_texture[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, _window->m_width, _window->m_height, 0, GL_RGBA, GL_FLOAT, NULL);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        levels[i] = graph.createTexture("Bloom " + std::to_string(i), GL_R11F_G11F_B10F, i + 1, renderScale);
     }
 
-    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, _window->m_width, _window->m_height);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
-    for (unsigned int i = 0; i < 2; i++)
+    //  Downsample the bright parts down the chain
+    for (int i = 0; i < levelCount; i++)
     {
+        RenderGraph::Resource source = i == 0 ? brightColor : levels[i - 1];
 
-        glBindTexture(GL_TEXTURE_2D, m_pingPongTexture[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, _window->m_width, _window->m_height, 0, GL_RGBA, GL_FLOAT, NULL);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-
-}
-
-void PostProcessor::beginRender()
-{
-    reshape();
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-    glClearColor(0, 0,0,0);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
+        graph.addPass("Bloom downsample " + std::to_string(i), { source }, { levels[i] }, [this, &graph, source]()
+        {
+            GLState* _glState = GLState::instance();
 
+            _glState->disable(GL_BLEND);
+            _glState->bindVertexArray(VAO);
+            m_downsampleShader->use();
+            _glState->bindTexture(GL_TEXTURE_2D, graph.getTexture(source), 0);
 
-void PostProcessor::endRender()
-{
-    //  Back to default
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::instance()->addDraw(1, 2);
+        });
+    }
 
-    if (m_bloom)
+    //  Then back up, each level is added to the one above
+    for (int i = levelCount - 2; i >= 0; i--)
     {
-        bool horizontal = true;
-        m_gaussianShader->use();
-    
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_texture[1]);
-        glBindVertexArray(VAO);
-
-        //  Loop to add bloom effects
-        for (int i = 0; i < m_bloomAmount; i++)
+        RenderGraph::Resource source = levels[i + 1];
+
+        graph.addPass("Bloom upsample " + std::to_string(i), { source }, { levels[i] }, [this, &graph, source]()
         {
-            glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
-            m_gaussianShader->setBool("Horizontal", horizontal);
+            GLState* _glState = GLState::instance();
 
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+            _glState->enable(GL_BLEND);
+            _glState->blendFunc(GL_ONE, GL_ONE);
+            _glState->bindVertexArray(VAO);
+            m_upsampleShader->use();
+            _glState->bindTexture(GL_TEXTURE_2D, graph.getTexture(source), 0);
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, m_pingPongTexture[horizontal]);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::instance()->addDraw(1, 2);
 
-            horizontal = !horizontal;
-        }
-        glBindVertexArray(0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            _glState->disable(GL_BLEND);
+            _glState->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        });
     }
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    /*
-    * DEBUGING
-    * 
-    
-    if (ImGui::Begin("DEBUG"))
-    {
-        ImGui::Image((void*)(intptr_t)m_texture[0], ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
-
-        ImGui::SameLine();
-        ImGui::Image((void*)(intptr_t)m_texture[1], ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
 
-        ImGui::SameLine();
-        ImGui::Image((void*)(intptr_t)m_pingPongTexture[0], ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
+    //  Composite
+    //  ---------
 
-        ImGui::SameLine();
-        ImGui::Image((void*)(intptr_t)m_pingPongTexture[1], ImVec2(256, 256), ImVec2(0, 1), ImVec2(1, 0));
-    }
-    ImGui::End();
-    */
-}
+    std::vector<RenderGraph::Resource> reads = { sceneColor };
+    if (m_bloom) reads.push_back(levels[0]);
 
+    bool bloom = m_bloom;
+    RenderGraph::Resource bloomLevel = levels[0];
 
+    graph.addPass("Composite", reads, { output }, [this, &graph, sceneColor, bloomLevel, bloom]()
+    {
+        GLState* _glState = GLState::instance();
 
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-void PostProcessor::render()
-{
-    m_shader->use();
+        //  Bilinear upscale alone blurs, a scene at the window size is left as is
+        float sharpness = m_renderScale < 1.f ? m_sharpness : 0.f;
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_texture[0]);
+        m_shader->use();
+        m_shader->setFloat("Sharpness", sharpness);
 
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_pingPongTexture[1]);
+        _glState->bindTexture(GL_TEXTURE_2D, graph.getTexture(sceneColor), 0);
+        if (bloom) _glState->bindTexture(GL_TEXTURE_2D, graph.getTexture(bloomLevel), 1);
 
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+        _glState->bindVertexArray(VAO);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        RenderStats::instance()->addDraw(1, 2);
+    });
 }
 
 
-
 void PostProcessor::showImGui()
 {
     if (ImGui::Checkbox("Bloom", &m_bloom))
@@ -270,8 +176,9 @@ void PostProcessor::showImGui()
 
         changed  = ImGui::SliderFloat("Exposure", &m_exposure, 0.f, 1.f);
         changed |= ImGui::SliderFloat("Gamma", &m_gamma, 0.f, 5.f);
+        changed |= ImGui::SliderFloat("Bloom Intensity", &m_bloomIntensity, 0.f, 1.f);
 
-        ImGui::SliderInt("Bloom Amount", &m_bloomAmount, 1, 50);
+        ImGui::SliderInt("Bloom Levels", &m_bloomLevels, 1, BLOOM_LEVELS);
 
         if (changed)
         {
@@ -279,6 +186,28 @@ void PostProcessor::showImGui()
 
             m_shader->setFloat("Exposure", m_exposure);
             m_shader->setFloat("Gamma", m_gamma);
+            m_shader->setFloat("BloomIntensity", m_bloomIntensity);
         }
     }
-}
\ No newline at end of file
+
+    //  Applied when the scene is drawn under the window size (see DynamicResolution)
+    ImGui::SliderFloat("Upscale Sharpness", &m_sharpness, 0.f, 1.f);
+
+    //  Averages of the graph passes, the levels of each direction summed
+    GpuProfiler* _gpuProfiler = GpuProfiler::instance();
+
+    if (m_bloom)
+    {
+        float downsampleMs = 0.f;
+        float upsampleMs = 0.f;
+        for (int i = 0; i < m_bloomLevels; i++)
+        {
+            downsampleMs += _gpuProfiler->getAverageMs("Bloom downsample " + std::to_string(i));
+            upsampleMs += _gpuProfiler->getAverageMs("Bloom upsample " + std::to_string(i));
+        }
+
+        ImGui::Text("GPU Downsample : %.3f ms", downsampleMs);
+        ImGui::Text("GPU Upsample : %.3f ms", upsampleMs);
+    }
+    ImGui::Text("GPU Composite : %.3f ms", _gpuProfiler->getAverageMs("Composite"));
+}
@@ -0,0 +1,157 @@
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/RenderStats.hpp>
+
+#include <Core/MemoryTracker.hpp>
+
+#include <Resources/Shader.hpp>
+
+#include <vector>
+
+#include <imgui.h>
+
+#define QUAD_SIZE (4 * sizeof(QuadVertex))
+#define INDEX_BUFFER_SIZE (QUADS_PER_SEGMENT * 6 * sizeof(unsigned short))
+
+
+QuadBatcher::QuadBatcher()
+	: m_ring("Quads", GL_ARRAY_BUFFER, QUADS_PER_SEGMENT * QUAD_SIZE)
+{
+	//	Two triangles per quad, the same indices are reused by every draw through the base vertex
+	std::vector<unsigned short> indices(QUADS_PER_SEGMENT * 6);
+	for (int quad = 0; quad < QUADS_PER_SEGMENT; quad++)
+	{
+		unsigned short base = (unsigned short)(quad * 4);
+		unsigned short* index = &indices[quad * 6];
+
+		index[0] = base;		index[1] = base + 1;	index[2] = base + 2;
+		index[3] = base + 2;	index[4] = base + 3;	index[5] = base;
+	}
+
+	//	Create VAO - Vertex Array Object
+	glGenVertexArrays(1, &VAO);
+
+	//	Create EBO
+	glGenBuffers(1, &EBO);
+
+	GLState::instance()->bindVertexArray(VAO);
+
+	//	Vertices are read straight from the ring
+	glBindBuffer(GL_ARRAY_BUFFER, m_ring.getBuffer());
+
+	//	Position, texCoord & color
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (GLvoid*)offsetof(QuadVertex, position));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (GLvoid*)offsetof(QuadVertex, texCoords));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (GLvoid*)offsetof(QuadVertex, color));
+	glEnableVertexAttribArray(2);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE, indices.data(), GL_STATIC_DRAW);
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RENDERER, INDEX_BUFFER_SIZE);
+
+	GLState::instance()->bindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+QuadBatcher::~QuadBatcher()
+{
+	GLState::instance()->forgetVertexArray(VAO);
+
+	glDeleteBuffers(1, &EBO);
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RENDERER, -(long long)INDEX_BUFFER_SIZE);
+	glDeleteVertexArrays(1, &VAO);
+}
+
+void QuadBatcher::submit(Resources::Shader* shader, GLuint texture, const Maths::Vector3f corners[4], const Maths::Vector4f& uvRect, const Maths::Vector4f& color)
+{
+	if (!shader) return;
+
+	//	State change, draw what was collected so far
+	if (shader != m_runShader || texture != m_runTexture)
+	{
+		flush();
+		m_runShader = shader;
+		m_runTexture = texture;
+	}
+
+	//	The run must be drawn before the ring fences its segment
+	if (!m_ring.fits(QUAD_SIZE, sizeof(QuadVertex))) flush();
+
+	GpuRingBuffer::Range range = m_ring.allocate(QUAD_SIZE, sizeof(QuadVertex));
+	if (!range.data) return;
+
+	//	Quads of a segment are contiguous, the run grows until it's flushed
+	if (m_runCount == 0) m_runStart = (int)(range.offset / sizeof(QuadVertex));
+
+	const float texCoords[4][2] =
+	{
+		{ uvRect.x, uvRect.y },
+		{ uvRect.z, uvRect.y },
+		{ uvRect.z, uvRect.w },
+		{ uvRect.x, uvRect.w }
+	};
+
+	QuadVertex* vertex = (QuadVertex*)range.data;
+	for (int i = 0; i < 4; i++, vertex++)
+	{
+		vertex->position[0] = corners[i].x;
+		vertex->position[1] = corners[i].y;
+		vertex->position[2] = corners[i].z;
+		vertex->texCoords[0] = texCoords[i][0];
+		vertex->texCoords[1] = texCoords[i][1];
+		vertex->color[0] = color.x;
+		vertex->color[1] = color.y;
+		vertex->color[2] = color.z;
+		vertex->color[3] = color.w;
+	}
+
+	m_runCount += 4;
+	m_quadCount++;
+}
+
+void QuadBatcher::submit(Resources::Shader* shader, GLuint texture, const Maths::Mat4x4& model, const Maths::Vector2f& halfSize, const Maths::Vector4f& uvRect, const Maths::Vector4f& color)
+{
+	Maths::Vector3f corners[4] =
+	{
+		(model * Maths::Vector4f(-halfSize.x, -halfSize.y, 0.f, 1.f)).xyz,
+		(model * Maths::Vector4f( halfSize.x, -halfSize.y, 0.f, 1.f)).xyz,
+		(model * Maths::Vector4f( halfSize.x,  halfSize.y, 0.f, 1.f)).xyz,
+		(model * Maths::Vector4f(-halfSize.x,  halfSize.y, 0.f, 1.f)).xyz
+	};
+
+	submit(shader, texture, corners, uvRect, color);
+}
+
+void QuadBatcher::flush()
+{
+	if (m_runCount > 0 && m_runShader)
+	{
+		GLState* _glState = GLState::instance();
+
+		m_runShader->use();
+
+		_glState->bindTexture(GL_TEXTURE_2D, m_runTexture, 0);
+		_glState->bindVertexArray(VAO);
+
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_runCount / 4 * 6, GL_UNSIGNED_SHORT, (GLvoid*)0, m_runStart);
+		RenderStats::instance()->addDraw(m_runCount / 4, m_runCount / 4 * 2);
+
+		m_drawCount++;
+	}
+
+	m_runCount = 0;
+}
+
+void QuadBatcher::resetStats()
+{
+	m_quadCount = 0;
+	m_drawCount = 0;
+}
+
+void QuadBatcher::showImGui()
+{
+	ImGui::Text("Quads : %d", m_quadCount);
+	ImGui::Text("Draws : %d", m_drawCount);
+}
@@ -0,0 +1,37 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <LowRenderer/RenderDevice.hpp>
+
+
+RenderDevice* RenderDevice::s_device = nullptr;
+
+
+void RenderDevice::resetFrameStats()
+{
+	m_stats.drawCalls = 0;
+	m_stats.vertices = 0;
+	m_stats.uploadBytes = 0;
+}
+
+RenderDevice* RenderDevice::create(bool headless)
+{
+	kill();
+
+	if (headless)	s_device = new NullRenderDevice();
+	else			s_device = new GLRenderDevice();
+
+	return s_device;
+}
+
+void RenderDevice::kill()
+{
+	delete s_device;
+	s_device = nullptr;
+}
+
+
+bool GLRenderDevice::load()
+{
+	return gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) != 0;
+}
@@ -0,0 +1,455 @@
+#include <LowRenderer/RenderGraph.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/GpuProfiler.hpp>
+
+#include <Core/Window.hpp>
+#include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <imgui.h>
+
+
+//	Upload format, type and size of a pixel of an internal format
+static int getPixelFormat(GLenum internalFormat, GLenum& format, GLenum& type)
+{
+	switch (internalFormat)
+	{
+	case GL_R11F_G11F_B10F:			format = GL_RGB;				type = GL_FLOAT;			return 4;
+	case GL_RGBA16F:				format = GL_RGBA;				type = GL_FLOAT;			return 8;
+	case GL_RGBA8:					format = GL_RGBA;				type = GL_UNSIGNED_BYTE;	return 4;
+	case GL_DEPTH_COMPONENT24:		format = GL_DEPTH_COMPONENT;	type = GL_UNSIGNED_INT;		return 4;
+	case GL_DEPTH_COMPONENT32F:		format = GL_DEPTH_COMPONENT;	type = GL_FLOAT;			return 4;
+	default:						format = GL_RGBA;				type = GL_UNSIGNED_BYTE;	return 4;
+	}
+}
+
+static const char* getFormatName(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_R11F_G11F_B10F:			return "R11G11B10F";
+	case GL_RGBA16F:				return "RGBA16F";
+	case GL_RGBA8:					return "RGBA8";
+	case GL_DEPTH_COMPONENT24:		return "DEPTH24";
+	case GL_DEPTH_COMPONENT32F:		return "DEPTH32F";
+	default:						return "?";
+	}
+}
+
+
+//	Render Target Pool
+//	------------------
+
+RenderTargetPool::~RenderTargetPool()
+{
+	//	Memory of the run, to compare the passes and target formats
+	if (m_peakBytes > 0)
+	{
+		char line[128];
+		snprintf(line, sizeof(line), "Render targets : %d textures, %.2f MB (peak %.2f MB)",
+			(int)m_textures.size(), m_allocatedBytes / (1024.f * 1024.f), m_peakBytes / (1024.f * 1024.f));
+		Core::Log::instance()->write(line);
+	}
+
+	for (const PooledTexture& pooled : m_textures) destroy(pooled);
+	m_textures.clear();
+}
+
+bool RenderTargetPool::isDepthFormat(GLenum format)
+{
+	return format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F;
+}
+
+void RenderTargetPool::beginFrame()
+{
+	m_frame++;
+
+	for (size_t i = 0; i < m_textures.size();)
+	{
+		//	Targets only live within a frame
+		m_textures[i].inUse = false;
+
+		if (m_frame - m_textures[i].lastFrame > EVICT_FRAMES)
+		{
+			destroy(m_textures[i]);
+			m_textures.erase(m_textures.begin() + i);
+			continue;
+		}
+		i++;
+	}
+}
+
+GLuint RenderTargetPool::acquire(int width, int height, GLenum format)
+{
+	for (PooledTexture& pooled : m_textures)
+	{
+		if (pooled.inUse || pooled.width != width || pooled.height != height || pooled.format != format) continue;
+
+		pooled.inUse = true;
+		pooled.lastFrame = m_frame;
+		return pooled.texture;
+	}
+
+	GLState* _glState = GLState::instance();
+
+	PooledTexture pooled;
+	pooled.width = width;
+	pooled.height = height;
+	pooled.format = format;
+	pooled.inUse = true;
+	pooled.lastFrame = m_frame;
+
+	GLenum uploadFormat, uploadType;
+	int pixelSize = getPixelFormat(format, uploadFormat, uploadType);
+
+	glGenTextures(1, &pooled.texture);
+	_glState->bindTexture(GL_TEXTURE_2D, pooled.texture, 0);
+	glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, uploadFormat, uploadType, NULL);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	m_allocatedBytes += (size_t)width * height * pixelSize;
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RENDERER, (long long)width * height * pixelSize);
+	m_peakBytes = std::max(m_peakBytes, m_allocatedBytes);
+
+	m_textures.push_back(pooled);
+
+	return pooled.texture;
+}
+
+void RenderTargetPool::release(GLuint texture)
+{
+	for (PooledTexture& pooled : m_textures)
+	{
+		if (pooled.texture == texture) pooled.inUse = false;
+	}
+}
+
+GLuint RenderTargetPool::getFramebuffer(const std::vector<GLuint>& colors, GLuint depth)
+{
+	m_key.assign(colors.begin(), colors.end());
+	m_key.push_back(depth);
+
+	auto found = m_framebuffers.find(m_key);
+	if (found != m_framebuffers.end()) return found->second;
+
+	GLState* _glState = GLState::instance();
+
+	GLuint framebuffer;
+	glGenFramebuffers(1, &framebuffer);
+	_glState->bindFramebuffer(framebuffer);
+
+	std::vector<GLenum> drawBuffers;
+	for (size_t i = 0; i < colors.size(); i++)
+	{
+		if (colors[i]) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + (GLenum)i, GL_TEXTURE_2D, colors[i], 0);
+		drawBuffers.push_back(colors[i] ? GL_COLOR_ATTACHMENT0 + (GLenum)i : GL_NONE);
+	}
+
+	if (depth) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+
+	if (drawBuffers.empty())	glDrawBuffer(GL_NONE);
+	else						glDrawBuffers((GLsizei)drawBuffers.size(), drawBuffers.data());
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		Core::Log::instance()->writeError("RENDER GRAPH -> Incomplete frameBuffer");
+	}
+
+	m_framebuffers[m_key] = framebuffer;
+
+	return framebuffer;
+}
+
+void RenderTargetPool::destroy(const PooledTexture& pooled)
+{
+	GLState* _glState = GLState::instance();
+
+	for (auto it = m_framebuffers.begin(); it != m_framebuffers.end();)
+	{
+		if (std::find(it->first.begin(), it->first.end(), pooled.texture) == it->first.end())
+		{
+			it++;
+			continue;
+		}
+
+		_glState->forgetFramebuffer(it->second);
+		glDeleteFramebuffers(1, &it->second);
+		it = m_framebuffers.erase(it);
+	}
+
+	GLenum uploadFormat, uploadType;
+	int pixelSize = getPixelFormat(pooled.format, uploadFormat, uploadType);
+
+	m_allocatedBytes -= (size_t)pooled.width * pooled.height * pixelSize;
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RENDERER, -(long long)pooled.width * pooled.height * pixelSize);
+
+	_glState->forgetTexture(pooled.texture);
+	glDeleteTextures(1, &pooled.texture);
+}
+
+void RenderTargetPool::showImGui()
+{
+	ImGui::Text("Render targets : %d, %.2f MB (peak %.2f MB)", (int)m_textures.size(), m_allocatedBytes / (1024.f * 1024.f), m_peakBytes / (1024.f * 1024.f));
+	ImGui::Text("Framebuffers : %d", (int)m_framebuffers.size());
+
+	for (const PooledTexture& pooled : m_textures)
+	{
+		ImGui::BulletText("%d x %d %s", pooled.width, pooled.height, getFormatName(pooled.format));
+	}
+}
+
+
+//	Render Graph
+//	------------
+
+RenderGraph::RenderGraph()
+{
+	reset();
+}
+
+void RenderGraph::reset()
+{
+	m_passes.clear();
+	m_order.clear();
+	m_resources.clear();
+
+	ResourceNode backbuffer;
+	backbuffer.name = "Backbuffer";
+	m_resources.push_back(backbuffer);
+}
+
+RenderGraph::Resource RenderGraph::createTexture(const std::string& name, GLenum format, int downscale, float scale)
+{
+	ResourceNode resource;
+	resource.name = name;
+	resource.format = format;
+	resource.downscale = downscale;
+	resource.scale = scale;
+
+	m_resources.push_back(resource);
+
+	return (Resource)m_resources.size() - 1;
+}
+
+void RenderGraph::addPass(const std::string& name, const std::vector<Resource>& reads, const std::vector<Resource>& writes, std::function<void()> execute)
+{
+	PassNode pass;
+	pass.name = name;
+	pass.reads = reads;
+	pass.writes = writes;
+	pass.execute = execute;
+
+	m_passes.push_back(pass);
+}
+
+void RenderGraph::buildDependencies()
+{
+	Core::Log* _log = Core::Log::instance();
+
+	//	Last pass that wrote each resource, and the passes that read it since
+	std::vector<int> lastWriter(m_resources.size(), -1);
+	std::vector<std::vector<int>> readers(m_resources.size());
+
+	for (int p = 0; p < (int)m_passes.size(); p++)
+	{
+		PassNode& pass = m_passes[p];
+		pass.dependencies.clear();
+
+		for (Resource read : pass.reads)
+		{
+			if (lastWriter[read] < 0)
+			{
+				_log->writeWarning("RENDER GRAPH -> \"" + pass.name + "\" reads \"" + m_resources[read].name + "\" before any pass writes it");
+				continue;
+			}
+
+			pass.dependencies.push_back(lastWriter[read]);
+			readers[read].push_back(p);
+		}
+
+		for (Resource write : pass.writes)
+		{
+			//	Write after write : blending or a partial write keeps the previous content
+			if (lastWriter[write] >= 0) pass.dependencies.push_back(lastWriter[write]);
+
+			//	Write after read : the readers must be done with the previous content
+			for (int reader : readers[write])
+			{
+				if (reader != p) pass.dependencies.push_back(reader);
+			}
+
+			lastWriter[write] = p;
+			readers[write].clear();
+		}
+	}
+}
+
+void RenderGraph::compile()
+{
+	Core::Window* _window = Core::Window::instance();
+
+	buildDependencies();
+
+	//	Passes writing the backbuffer are the visible result, everything else
+	//	lives only if one of them depends on it
+	std::vector<int> stack;
+	for (int p = 0; p < (int)m_passes.size(); p++)
+	{
+		m_passes[p].live = std::find(m_passes[p].writes.begin(), m_passes[p].writes.end(), BACKBUFFER) != m_passes[p].writes.end();
+		if (m_passes[p].live) stack.push_back(p);
+	}
+
+	while (!stack.empty())
+	{
+		int p = stack.back();
+		stack.pop_back();
+
+		for (int dependency : m_passes[p].dependencies)
+		{
+			if (m_passes[dependency].live) continue;
+
+			m_passes[dependency].live = true;
+			stack.push_back(dependency);
+		}
+	}
+
+	//	Declaration order decides which write a read sees, the live passes keep it
+	m_order.clear();
+	for (int p = 0; p < (int)m_passes.size(); p++)
+	{
+		if (m_passes[p].live) m_order.push_back(p);
+	}
+
+	//	Lifetime of each target over the live passes
+	for (ResourceNode& resource : m_resources)
+	{
+		resource.firstUse = -1;
+		resource.lastUse = -1;
+		resource.read = false;
+		resource.texture = 0;
+
+		resource.width = getTargetSize(_window->m_width, resource.scale, resource.downscale);
+		resource.height = getTargetSize(_window->m_height, resource.scale, resource.downscale);
+	}
+
+	for (int k = 0; k < (int)m_order.size(); k++)
+	{
+		const PassNode& pass = m_passes[m_order[k]];
+
+		auto use = [&](Resource r)
+		{
+			ResourceNode& resource = m_resources[r];
+			if (resource.firstUse < 0) resource.firstUse = k;
+			resource.lastUse = k;
+		};
+
+		for (Resource read : pass.reads)
+		{
+			m_resources[read].read = true;
+			use(read);
+		}
+		for (Resource write : pass.writes) use(write);
+	}
+}
+
+void RenderGraph::bindTargets(const PassNode& pass)
+{
+	Core::Window* _window = Core::Window::instance();
+	GLState* _glState = GLState::instance();
+
+	if (std::find(pass.writes.begin(), pass.writes.end(), BACKBUFFER) != pass.writes.end())
+	{
+		_glState->bindFramebuffer(0);
+		glViewport(0, 0, _window->m_width, _window->m_height);
+		return;
+	}
+
+	m_colors.clear();
+	GLuint depth = 0;
+	const ResourceNode* sized = nullptr;
+
+	for (Resource write : pass.writes)
+	{
+		const ResourceNode& resource = m_resources[write];
+
+		if (RenderTargetPool::isDepthFormat(resource.format))	depth = resource.texture;
+		else													m_colors.push_back(resource.texture);
+
+		if (!sized && resource.texture) sized = &resource;
+	}
+
+	_glState->bindFramebuffer(RenderTargetPool::instance()->getFramebuffer(m_colors, depth));
+
+	if (sized) glViewport(0, 0, sized->width, sized->height);
+}
+
+void RenderGraph::execute()
+{
+	Core::Window* _window = Core::Window::instance();
+	RenderTargetPool* _pool = RenderTargetPool::instance();
+
+	_pool->beginFrame();
+
+	for (int k = 0; k < (int)m_order.size(); k++)
+	{
+		const PassNode& pass = m_passes[m_order[k]];
+
+		//	Color targets nobody reads aren't allocated, their draw buffer is GL_NONE
+		for (Resource r = 1; r < (Resource)m_resources.size(); r++)
+		{
+			ResourceNode& resource = m_resources[r];
+			if (resource.firstUse != k) continue;
+			if (!resource.read && !RenderTargetPool::isDepthFormat(resource.format)) continue;
+
+			resource.texture = _pool->acquire(resource.width, resource.height, resource.format);
+		}
+
+		{
+			GpuScope scope(pass.name);
+
+			bindTargets(pass);
+			pass.execute();
+		}
+
+		//	Past its last use, the texture can back a later target
+		for (Resource r = 1; r < (Resource)m_resources.size(); r++)
+		{
+			ResourceNode& resource = m_resources[r];
+			if (resource.lastUse == k && resource.texture) _pool->release(resource.texture);
+		}
+	}
+
+	GLState::instance()->bindFramebuffer(0);
+	glViewport(0, 0, _window->m_width, _window->m_height);
+}
+
+int RenderGraph::getTargetSize(int windowSize, float scale, int downscale)
+{
+	return std::max((int)(windowSize * scale) >> downscale, 1);
+}
+
+GLuint RenderGraph::getTexture(Resource resource) const
+{
+	return m_resources[resource].texture;
+}
+
+void RenderGraph::showImGui()
+{
+	ImGui::Text("Passes : %d, %d culled", (int)m_passes.size(), (int)(m_passes.size() - m_order.size()));
+
+	for (const PassNode& pass : m_passes)
+	{
+		if (pass.live)	ImGui::BulletText("%s", pass.name.c_str());
+		else			ImGui::BulletText("%s (culled)", pass.name.c_str());
+	}
+
+	ImGui::Separator();
+	RenderTargetPool::instance()->showImGui();
+}
@@ -0,0 +1,157 @@
+#include <LowRenderer/RenderStats.hpp>
+#include <LowRenderer/GpuRingBuffer.hpp>
+
+#include <Core/Log.hpp>
+
+#include <imgui.h>
+
+#include <fstream>
+
+
+RenderStats::~RenderStats()
+{
+	//	Runs closed before the end keep what they captured
+	if (!m_capture.empty()) writeCapture();
+}
+
+void RenderStats::beginFrame()
+{
+	m_frame = FrameStats();
+}
+
+void RenderStats::endFrame(const FrameStats& extracted)
+{
+	FrameStats frame = m_frame;
+
+	frame.streamedBytes = GpuRingBuffer::getFrameBytes();
+
+	frame.visibleObjects = extracted.visibleObjects;
+	frame.culledObjects = extracted.culledObjects;
+	frame.particlesSimulated = extracted.particlesSimulated;
+	frame.particlesDrawn = extracted.particlesDrawn;
+	frame.glyphs = extracted.glyphs;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_history[m_next] = frame;
+	m_next = (m_next + 1) % HISTORY;
+	if (m_count < HISTORY) m_count++;
+
+	if (m_captureFrames > 0)
+	{
+		m_capture.push_back(frame);
+		if ((int)m_capture.size() >= m_captureFrames) writeCapture();
+	}
+}
+
+void RenderStats::startCapture(int frameCount, const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_captureFrames = frameCount;
+	m_capturePath = path;
+
+	m_capture.clear();
+	m_capture.reserve(frameCount);
+
+	Core::Log::instance()->write("+ Capturing the render stats of " + std::to_string(frameCount) + " frames in " + path);
+}
+
+void RenderStats::writeCapture()
+{
+	Core::Log* _log = Core::Log::instance();
+
+	std::ofstream file(m_capturePath);
+	if (!file)
+	{
+		_log->writeError("Can't write the render stats in " + m_capturePath);
+	}
+	else
+	{
+		file << "frame,draw_calls,instances,triangles,shader_binds,texture_binds,uniform_uploads,streamed_bytes,"
+			"visible_objects,culled_objects,particles_simulated,particles_drawn,glyphs\n";
+
+		for (size_t i = 0; i < m_capture.size(); i++)
+		{
+			const FrameStats& frame = m_capture[i];
+
+			char line[256];
+			snprintf(line, sizeof(line), "%d,%d,%d,%lld,%d,%d,%d,%lld,%d,%d,%d,%d,%d\n", (int)i,
+				frame.drawCalls, frame.instances, frame.triangles, frame.shaderBinds, frame.textureBinds, frame.uniformUploads, frame.streamedBytes,
+				frame.visibleObjects, frame.culledObjects, frame.particlesSimulated, frame.particlesDrawn, frame.glyphs);
+
+			file << line;
+		}
+
+		_log->writeSuccess("Render stats of " + std::to_string(m_capture.size()) + " frames saved in " + m_capturePath);
+	}
+
+	m_capture.clear();
+	m_captureFrames = 0;
+}
+
+void RenderStats::showCounters()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_count == 0)
+	{
+		ImGui::Text("No frame drawn yet");
+		return;
+	}
+
+	const FrameStats& last = m_history[(m_next + HISTORY - 1) % HISTORY];
+
+	//	Averages of the kept frames
+	double sum[12] = {};
+	for (int i = 0; i < m_count; i++)
+	{
+		const FrameStats& frame = m_history[i];
+		const long long values[12] = { frame.drawCalls, frame.instances, frame.triangles, frame.shaderBinds, frame.textureBinds, frame.uniformUploads,
+			frame.streamedBytes, frame.visibleObjects, frame.culledObjects, frame.particlesSimulated, frame.particlesDrawn, frame.glyphs };
+
+		for (int k = 0; k < 12; k++) sum[k] += (double)values[k];
+	}
+
+	const long long values[12] = { last.drawCalls, last.instances, last.triangles, last.shaderBinds, last.textureBinds, last.uniformUploads,
+		last.streamedBytes, last.visibleObjects, last.culledObjects, last.particlesSimulated, last.particlesDrawn, last.glyphs };
+
+	static const char* const names[12] = { "Draw calls", "Instances", "Triangles", "Shader binds", "Texture binds", "Uniform uploads",
+		"Streamed bytes", "Visible objects", "Culled objects", "Particles simulated", "Particles drawn", "Glyphs" };
+
+	ImGui::Columns(3, "Render stats", false);
+	ImGui::Text("Counter");		ImGui::NextColumn();
+	ImGui::Text("Frame");		ImGui::NextColumn();
+	ImGui::Text("Average");		ImGui::NextColumn();
+
+	for (int k = 0; k < 12; k++)
+	{
+		ImGui::Text("%s", names[k]);							ImGui::NextColumn();
+		ImGui::Text("%lld", values[k]);							ImGui::NextColumn();
+		ImGui::Text("%.1f", sum[k] / m_count);					ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+
+	if (m_captureFrames > 0) ImGui::Text("Capturing : %d / %d frames", (int)m_capture.size(), m_captureFrames);
+}
+
+void RenderStats::showImGui()
+{
+	ImGui::Checkbox("Overlay", &m_overlay);
+	showCounters();
+}
+
+void RenderStats::showOverlay()
+{
+	if (!m_overlay) return;
+
+	ImGui::SetNextWindowPos(ImVec2(10.f, 10.f), ImGuiCond_Always);
+	ImGui::SetNextWindowBgAlpha(0.6f);
+
+	ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+		| ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoDocking;
+
+	if (ImGui::Begin("Render stats overlay", &m_overlay, flags)) showCounters();
+	ImGui::End();
+}
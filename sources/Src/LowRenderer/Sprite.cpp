@@ -1,4 +1,5 @@
 #include <LowRenderer/Sprite.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
 
 #include <Engine/Transform3.hpp>
 #include <Engine/GameObject.hpp>
@@ -22,142 +23,72 @@
 Sprite::Sprite(GameObject* in_gameObject) : Component(in_gameObject)
 {
     init(ComponentType::Sprite);
-    initRenderData();
 
     int i = (int)m_gameObject->m_sceneReference->m_rendererManager.m_spriteList.size();
     m_gameObject->m_sceneReference->m_rendererManager.m_spriteList[i] = this;
 
-    m_texture = 0; 
-
     Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
 
     Resources::loadShader("Sprite");
     m_shader = &_resources->m_shaderName_shader["Sprite"];
-
-    m_shader->use();
-    m_shader->setInt("Image", 0);
 }
 
 Sprite::Sprite(const char* path, const char* name) 
 {
-    initRenderData();
-
     Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
-    m_texture = 0;
+
     Resources::loadShader("Sprite");
     m_shader = &_resources->m_shaderName_shader["Sprite"];
 
-    m_shader->use();
-    m_shader->setInt("Image", 0);
-
-    m_texture = _resources->loadTexture(path, name);
+    setTexture(path, name);
 
     m_default_color = m_color = Vector3f::one();
 }
 
-void Sprite::initRenderData()
+void Sprite::setTexture(const std::string& path, const std::string& name)
 {
-    float wCoef = Core::Window::instance()->m_windowCoef * .5f;
-
-    float vertices[] = {
-        // pos      // tex
-        -wCoef,  0.5f, 0.0f, 1.0f,
-         wCoef, -0.5f, 1.0f, 0.0f,
-        -wCoef, -0.5f, 0.0f, 0.0f,
-
-        -wCoef,  0.5f, 0.0f, 1.0f,
-         wCoef,  0.5f, 1.0f, 1.0f,
-         wCoef, -0.5f, 1.0f, 0.0f
-    };
-
-    // configure VAO/VBO
-    unsigned int VBO;
-
-    //	Create VAO - Vertex Array Object
-    glGenVertexArrays(1, &VAO);
-
-    //	Create VBO - Vertex Buffer Object
-    glGenBuffers(1, &VBO);
-
-    //	Define VBO and VAO
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
 
-    //	Attach VBO to VAO / Bind attributes (texCoord) in VAO
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    m_texturePath = path;
 
-    //	Position & texCoord
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    //  Packed textures are never loaded on their own
+    m_atlasRegion = _resources->getAtlasRegion(name);
+    m_texture = m_atlasRegion ? nullptr : _resources->loadTexture(path, name);
 }
 
-
-void Sprite::updateRenderData()
+bool Sprite::getQuad(QuadItem& item) const
 {
-    Core::Window* _window = Core::Window::instance();
-
-    //  if window wasn't reshaped exit
-    if (_window->m_wasReshaped == false) return;
+    if (!m_shader || (!m_texture && !m_atlasRegion)) return false;
 
-    float wCoef = _window->m_windowCoef * .5f;
-
-    float vertices[] = {
-        // pos      // tex
-        -wCoef,  0.5f, 0.0f, 1.0f,
-         wCoef, -0.5f, 1.0f, 0.0f,
-        -wCoef, -0.5f, 0.0f, 0.0f,
-
-        -wCoef,  0.5f, 0.0f, 1.0f,
-         wCoef,  0.5f, 1.0f, 1.0f,
-         wCoef, -0.5f, 1.0f, 0.0f
-    };
-
-    // configure VAO/VBO
-    unsigned int VBO;
-
-    //	Create VBO - Vertex Buffer Object
-    glGenBuffers(1, &VBO);
-
-    //	Define VBO and VAO
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    //	Attach VBO to VAO / Bind attributes (texCoord) in VAO
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    //  Quad width follows the window ratio
+    float wCoef = Core::Window::instance()->m_windowCoef * .5f;
 
-    //	Position & texCoord
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
+    item.shader = m_shader;
+    item.texture = m_atlasRegion ? m_atlasRegion->page->getID() : m_texture->getID();
+    item.model = m_transform->getTransformMatrix();
+    item.halfSize = { wCoef, 0.5f };
+    item.uvRect = m_atlasRegion ? m_atlasRegion->uvRect : Maths::Vector4f(0.f, 0.f, 1.f, 1.f);
+    item.color = { m_color, 1.f };
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    return true;
 }
 
 void Sprite::draw()
 {
-    if (m_shader && m_texture)
-    {
-        updateRenderData();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glEnable(GL_BLEND);
+    QuadItem item;
+    if (!getQuad(item)) return;
 
-        m_shader->use();
-
-        m_shader->setMat4("Model", m_transform->getTransformMatrix());
-        m_shader->setFloat3("SpriteColor", m_color);
-        m_color = m_default_color;
-
-        m_texture->bind(GL_TEXTURE0);
+    QuadBatcher::instance()->submit(item);
+    m_color = m_default_color;
+}
 
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
+void Sprite::gatherHUD(std::vector<QuadItem>& items)
+{
+    QuadItem item;
+    if (!getQuad(item)) return;
 
-        glDisable(GL_BLEND);
-    }
+    items.push_back(item);
+    m_color = m_default_color;
 }
 
 void Sprite::destroy()
@@ -199,7 +130,7 @@ void Sprite::destroy()
 
 void Sprite::saveComponentInSCNFile(std::ofstream& file)
 {
-    file << "SPRITE\t\t" << m_texture->m_path << m_texture->m_name << ".png" << " ";
+    file << "SPRITE\t\t" << m_texturePath << " ";
     FileWriter::writeVec3InFile(file, m_color);
     file << "\n";
 }
@@ -210,12 +141,10 @@ void Sprite::loadComponentFromSCNFile(std::istringstream& lineStream)
     Core::Log* _log = Core::Log::instance();
     _log->write("+\t Adding Sprite to new gameObject");
 
-    Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
-    
     std::string path = FileParser::getString(lineStream);
     std::string name = Extractor::ExtractNameWithoutExtension(Extractor::ExtractFilename(path));
 
-    m_texture = _resources->loadTexture(path, name);
+    setTexture(path, name);
 
     lineStream.ignore();
     m_default_color = m_color = FileParser::getVector3(lineStream);
@@ -228,7 +157,7 @@ void Sprite::showImGUI()
     if (ImGui::SliderFloat3("Color", &m_color.x, 0, 1.f)) m_default_color = m_color;
     if (m_texture) m_texture->showImGui();
 
-    std::string textureName = m_texture ? m_texture->m_name : "none";
+    std::string textureName = m_texture ? m_texture->m_name : m_atlasRegion ? m_texturePath : "none";
 
     if (ImGui::BeginCombo("Texture", textureName.c_str()))
     {
@@ -239,6 +168,8 @@ void Sprite::showImGUI()
             if (ImGui::Selectable(textName.first.c_str()))
             {
                 m_texture = &_resources->m_textureName_texture[textName.first];
+                m_atlasRegion = nullptr;
+                m_texturePath = m_texture->m_path + m_texture->m_name + ".png";
             }
         }
         ImGui::EndCombo();
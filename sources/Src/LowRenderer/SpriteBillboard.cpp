@@ -12,6 +12,8 @@
 #include <Resources/Scene.hpp>
 #include <Maths/Matrix.h>
 
+#include <LowRenderer/TranslucentPass.hpp>
+
 #include <Utils/File.h>
 #include <Utils/StringExtractor.h>
 
@@ -22,7 +24,6 @@
 SpriteBillboard::SpriteBillboard(GameObject* in_gameObject) : Component(in_gameObject)
 {
     init(ComponentType::SpriteBillboard);
-    initRenderData();
 
     int i = (int)m_gameObject->m_sceneReference->m_rendererManager.m_spriteBillboardList.size();
     m_gameObject->m_sceneReference->m_rendererManager.m_spriteBillboardList[i] = this;
@@ -34,57 +35,11 @@ SpriteBillboard::SpriteBillboard(GameObject* in_gameObject) : Component(in_gameO
 }
 
 
-void SpriteBillboard::draw() 
+void SpriteBillboard::gatherTranslucent(TranslucentPass& pass) const
 {
 	if (!m_shader || !m_material) return;
 
-	m_shader->use();
-    m_shader->setMaterial(*m_material);
-
-	m_shader->setFloat4("ParticleColor", m_color);
-	m_shader->setMat4("Model", m_transform->getTransformMatrix());
-
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-
-	glBindVertexArray(0);
-}
-
-void SpriteBillboard::initRenderData()
-{
-    // configure VAO/VBO
-    unsigned int VBO;
-    float vertices[] = {
-        // pos      // tex
-        -0.5f,  0.5f, 0.0f, 1.0f,
-         0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f, 0.0f, 0.0f,
-
-       -0.5f,  0.5f, 0.0f, 1.0f,
-         0.5f,  0.5f, 1.0f, 1.0f,
-         0.5f, -0.5f, 1.0f, 0.0f
-    };
-
-
-    //	Create VAO - Vertex Array Object
-    glGenVertexArrays(1, &VAO);
-
-    //	Create VBO - Vertex Buffer Object
-    glGenBuffers(1, &VBO);
-
-    //	Define VBO and VAO
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    //	Attach VBO to VAO / Bind attributes (texCoord) in VAO
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    //	Position & texCoord
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+	pass.submit(m_shader, 0, m_material, m_transform->getTransformMatrix(), m_color);
 }
 
 void SpriteBillboard::destroy()
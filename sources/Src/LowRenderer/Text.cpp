@@ -1,8 +1,17 @@
 #include<LowRenderer/Text.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/RenderStats.hpp>
 #include <Resources/ResourcesManager.hpp>
 #include <Core/Window.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/FrameArena.hpp>
 
-TextRender::TextRender()
+#include <cstring>
+
+#define GLYPH_SIZE (sizeof(float) * 6 * 4)
+#define GLYPHS_PER_SEGMENT 1024
+
+TextRender::TextRender() : m_ring("Text", GL_ARRAY_BUFFER, GLYPHS_PER_SEGMENT * GLYPH_SIZE, Core::MemoryTag::TEXT)
 {
 	Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
 	Resources::loadShader("Text");
@@ -11,23 +20,22 @@ TextRender::TextRender()
     m_shader->setInt("Text", 0);
 
 	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+	GLState::instance()->bindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_ring.getBuffer());
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::instance()->bindVertexArray(0);
 }
 
 
 void TextRender::RenderText(const TextParameter& render)
 {
     float windowCoef = Core::Window::instance()->m_windowCoef;
+    GLState* _glState = GLState::instance();
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    _glState->enable(GL_BLEND);
+    _glState->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     Resources::ResourcesManager* _resources = Resources::ResourcesManager::instance();
 
@@ -41,18 +49,18 @@ void TextRender::RenderText(const TextParameter& render)
     m_shader->use();
     m_shader->setFloat3("TextColor", render.color);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    _glState->bindVertexArray(VAO);
 
     //  Iterate through all characters
 
-    std::string::const_iterator c;
-
     float x = render.pos.x;
 
-    for (c = render.text.begin(); c != render.text.end(); c++)
+    //  Font looked up once, not per character
+    Resources::FontCharacter& characters = _resources->m_characterListPerFonts[render.font];
+
+    for (const char* c = render.text; *c; c++)
     {
-        Resources::Character ch = _resources->m_characterListPerFonts[render.font][*c];
+        Resources::Character ch = characters[*c];
 
         float xpos = x + ch.Bearing.x * render.size;
         float ypos = render.pos.y - (ch.Size.y - ch.Bearing.y) * render.size;
@@ -60,7 +68,10 @@ void TextRender::RenderText(const TextParameter& render)
         float w = ch.Size.x * render.size * windowCoef;
         float h = ch.Size.y * render.size;
 
-        //  Update VBO for each character
+        //  Write the glyph quad straight in the ring
+
+        GpuRingBuffer::Range range = m_ring.allocate(GLYPH_SIZE, 4 * sizeof(float));
+        if (!range.data) break;
 
         float vertices[6][4] = {
             { xpos,     ypos + h,   0.0f, 0.0f },
@@ -74,34 +85,32 @@ void TextRender::RenderText(const TextParameter& render)
 
         //  Render glyph texture over quad
 
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-        //  Update content of VBO memory
+        _glState->bindTexture(GL_TEXTURE_2D, ch.TextureID, 0);
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        memcpy(range.data, vertices, sizeof(vertices));
 
         //  Render quad
 
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glDrawArrays(GL_TRIANGLES, (GLint)(range.offset / (4 * sizeof(float))), 6);
+        RenderStats::instance()->addDraw(1, 2);
 
         //  Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
 
         x += (ch.Advance >> 6) * render.size; //    Bitshift by 6 to get value in pixels (2^6 = 64)
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glDisable(GL_BLEND);
+    _glState->disable(GL_BLEND);
 }
 
-void TextRender::AddText(const std::string& font, const std::string& text, const Maths::Vector2f& pos, float scale, const Maths::Vector3f& color)
+void TextRender::AddText(const char* font, const char* text, const Maths::Vector2f& pos, float scale, const Maths::Vector3f& color)
 {
+    MEMORY_TAG(TEXT);
+
+    Core::FrameArena& arena = Core::FrameArena::get();
+
     m_textBuffer.push_back(
         {
-            font,
-            text,
+            arena.copy(font),
+            arena.copy(text),
             pos,
             scale / 100.f,
             color
@@ -111,10 +120,23 @@ void TextRender::AddText(const std::string& font, const std::string& text, const
 
 void TextRender::RenderTextBuffer()
 {
-    for (TextParameter text : m_textBuffer)
+    RenderTexts(m_textBuffer);
+
+    m_textBuffer.clear();
+}
+
+void TextRender::TakeTextBuffer(std::vector<TextParameter>& texts)
+{
+    texts.swap(m_textBuffer);
+    m_textBuffer.clear();
+}
+
+void TextRender::RenderTexts(const std::vector<TextParameter>& texts)
+{
+    MEMORY_TAG(TEXT);
+
+    for (const TextParameter& text : texts)
     {
         RenderText(text);
     }
-
-    m_textBuffer.clear();
 }
\ No newline at end of file
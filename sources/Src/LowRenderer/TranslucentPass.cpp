@@ -0,0 +1,95 @@
+#include <LowRenderer/TranslucentPass.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/GLState.hpp>
+
+#include <Resources/Shader.hpp>
+#include <Resources/Material.hpp>
+
+#include <imgui.h>
+
+
+void TranslucentPass::begin(const Maths::Mat4x4& view)
+{
+	m_view = view;
+
+	//	clear() keeps the capacity, steady frames don't reallocate
+	m_items.clear();
+	m_keys.clear();
+}
+
+void TranslucentPass::submit(Resources::Shader* shader, unsigned int featureKey, const Resources::Material* material, const Maths::Mat4x4& model, const Maths::Vector4f& color)
+{
+	if (!shader || !material) return;
+
+	//	View space depth of the quad center (column-major, translation in c[3])
+	//	Further quads have a lower z, so an ascending sort gives back to front
+	const Maths::Vector4f& position = model.c[3];
+	float viewZ = m_view.c[0].e[2] * position.e[0]
+				+ m_view.c[1].e[2] * position.e[1]
+				+ m_view.c[2].e[2] * position.e[2]
+				+ m_view.c[3].e[2];
+
+	TranslucentItem item;
+	item.shader = shader;
+	item.featureKey = featureKey;
+	item.texture = material->m_text_diffuse.getTextureID();
+	item.model = model;
+	item.color = color;
+
+	m_items.push_back(item);
+	m_keys.push_back(viewZ);
+}
+
+void TranslucentPass::draw()
+{
+	if (m_items.empty()) return;
+
+	const unsigned int* order = m_sorter.sort(m_keys.data(), (unsigned int)m_keys.size());
+
+	//	Camera axes in world space (rows of the view matrix) to face the quads
+	Maths::Vector4f right = { m_view.c[0].e[0], m_view.c[1].e[0], m_view.c[2].e[0], 0.f };
+	Maths::Vector4f up    = { m_view.c[0].e[1], m_view.c[1].e[1], m_view.c[2].e[1], 0.f };
+
+	const Maths::Vector4f uvRect = { 0.f, 0.f, 1.f, 1.f };
+
+	QuadBatcher* _batcher = QuadBatcher::instance();
+
+	//	Consecutive quads mostly come from the same system
+	Resources::Shader* shader = nullptr;
+	Resources::Shader* variant = nullptr;
+	unsigned int featureKey = 0;
+
+	//	Depth is still tested against the opaque scene but quads don't hide each other
+	GLState::instance()->depthMask(false);
+
+	for (size_t i = 0; i < m_items.size(); i++)
+	{
+		const TranslucentItem& item = m_items[order[i]];
+
+		Maths::Vector3f corners[4] =
+		{
+			(item.model * Maths::Vector4f(-0.5f * right.xyz - 0.5f * up.xyz, 1.f)).xyz,
+			(item.model * Maths::Vector4f( 0.5f * right.xyz - 0.5f * up.xyz, 1.f)).xyz,
+			(item.model * Maths::Vector4f( 0.5f * right.xyz + 0.5f * up.xyz, 1.f)).xyz,
+			(item.model * Maths::Vector4f(-0.5f * right.xyz + 0.5f * up.xyz, 1.f)).xyz
+		};
+
+		if (item.shader != shader || item.featureKey != featureKey)
+		{
+			shader = item.shader;
+			featureKey = item.featureKey;
+			variant = shader->getVariant(featureKey);
+		}
+
+		_batcher->submit(variant, item.texture, corners, uvRect, item.color);
+	}
+
+	_batcher->flush();
+
+	GLState::instance()->depthMask(true);
+}
+
+void TranslucentPass::showImGui() const
+{
+	ImGui::Text("Quads : %d", (int)m_items.size());
+}
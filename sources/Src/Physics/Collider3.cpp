@@ -30,7 +30,7 @@ Collider3::Collider3(GameObject* in_gameObject) : Component(in_gameObject)
 
 Collider3::~Collider3()
 {
-	Component::~Component();
+
 }
 
 
@@ -103,8 +103,7 @@ void SphereCollider3D::saveComponentInSCNFile(std::ofstream& file)
 void SphereCollider3D::loadComponentFromSCNFile(std::istringstream& lineStream)
 {
 	//	Write in log
-	Core::Log* _log = Core::Log::instance();
-	_log->write("+\t Adding sphere collider 3D to new gameObject");
+	LOG_INFO(LOADING, "+\t Adding sphere collider 3D to new gameObject");
 
 	collider.m_center = FileParser::getVector3(lineStream);
 
@@ -237,8 +236,7 @@ void BoxCollider3D::saveComponentInSCNFile(std::ofstream& file)
 void BoxCollider3D::loadComponentFromSCNFile(std::istringstream& lineStream)
 {
 	//	Write in log
-	Core::Log* _log = Core::Log::instance();
-	_log->write("+\t Adding box collider 3D to new gameObject");
+	LOG_INFO(LOADING, "+\t Adding box collider 3D to new gameObject");
 
 	//	Set Rotation Coordinate
 	//	-----------------------
@@ -78,7 +78,7 @@ void OctreeNode::scanColliders(std::vector<Collider3*>& colliders)
 
 }
 
-void OctreeNode::getPotentialColliders(Collider3* target, std::vector<Collider3*>& potentialColliders)
+void OctreeNode::getPotentialColliders(Collider3* target, Core::FrameVector<Collider3*>& potentialColliders)
 {
 	//if (!is_sphere_intersecting_AABB(AABB, sphere))
 	//	return;
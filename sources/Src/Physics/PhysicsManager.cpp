@@ -7,12 +7,20 @@
 #include <Physics/Collision.hpp>
 using namespace Physics;
 #include <Core/TimeManager.h>
+#include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/FrameArena.hpp>
+
+#define COLLIDERS_RESERVE 64	// Static colliders expected near a rigidbody, the list rarely grows past it
 
 void PhysicsManager::initialize()
 {
 	m_collidersStatic.clear();
 	m_collidersDynamic.clear();
 	m_rigidbodies.clear();
+	m_distanceField.clear();
+	m_distanceFieldDirty = false;
 }
 
 void PhysicsManager::setUp()
@@ -25,12 +33,66 @@ void PhysicsManager::setUp()
 	m_octree.generate(5);
 }
 
+static bool isStaticBox(Collider3* collider)
+{
+	if (collider == nullptr || collider->m_isTrigger || collider->m_type != ColliderType::BOX)
+		return false;
+
+	// Boxes without rigidbody never move
+	Rigidbody3* rb = nullptr;
+	return !collider->m_gameObject->tryGetComponent<Rigidbody3>(&rb);
+}
+
+void PhysicsManager::bakeDistanceField()
+{
+	m_distanceField.clear();
+
+	for (Collider3* collider : m_collidersDynamic)
+	{
+		if (collider == nullptr)
+			continue;
+
+		collider->m_baked = isStaticBox(collider);
+		if (!collider->m_baked)
+			continue;
+
+		BoxCollider3D* col = (BoxCollider3D*)collider;
+
+		Box box = col->collider;
+		box.m_center += col->m_gameObject->m_transform->m_position;
+		box.m_rotation = quaternionFromEuler(col->m_transform->m_rotation);
+		box.m_extension = { col->collider.m_extension.x * col->m_transform->m_scale.x,
+							col->collider.m_extension.y * col->m_transform->m_scale.y,
+							col->collider.m_extension.z * col->m_transform->m_scale.z };
+
+		m_distanceField.addBox(box, collider->m_physicsMat);
+	}
+
+	m_distanceField.bake();
+	m_distanceFieldDirty = false;
+
+	Core::Log::instance()->write("Distance field baked : " + std::to_string(m_distanceField.getBoxCount()) + " static boxes, "
+		+ std::to_string(m_distanceField.getBrickCount()) + " bricks, " + std::to_string(m_distanceField.getMemorySize() / 1024) + " KB");
+}
+
+const SignedDistanceField* PhysicsManager::getDistanceField()
+{
+	if (m_distanceFieldDirty)
+		bakeDistanceField();
+
+	return &m_distanceField;
+}
+
 void PhysicsManager::registerCollider(Collider3* collider)
 {
 	//if (collider->is_static)
 	// m_collidersStatic.push_back(collider);
 	//else
 	m_collidersDynamic.push_back(collider);
+
+	collider->m_baked = false;
+	if (isStaticBox(collider))
+		m_distanceFieldDirty = true;
 }
 
 void PhysicsManager::registerRigidbody(Rigidbody3* rb)
@@ -44,6 +106,10 @@ void PhysicsManager::unregisterCollider(Collider3* collider)
 	{
 		if (m_collidersDynamic[i] == collider)
 		{
+			// Called from collider destructors, only the flag set by the bake is read
+			if (collider->m_baked)
+				m_distanceFieldDirty = true;
+
 			m_collidersDynamic[i] = m_collidersDynamic.back();
 			m_collidersDynamic.pop_back();
 			return;
@@ -68,6 +134,9 @@ void PhysicsManager::unregisterRigidbody(Rigidbody3* rb)
 
 void PhysicsManager::processPhysics()
 {
+	PROFILE_SCOPE("Physics");
+	MEMORY_TAG(PHYSICS);
+
 	// Preventif : remove nullptr in vectors
 	m_rigidbodies.erase(std::remove(m_rigidbodies.begin(), m_rigidbodies.end(), nullptr), m_rigidbodies.end());
 	m_collidersDynamic.erase(std::remove(m_collidersDynamic.begin(), m_collidersDynamic.end(), nullptr), m_collidersDynamic.end());
@@ -84,17 +153,15 @@ void PhysicsManager::processPhysics()
 		sphere.m_center += origin;
 
 
-		// Compute static colliders
-		std::vector<Collider3*> potentialStaticColliders;
-		m_octree.getPotentialColliders(rb->m_collider, potentialStaticColliders);
+		// Create all-colliders list, in the frame arena : built again for each rigidbody of each step
+		Core::FrameVector<Collider3*> collidersToCheck;
+		collidersToCheck.reserve(m_collidersDynamic.size() + m_rigidbodies.size() + COLLIDERS_RESERVE);
 
-
-		// Create all-colliders list
-		std::vector<Collider3*> collidersToCheck;
 		for (auto& col : m_collidersDynamic)
 			collidersToCheck.push_back(col);
-		for (auto& col : potentialStaticColliders)
-			collidersToCheck.push_back(col);
+
+		// Compute static colliders
+		m_octree.getPotentialColliders(rb->m_collider, collidersToCheck);
 
 		for (Rigidbody3* other : m_rigidbodies)
 		{
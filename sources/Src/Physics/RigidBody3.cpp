@@ -36,8 +36,6 @@ Rigidbody3::~Rigidbody3()
 	Resources::Scene* scene = Core::Graph::instance()->getCurrentScene();
 	if (scene)
 		scene->m_physicsManager.unregisterRigidbody(this);
-
-	Component::~Component();
 }
 
 void Rigidbody3::awake()
@@ -0,0 +1,296 @@
+#include <Physics/SignedDistanceField.hpp>
+using namespace Physics;
+
+#include <Maths/Quaternion.h>
+
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <algorithm>
+#include <unordered_map>
+
+#define MAX_TOP_LEVEL_BRICKS (1 << 21)
+
+
+void SignedDistanceField::clear()
+{
+	m_boxes.clear();
+	m_materials.clear();
+	m_brickIndices.clear();
+	m_bricks.clear();
+
+	m_dimensions[0] = m_dimensions[1] = m_dimensions[2] = 0;
+	m_baked = false;
+}
+
+void SignedDistanceField::addBox(const Box& box, const PhysicsMaterial& material)
+{
+	m_boxes.push_back(box);
+	m_materials.push_back(material);
+	m_baked = false;
+}
+
+size_t SignedDistanceField::getMemorySize() const
+{
+	return m_brickIndices.size() * sizeof(int) + m_bricks.size() * sizeof(Brick);
+}
+
+float SignedDistanceField::boxDistance(const OrientedBox& box, const Vector3f& point) const
+{
+	Vector3f toPoint = point - box.center;
+
+	// Distance of the point in the box referential to its faces
+	Vector3f q = { fabsf(dotProduct(toPoint, box.axis[0])) - box.extension.x,
+				   fabsf(dotProduct(toPoint, box.axis[1])) - box.extension.y,
+				   fabsf(dotProduct(toPoint, box.axis[2])) - box.extension.z };
+
+	Vector3f outside = { max(q.x, 0.f), max(q.y, 0.f), max(q.z, 0.f) };
+	float inside = min(max(q.x, max(q.y, q.z)), 0.f);
+
+	return outside.length() + inside;
+}
+
+bool SignedDistanceField::bakeBrick(const int brick[3], const std::vector<OrientedBox>& boxes, const std::vector<int>& candidates, Brick& out) const
+{
+	Vector3f brickOrigin = m_origin + Vector3f{ (float)brick[0], (float)brick[1], (float)brick[2] } * m_brickSize;
+
+	bool allSolid = true;
+
+	int sampleIndex = 0;
+	for (int z = 0; z < BRICK_SAMPLES; z++)
+	{
+		for (int y = 0; y < BRICK_SAMPLES; y++)
+		{
+			for (int x = 0; x < BRICK_SAMPLES; x++, sampleIndex++)
+			{
+				Vector3f point = brickOrigin + Vector3f{ (float)x, (float)y, (float)z } * m_cellSize;
+
+				float distance = m_brickSize;
+				unsigned short material = 0;
+
+				for (int boxIndex : candidates)
+				{
+					float boxDist = boxDistance(boxes[boxIndex], point);
+					if (boxDist < distance)
+					{
+						distance = boxDist;
+						material = (unsigned short)boxIndex;
+					}
+				}
+
+				// Clamp to the band, samples further than a brick are never interpolated with the surface
+				distance = clamp(distance, -m_brickSize, m_brickSize);
+
+				out.distances[sampleIndex] = (short)roundf(distance / m_brickSize * SHRT_MAX);
+				out.materials[sampleIndex] = material;
+
+				if (distance > -m_cellSize) allSolid = false;
+			}
+		}
+	}
+
+	return !allSolid;
+}
+
+void SignedDistanceField::bake(float cellSize)
+{
+	m_brickIndices.clear();
+	m_bricks.clear();
+	m_baked = true;
+
+	if (m_boxes.empty()) return;
+
+	// Orient boxes and compute the bounds
+	std::vector<OrientedBox> boxes;
+	std::vector<Vector3f> boxMin, boxMax;
+	boxes.reserve(m_boxes.size());
+	boxMin.reserve(m_boxes.size());
+	boxMax.reserve(m_boxes.size());
+
+	Vector3f boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+	Vector3f boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (const Box& box : m_boxes)
+	{
+		OrientedBox oriented;
+		oriented.center = box.m_center;
+		oriented.axis[0] = vector3RotateByQuaternion({ 1.f, 0.f, 0.f }, box.m_rotation);
+		oriented.axis[1] = vector3RotateByQuaternion({ 0.f, 1.f, 0.f }, box.m_rotation);
+		oriented.axis[2] = vector3RotateByQuaternion({ 0.f, 0.f, 1.f }, box.m_rotation);
+		oriented.extension = box.m_extension;
+		boxes.push_back(oriented);
+
+		Vector3f halfSize;
+		for (int i = 0; i < 3; i++)
+		{
+			halfSize.c[i] = fabsf(oriented.axis[0].c[i]) * box.m_extension.x
+						  + fabsf(oriented.axis[1].c[i]) * box.m_extension.y
+						  + fabsf(oriented.axis[2].c[i]) * box.m_extension.z;
+		}
+
+		boxMin.push_back(box.m_center - halfSize);
+		boxMax.push_back(box.m_center + halfSize);
+
+		for (int i = 0; i < 3; i++)
+		{
+			boundsMin.c[i] = min(boundsMin.c[i], boxMin.back().c[i]);
+			boundsMax.c[i] = max(boundsMax.c[i], boxMax.back().c[i]);
+		}
+	}
+
+	// Grow the cells until the top level grid stays reasonable
+	m_cellSize = cellSize;
+	long long brickCount = 0;
+	do
+	{
+		m_brickSize = m_cellSize * BRICK_CELLS;
+		m_origin = boundsMin - Vector3f(m_brickSize);
+
+		brickCount = 1;
+		for (int i = 0; i < 3; i++)
+		{
+			m_dimensions[i] = (int)ceilf((boundsMax.c[i] - m_origin.c[i] + m_brickSize) / m_brickSize);
+			brickCount *= m_dimensions[i];
+		}
+
+		if (brickCount > MAX_TOP_LEVEL_BRICKS) m_cellSize *= 2.f;
+	} while (brickCount > MAX_TOP_LEVEL_BRICKS);
+
+	m_brickIndices.assign((size_t)brickCount, BRICK_EMPTY);
+
+	// Bricks touched by each box, inflated by one cell, are baked
+	// Their candidates are the boxes closer than a brick, the band the samples store
+	std::unordered_map<int, std::vector<int>> brickCandidates;
+	for (float margin : { m_cellSize, m_brickSize })
+	{
+		for (int boxIndex = 0; boxIndex < (int)boxes.size(); boxIndex++)
+		{
+			int from[3], to[3];
+			for (int i = 0; i < 3; i++)
+			{
+				from[i] = max(0, (int)floorf((boxMin[boxIndex].c[i] - margin - m_origin.c[i]) / m_brickSize));
+				to[i] = min(m_dimensions[i] - 1, (int)floorf((boxMax[boxIndex].c[i] + margin - m_origin.c[i]) / m_brickSize));
+			}
+
+			for (int z = from[2]; z <= to[2]; z++)
+			{
+				for (int y = from[1]; y <= to[1]; y++)
+				{
+					for (int x = from[0]; x <= to[0]; x++)
+					{
+						int linear = x + m_dimensions[0] * (y + m_dimensions[1] * z);
+						if (margin == m_cellSize)
+						{
+							brickCandidates.emplace(linear, std::vector<int>());
+							continue;
+						}
+
+						auto candidates = brickCandidates.find(linear);
+						if (candidates != brickCandidates.end()) candidates->second.push_back(boxIndex);
+					}
+				}
+			}
+		}
+	}
+
+	// Bake the bricks crossed by a surface, the others are marked solid
+	Brick brick;
+	for (auto& candidates : brickCandidates)
+	{
+		int linear = candidates.first;
+		int coords[3] = { linear % m_dimensions[0], (linear / m_dimensions[0]) % m_dimensions[1], linear / (m_dimensions[0] * m_dimensions[1]) };
+
+		if (bakeBrick(coords, boxes, candidates.second, brick))
+		{
+			m_brickIndices[linear] = (int)m_bricks.size();
+			m_bricks.push_back(brick);
+		}
+		else
+		{
+			m_brickIndices[linear] = BRICK_SOLID;
+		}
+	}
+}
+
+bool SignedDistanceField::sample(const Vector3f& point, DistanceSample& out) const
+{
+	if (m_bricks.empty() && m_brickIndices.empty()) return false;
+
+	// Position in cells from the grid origin
+	float cell[3];
+	int brick[3];
+	for (int i = 0; i < 3; i++)
+	{
+		cell[i] = (point.c[i] - m_origin.c[i]) / m_cellSize;
+		brick[i] = (int)floorf(cell[i] / BRICK_CELLS);
+
+		if (brick[i] < 0 || brick[i] >= m_dimensions[i]) return false;
+	}
+
+	int brickIndex = m_brickIndices[brick[0] + m_dimensions[0] * (brick[1] + m_dimensions[1] * brick[2])];
+	if (brickIndex == BRICK_EMPTY) return false;
+
+	if (brickIndex == BRICK_SOLID)
+	{
+		// Deep inside a box, no meaningful gradient
+		out.distance = -m_brickSize;
+		out.normal = Vector3f::zero();
+		out.material = PhysicsMaterial();
+		return true;
+	}
+
+	const Brick& data = m_bricks[brickIndex];
+
+	// Cell and interpolation factor inside the brick
+	int c[3];
+	float t[3];
+	for (int i = 0; i < 3; i++)
+	{
+		float local = cell[i] - brick[i] * BRICK_CELLS;
+		c[i] = min((int)local, BRICK_CELLS - 1);
+		t[i] = local - c[i];
+	}
+
+	const int strideY = BRICK_SAMPLES;
+	const int strideZ = BRICK_SAMPLES * BRICK_SAMPLES;
+	int base = c[0] + c[1] * strideY + c[2] * strideZ;
+
+	const float unquantize = m_brickSize / SHRT_MAX;
+
+	float d000 = data.distances[base] * unquantize;
+	float d100 = data.distances[base + 1] * unquantize;
+	float d010 = data.distances[base + strideY] * unquantize;
+	float d110 = data.distances[base + strideY + 1] * unquantize;
+	float d001 = data.distances[base + strideZ] * unquantize;
+	float d101 = data.distances[base + strideZ + 1] * unquantize;
+	float d011 = data.distances[base + strideZ + strideY] * unquantize;
+	float d111 = data.distances[base + strideZ + strideY + 1] * unquantize;
+
+	float tx = t[0], ty = t[1], tz = t[2];
+
+	// Trilinear interpolation
+	float dx00 = d000 + (d100 - d000) * tx;
+	float dx10 = d010 + (d110 - d010) * tx;
+	float dx01 = d001 + (d101 - d001) * tx;
+	float dx11 = d011 + (d111 - d011) * tx;
+	float dxy0 = dx00 + (dx10 - dx00) * ty;
+	float dxy1 = dx01 + (dx11 - dx01) * ty;
+
+	out.distance = dxy0 + (dxy1 - dxy0) * tz;
+
+	// Analytic gradient of the trilinear interpolation
+	Vector3f gradient;
+	gradient.x = ((d100 - d000) * (1.f - ty) * (1.f - tz) + (d110 - d010) * ty * (1.f - tz)
+				+ (d101 - d001) * (1.f - ty) * tz + (d111 - d011) * ty * tz);
+	gradient.y = ((dx10 - dx00) * (1.f - tz) + (dx11 - dx01) * tz);
+	gradient.z = (dxy1 - dxy0);
+
+	float gradientLength = gradient.length();
+	out.normal = gradientLength > 0.f ? gradient / gradientLength : Vector3f::zero();
+
+	// Material of the closest sample
+	int nearest = (c[0] + (tx > 0.5f)) + (c[1] + (ty > 0.5f)) * strideY + (c[2] + (tz > 0.5f)) * strideZ;
+	out.material = m_materials[data.materials[nearest]];
+
+	return true;
+}
@@ -2,61 +2,37 @@
 #include <fstream>
 #include <sstream>
 
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include <algorithm>
 
 #include <Resources/Mesh.hpp>
+#include <Resources/ResourcesManager.hpp>
 
-Resources::Mesh::Mesh(const std::vector<Vertex>& verticesIn)
+Resources::Mesh::Mesh(const std::vector<Vertex>& verticesIn, const std::vector<unsigned int>& indicesIn)
 {
-	m_vertices = verticesIn;
-	setupMesh();
-}
-
-Resources::Mesh::~Mesh() 
-{ 
-	m_vertices.clear(); 
-}
-
-
-void Resources::Mesh::setupMesh()
-{
-	//	Create VAO - Vertex Array Object
-	glGenVertexArrays(1, &VAO);
-
-	//	Create VBO - Vertex Buffer Object
-	glGenBuffers(1, &VBO);
-
-	//	Define VBO and VAO
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-	//	Attach VBO to VAO / Bind attributes (position) in VAO
-	glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
-
-
-	//	Position
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
-
-	//	Normals
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(offsetof(Vertex, Normals)));
-
-	//	Textures
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(offsetof(Vertex, TexCoords)));
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
-}
-
-
-void Resources::Mesh::draw()
-{
-	glBindVertexArray(VAO);
-
-	glDrawArrays(GL_TRIANGLES, 0, (GLsizei)m_vertices.size());
-
-	glBindVertexArray(0);
+	if (verticesIn.empty()) return;
+
+	//	Bounding sphere around the center of the box, used to cull the model
+	Maths::Vector3f min = verticesIn[0].Position;
+	Maths::Vector3f max = verticesIn[0].Position;
+
+	for (const Vertex& vertex : verticesIn)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min.c[i] = std::min(min.c[i], vertex.Position.c[i]);
+			max.c[i] = std::max(max.c[i], vertex.Position.c[i]);
+		}
+	}
+
+	m_boundsCenter = (min + max) * 0.5f;
+
+	float radius = 0.f;
+	for (const Vertex& vertex : verticesIn)
+	{
+		radius = std::max(radius, (vertex.Position - m_boundsCenter).squareLength());
+	}
+	m_boundsRadius = sqrtf(radius);
+
+	//	Vertices only live on the GPU, in the shared buffers
+	m_allocation = Resources::ResourcesManager::instance()->m_meshArena.add(verticesIn, indicesIn);
 }
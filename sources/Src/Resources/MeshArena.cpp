@@ -0,0 +1,160 @@
+#include <Resources/MeshArena.hpp>
+
+#include <Config.hpp>
+#include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <LowRenderer/GLState.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+
+#define PAGE_VERTICES	(1 << 19)	// 16 MB of vertices
+#define PAGE_INDICES	(3 << 19)	// 6 MB of indices
+
+
+Resources::MeshArena::~MeshArena()
+{
+	GLState* _glState = GLState::instance();
+
+	for (Page& page : m_pages)
+	{
+		_glState->forgetVertexArray(page.VAO);
+
+		glDeleteVertexArrays(1, &page.VAO);
+		glDeleteBuffers(1, &page.VBO);
+		glDeleteBuffers(1, &page.IBO);
+
+		Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, -((long long)page.vertexCapacity * sizeof(Vertex) + (long long)page.indexCapacity * sizeof(GLuint)));
+	}
+	m_pages.clear();
+
+	if (m_drawIndexBuffer)
+	{
+		glDeleteBuffers(1, &m_drawIndexBuffer);
+		Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, -(long long)(MAX_BATCH_DRAWS * sizeof(GLuint)));
+	}
+}
+
+int Resources::MeshArena::createPage(GLsizei vertexCapacity, GLsizei indexCapacity)
+{
+	GLState* _glState = GLState::instance();
+
+	//	Shared by every page, attribute 3 reads it once per instance
+	if (m_drawIndexBuffer == 0)
+	{
+		std::vector<GLuint> drawIndices(MAX_BATCH_DRAWS);
+		for (GLuint i = 0; i < MAX_BATCH_DRAWS; i++) drawIndices[i] = i;
+
+		glGenBuffers(1, &m_drawIndexBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_drawIndexBuffer);
+		glBufferStorage(GL_ARRAY_BUFFER, drawIndices.size() * sizeof(GLuint), drawIndices.data(), 0);
+		Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, drawIndices.size() * sizeof(GLuint));
+	}
+
+	Page page;
+	page.vertexCapacity = vertexCapacity;
+	page.indexCapacity = indexCapacity;
+
+	glGenVertexArrays(1, &page.VAO);
+	glGenBuffers(1, &page.VBO);
+	glGenBuffers(1, &page.IBO);
+
+	_glState->bindVertexArray(page.VAO);
+
+	//	Meshes are written with glBufferSubData when they are loaded
+	glBindBuffer(GL_ARRAY_BUFFER, page.VBO);
+	glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCapacity * sizeof(Vertex), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.IBO);
+	glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCapacity * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, (long long)vertexCapacity * sizeof(Vertex) + (long long)indexCapacity * sizeof(GLuint));
+
+	//	Position
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
+
+	//	Normals
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(offsetof(Vertex, Normals)));
+
+	//	Textures
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(offsetof(Vertex, TexCoords)));
+
+	//	Draw index, the instance attributes start at the baseInstance of the command
+	glBindBuffer(GL_ARRAY_BUFFER, m_drawIndexBuffer);
+	glEnableVertexAttribArray(3);
+	glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(GLuint), (GLvoid*)0);
+	glVertexAttribDivisor(3, 1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	_glState->bindVertexArray(0);
+
+	m_pages.push_back(page);
+
+	return (int)m_pages.size() - 1;
+}
+
+Resources::MeshArena::Allocation Resources::MeshArena::add(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	Allocation allocation;
+	if (vertices.empty() || indices.empty()) return allocation;
+
+	GLsizei vertexCount = (GLsizei)vertices.size();
+	GLsizei indexCount = (GLsizei)indices.size();
+
+	//	First page with room for both
+	int pageIndex = -1;
+	for (int i = 0; i < (int)m_pages.size(); i++)
+	{
+		const Page& page = m_pages[i];
+		if (page.vertexCount + vertexCount <= page.vertexCapacity && page.indexCount + indexCount <= page.indexCapacity)
+		{
+			pageIndex = i;
+			break;
+		}
+	}
+
+	//	A mesh bigger than a page gets one of its size
+	if (pageIndex < 0)
+	{
+		pageIndex = createPage(std::max(vertexCount, PAGE_VERTICES), std::max(indexCount, PAGE_INDICES));
+	}
+
+	Page& page = m_pages[pageIndex];
+
+	allocation.page = pageIndex;
+	allocation.baseVertex = page.vertexCount;
+	allocation.firstIndex = page.indexCount;
+	allocation.indexCount = indexCount;
+
+	glBindBuffer(GL_ARRAY_BUFFER, page.VBO);
+	glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)page.vertexCount * sizeof(Vertex), (GLsizeiptr)vertexCount * sizeof(Vertex), vertices.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	//	The element buffer binding belongs to the vertex array
+	GLState::instance()->bindVertexArray(page.VAO);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)page.indexCount * sizeof(GLuint), (GLsizeiptr)indexCount * sizeof(GLuint), indices.data());
+	GLState::instance()->bindVertexArray(0);
+
+	page.vertexCount += vertexCount;
+	page.indexCount += indexCount;
+
+	return allocation;
+}
+
+void Resources::MeshArena::bind(int page) const
+{
+	GLState::instance()->bindVertexArray(m_pages[page].VAO);
+}
+
+void Resources::MeshArena::showImGui() const
+{
+	for (size_t i = 0; i < m_pages.size(); i++)
+	{
+		const Page& page = m_pages[i];
+		ImGui::Text("Page %d : %d / %d vertices, %d / %d indices", (int)i, page.vertexCount, page.vertexCapacity, page.indexCount, page.indexCapacity);
+	}
+}
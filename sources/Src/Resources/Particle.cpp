@@ -4,6 +4,7 @@
 #include <Core/TimeManager.h>
 
 #include <Physics/RigidBody3.hpp>
+#include <Physics/SignedDistanceField.hpp>
 
 #include <Maths/Random.hpp>
 namespace Resources
@@ -26,13 +27,49 @@ namespace Resources
 		gravity_multiplier = infos.gravity_multiplier;
 	}
 
-	void Particle::update() 
+	void Particle::update(const Physics::SignedDistanceField* field, const Maths::Mat4x4& parentMatrix)
 	{
 		timer.update();
 
+		Vector3f previousPosition = transform.m_position;
+
 		velocity += -Vector3f::yAxis() * EARTH_GRAVITY * gravity_multiplier * Core::TimeManager::instance()->deltaTime;
 		transform.m_position += Core::TimeManager::instance()->deltaTime * speed * velocity;
 
+		if (field) collide(*field, parentMatrix, previousPosition);
+
 		transform.updateTransform();
 	}
+
+	void Particle::collide(const Physics::SignedDistanceField& field, const Maths::Mat4x4& parentMatrix, const Maths::Vector3f& previousPosition)
+	{
+		//	The particle moves in its parent space, the field is in world space
+		Vector3f worldPosition = (parentMatrix * Maths::Vector4f(transform.m_position, 1.f)).xyz;
+
+		Physics::DistanceSample hit;
+		if (!field.sample(worldPosition, hit) || hit.distance > 0.f) return;
+
+		//	Step back outside of the collider
+		transform.m_position = previousPosition;
+
+		//	Deep inside a collider, no direction to bounce to
+		if (hit.normal.squareLength() == 0.f)
+		{
+			velocity = Vector3f::zero();
+			return;
+		}
+
+		//	Normals go back to the parent space with the transposed matrix
+		Vector3f normal = Vector3f{ dotProduct(parentMatrix.c[0].xyz, hit.normal),
+									dotProduct(parentMatrix.c[1].xyz, hit.normal),
+									dotProduct(parentMatrix.c[2].xyz, hit.normal) }.normalized();
+
+		float normalSpeed = dotProduct(velocity, normal);
+		if (normalSpeed >= 0.f) return;
+
+		Vector3f normalVelocity = normal * normalSpeed;
+		Vector3f tangentVelocity = velocity - normalVelocity;
+
+		velocity = tangentVelocity * (1.f - hit.material.m_friction) - normalVelocity * hit.material.m_bounciness;
+	}
 }
\ No newline at end of file
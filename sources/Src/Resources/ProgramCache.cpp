@@ -0,0 +1,201 @@
+#include <Resources/ProgramCache.hpp>
+
+#include <glad/glad.h>
+
+#include <Config.hpp>
+#include <Core/Log.hpp>
+
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#define PROGRAM_CACHE_MAGIC		0x42504C47 // "GLPB"
+#define PROGRAM_CACHE_VERSION	1
+
+
+namespace
+{
+	struct ProgramFileHeader
+	{
+		uint32_t magic = PROGRAM_CACHE_MAGIC;
+		uint32_t version = PROGRAM_CACHE_VERSION;
+		uint32_t format = 0;
+		uint32_t size = 0;
+	};
+
+	//	Load stats since the last logStats
+	unsigned int s_hitCount = 0;
+	unsigned int s_missCount = 0;
+	double s_hitMs = 0.0;
+	double s_missMs = 0.0;
+
+	//	-1 unknown, 0 the driver has no binary format
+	int s_supported = -1;
+
+	bool isSupported()
+	{
+		if (s_supported < 0)
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			s_supported = formatCount > 0;
+
+			if (!s_supported) Core::Log::instance()->writeWarning("Program binaries aren't supported by the driver, shaders will always be compiled");
+		}
+
+		return s_supported == 1;
+	}
+
+	//	FNV-1a, 64 bits
+	uint64_t hashString(const std::string& str, uint64_t hash = 14695981039346656037ull)
+	{
+		for (unsigned char c : str)
+		{
+			hash ^= c;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	std::string getGLString(GLenum name)
+	{
+		const GLubyte* str = glGetString(name);
+		return str ? (const char*)str : "";
+	}
+
+	void createDirectories(const std::string& path)
+	{
+		for (size_t i = path.find('/'); i != std::string::npos; i = path.find('/', i + 1))
+		{
+#ifdef _WIN32
+			_mkdir(path.substr(0, i).c_str());
+#else
+			mkdir(path.substr(0, i).c_str(), 0755);
+#endif
+		}
+	}
+
+	std::string getPath(const std::string& key)
+	{
+		return std::string(PROGRAM_CACHE_DIR) + key + ".bin";
+	}
+}
+
+
+std::string Resources::ProgramCache::getKey(const std::string& sources)
+{
+	uint64_t hash = hashString(sources);
+	hash = hashString(getGLString(GL_VENDOR), hash);
+	hash = hashString(getGLString(GL_RENDERER), hash);
+	hash = hashString(getGLString(GL_VERSION), hash);
+
+	char key[17];
+	snprintf(key, sizeof(key), "%016llx", (unsigned long long)hash);
+
+	return key;
+}
+
+unsigned int Resources::ProgramCache::load(const std::string& key)
+{
+	if (!isSupported()) return 0;
+
+	std::ifstream file(getPath(key), std::ios::binary);
+	if (!file) return 0;
+
+	ProgramFileHeader header;
+	file.read((char*)&header, sizeof(header));
+
+	if (!file || header.magic != PROGRAM_CACHE_MAGIC || header.version != PROGRAM_CACHE_VERSION || header.size == 0)
+		return 0;
+
+	std::vector<char> binary(header.size);
+	file.read(binary.data(), header.size);
+	if (!file) return 0;
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, header.format, binary.data(), (GLsizei)header.size);
+
+	//	The driver can refuse a binary it wrote itself (other build, other settings)
+	GLint success = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		Core::Log::instance()->writeWarning("Cached program " + key + " refused by the driver, compiling it again");
+		glDeleteProgram(program);
+		return 0;
+	}
+
+	return program;
+}
+
+void Resources::ProgramCache::save(const std::string& key, unsigned int program)
+{
+	if (!isSupported()) return;
+
+	GLint size = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+	if (size <= 0) return;
+
+	ProgramFileHeader header;
+	std::vector<char> binary(size);
+
+	GLsizei length = 0;
+	glGetProgramBinary(program, size, &length, &header.format, binary.data());
+	if (length <= 0) return;
+
+	header.size = (uint32_t)length;
+
+	createDirectories(PROGRAM_CACHE_DIR);
+
+	std::ofstream file(getPath(key), std::ios::binary);
+	if (!file)
+	{
+		Core::Log::instance()->writeWarning("Couldn't write program cache \"" + getPath(key) + "\"");
+		return;
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write(binary.data(), length);
+}
+
+void Resources::ProgramCache::addLoadTime(bool fromCache, double ms)
+{
+	if (fromCache)
+	{
+		s_hitCount++;
+		s_hitMs += ms;
+	}
+	else
+	{
+		s_missCount++;
+		s_missMs += ms;
+	}
+}
+
+void Resources::ProgramCache::logStats()
+{
+	if (s_hitCount + s_missCount == 0) return;
+
+	Core::Log* _log = Core::Log::instance();
+
+	//	Warm start when nothing had to be compiled
+	std::string start = s_missCount == 0 ? "warm start" : (s_hitCount == 0 ? "cold start" : "partially cached");
+
+	char line[256];
+	snprintf(line, sizeof(line), "Shader programs (%s) : %d from cache in %.2f ms, %d compiled in %.2f ms",
+		start.c_str(), s_hitCount, s_hitMs, s_missCount, s_missMs);
+	_log->write(line);
+
+	s_hitCount = 0;
+	s_missCount = 0;
+	s_hitMs = 0.0;
+	s_missMs = 0.0;
+}
@@ -1,9 +1,14 @@
 #include <iostream>
 #include <iomanip>
+#include <array>
 
+#include <Config.hpp>
 #include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
 
 #include <Resources/ResourcesManager.hpp>
+#include <LowRenderer/GLState.hpp>
 #include <Utils/File.h>
 #include <Utils/StringExtractor.h>
 
@@ -99,18 +104,33 @@ void setIndices(std::istringstream& line, std::vector<unsigned int>& indices)
 
 
 //	Sort Vertices and place them in a new mesh
+//	Faces sharing a position / uv / normal triplet share the vertex
 Resources::Mesh setMesh(Resources::RawVerticesList& rawList)
 {
 	std::vector<Resources::Vertex> vertices;
+	std::vector<unsigned int> indices;
+	std::map<std::array<unsigned int, 3>, unsigned int> vertexIndices;
+
+	indices.reserve(rawList.indices.size() / 3);
 
 	for (size_t i = 0; i < rawList.indices.size(); i += 3)
 	{
-		Resources::Vertex	vrt;
-		vrt.Position = rawList.Pos[rawList.indices[i]];
-		vrt.TexCoords = rawList.Tex[rawList.indices[i + 1]];
-		vrt.Normals = rawList.Nor[rawList.indices[i + 2]];
+		std::array<unsigned int, 3> triplet = { rawList.indices[i], rawList.indices[i + 1], rawList.indices[i + 2] };
 
+		auto found = vertexIndices.find(triplet);
+		if (found != vertexIndices.end())
+		{
+			indices.push_back(found->second);
+			continue;
+		}
 
+		Resources::Vertex	vrt;
+		vrt.Position = rawList.Pos[triplet[0]];
+		vrt.TexCoords = rawList.Tex[triplet[1]];
+		vrt.Normals = rawList.Nor[triplet[2]];
+
+		vertexIndices[triplet] = (unsigned int)vertices.size();
+		indices.push_back((unsigned int)vertices.size());
 		vertices.push_back(vrt);
 	}
 
@@ -118,7 +138,7 @@ Resources::Mesh setMesh(Resources::RawVerticesList& rawList)
 	//	(Same indices for every meshes) Unlike vertices informations
 	rawList.indices.clear();
 
-	Resources::Mesh out(vertices);
+	Resources::Mesh out(vertices, indices);
 	vertices.clear();
 
 	return out;
@@ -128,6 +148,9 @@ Resources::Texture* Resources::ResourcesManager::loadTexture(const std::string&
 { 
 	if (!textureLoaded(text_name))
 	{
+		PROFILE_SCOPE("Load texture");
+		MEMORY_TAG(RESOURCES);
+
 		Texture newTexture(path, text_name);
 
 		if (newTexture.getID() == 0)
@@ -192,6 +215,70 @@ std::vector<const char*> Resources::ResourcesManager::getAllTextureName()
 	return names;
 }
 
+bool Resources::ResourcesManager::loadAtlas(const std::string& path)
+{
+	PROFILE_SCOPE("Load atlas");
+	MEMORY_TAG(RESOURCES);
+
+	std::ifstream file;
+	if (!FileParser::openFile(path, file)) return false;
+
+	std::string dir = Extractor::ExtractDirectory(path);
+	std::map<int, Texture*> pages;
+	std::map<int, Maths::Vector2f> pageSizes;
+
+	std::string curr_line;
+	while (std::getline(file, curr_line))
+	{
+		std::istringstream lineStream(curr_line);
+		std::string type = FileParser::getString(lineStream);
+
+		if (type == "PAGE")
+		{
+			int page;
+			std::string fileName;
+			Maths::Vector2f size;
+			lineStream >> page >> fileName >> size.x >> size.y;
+
+			pages[page] = loadTexture(dir + fileName, Extractor::ExtractNameWithoutExtension(fileName));
+			pageSizes[page] = size;
+		}
+		else if (type == "REGION")
+		{
+			std::string name;
+			int page, x, y, width, height;
+			lineStream >> name >> page >> x >> y >> width >> height;
+
+			if (pages[page] == nullptr) continue;
+
+			//	Pixels are stored from the top, textures are flipped when loaded
+			Maths::Vector2f size = pageSizes[page];
+
+			AtlasRegion region;
+			region.page = pages[page];
+			region.uvRect = { x / size.x, 1.f - (y + height) / size.y, (x + width) / size.x, 1.f - y / size.y };
+
+			m_textureName_atlasRegion[name] = region;
+		}
+	}
+
+	return true;
+}
+
+const Resources::AtlasRegion* Resources::ResourcesManager::getAtlasRegion(const std::string& text_name)
+{
+	if (!m_atlasLoaded)
+	{
+		m_atlasLoaded = true;
+		loadAtlas(std::string(UI_ATLAS) + ".atlas");
+	}
+
+	auto region = m_textureName_atlasRegion.find(text_name);
+	if (region == m_textureName_atlasRegion.end()) return nullptr;
+
+	return &region->second;
+}
+
 void  Resources::ResourcesManager::setTexture(const std::string& textName, Texture& text)
 {
 	m_textureName_texture[textName] = text;
@@ -202,6 +289,7 @@ void Resources::ResourcesManager::loadShader(const std::string& shader_name, con
 	if (!fileLoaded(shader_name))
 	{
 		m_shaderName_shader[shader_name] = Resources::Shader(vertex_path, fragment_path, geometry_path);
+		m_shaderName_shader[shader_name].m_name = shader_name;
 	}
 }
 
@@ -212,6 +300,9 @@ void Resources::ResourcesManager::loadFont(const std::string& path)
 
 	if (fileLoaded(path)) return;
 
+	PROFILE_SCOPE("Load font");
+	MEMORY_TAG(RESOURCES);
+
 
 	FT_Library ft;
 	if (FT_Init_FreeType(&ft))
@@ -249,8 +340,9 @@ void Resources::ResourcesManager::loadFont(const std::string& path)
 
 		unsigned int texture;
 		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		GLState::instance()->bindTexture(GL_TEXTURE_2D, texture);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, face->glyph->bitmap.width, face->glyph->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+		Core::MemoryTracker::addGpuBytes(Core::MemoryTag::TEXT, (long long)face->glyph->bitmap.width * face->glyph->bitmap.rows);
 
 		// set texture options
 
@@ -441,6 +533,9 @@ bool Resources::ResourcesManager::loadOBJ(const std::string& path, const std::st
 
 	if (fileLoaded(path + fileName) == false)
 	{
+		PROFILE_SCOPE("Load OBJ");
+		MEMORY_TAG(RESOURCES);
+
 		_log->write("+\t\t Loading new OBJ file");
 		_log->breakLine();
 	}
@@ -483,6 +578,11 @@ void Resources::ResourcesManager::showImGUIResourcesManager()
 		}
 
 	}
+
+	if (ImGui::CollapsingHeader("Mesh Arena"))
+	{
+		m_meshArena.showImGui();
+	}
 }
 
 
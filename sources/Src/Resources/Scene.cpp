@@ -7,14 +7,22 @@
 #include <imgui_impl_opengl3.h>
 
 #include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/ObjectPool.hpp>
 #include <Core/TimeManager.h>
 #include <Core/InputsManager.hpp>
 #include <Core/Graph.hpp>
 #include <Core/Window.hpp>
 
 #include <LowRenderer/Text.hpp>
+#include <LowRenderer/QuadBatcher.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/FramePacket.hpp>
 #include <Resources/ResourcesManager.hpp>
 #include <Resources/Scene.hpp>
+#include <Resources/ProgramCache.hpp>
+#include <Resources/Shader.hpp>
 
 #include <Maths/Matrix.h>
 #include <Engine/Transform3.hpp>
@@ -32,14 +40,29 @@ Resources::Scene::Scene()
 Resources::Scene::~Scene()
 {
 	Core::Log* _log = Core::Log::instance();
-	_log->write("- Unloading scene");
+	_log->write("- Unloading scene : " + std::to_string(m_objectList.size()) + " objects");
 
-	//	Destroy all GameObjects
-	while(m_objectList.empty() == false)
+	//	Every object goes : no parent destroys its children, no object is swapped out of the list,
+	//	no component is taken out of the arrays
+	for (std::vector<Component*>& components : m_components)
 	{
-		m_objectList[(int)m_objectList.size() - 1]->destroy();
+		components.clear();
+	}
+
+	for (auto obj : m_objectList)
+	{
+		obj.second->m_transform->m_parent = nullptr;
+		obj.second->m_transform->m_childList.clear();
+	}
+
+	for (auto obj : m_objectList)
+	{
+		delete obj.second;
 	}
 	m_objectList.clear();
+
+	//	Slabs of the pools left empty are freed at once
+	Core::PoolBase::trimAll();
 }
 
 //	Load .scn scene
@@ -95,6 +118,11 @@ bool Resources::Scene::loadScene(const char* path)
 
 	m_physicsManager.setUp();
 
+	//	Every program of the scene is submitted, now wait for the driver
+	m_rendererManager.prewarmShaders();
+	Resources::Shader::resolvePending(true);
+	Resources::ProgramCache::logStats();
+
 	return true;
 }
 
@@ -124,9 +152,9 @@ void Resources::Scene::saveScene(const char* path)
 		file << currGameObject->m_isStatic << " ";
 		file << currGameObject->m_layer.name << "\n";
 
-		for (auto comp : currGameObject->m_componentList)
+		for (Component* comp : currGameObject->m_componentList)
 		{
-			comp.second->saveComponentInSCNFile(file);
+			comp->saveComponentInSCNFile(file);
 		}
 
 		file << "END\n\n";
@@ -164,6 +192,31 @@ GameObject* Resources::Scene::findGameObjectInScene(std::string name)
 	return nullptr;
 }
 
+void Resources::Scene::addComponent(Component* component)
+{
+	std::vector<Component*>& components = m_components[component->m_type];
+
+	component->m_sceneIndex = (int)components.size();
+	components.push_back(component);
+}
+
+void Resources::Scene::removeComponent(Component* component)
+{
+	if (component->m_type < 0) return;
+
+	std::vector<Component*>& components = m_components[component->m_type];
+
+	//	Not in the arrays, or they were cleared by the unload
+	int index = component->m_sceneIndex;
+	if (index < 0 || index >= (int)components.size() || components[index] != component) return;
+
+	components[index] = components.back();
+	components[index]->m_sceneIndex = index;
+	components.pop_back();
+
+	component->m_sceneIndex = -1;
+}
+
 /*---------------------UPDATE--------------------*/
 
 void Resources::Scene::gameLoop()
@@ -228,6 +281,9 @@ void Resources::Scene::start()
 
 void Resources::Scene::update()
 {
+	PROFILE_SCOPE("Update");
+	MEMORY_TAG(SCENE);
+
 	m_rendererManager.update();
 
 	Core::Graph* _graph = Core::Graph::instance();
@@ -249,6 +305,9 @@ void Resources::Scene::update()
 
 void Resources::Scene::fixedUpdate()
 {
+	PROFILE_SCOPE("Fixed update");
+	MEMORY_TAG(SCENE);
+
 	for (auto object : m_objectList)
 	{
 		object.second->fixedUpdate();
@@ -257,6 +316,9 @@ void Resources::Scene::fixedUpdate()
 
 void Resources::Scene::lateUpdate()
 {
+	PROFILE_SCOPE("Late update");
+	MEMORY_TAG(SCENE);
+
 	for (auto object : m_objectList)
 	{
 		object.second->lateUpdate();
@@ -265,21 +327,28 @@ void Resources::Scene::lateUpdate()
 
 
 
-void Resources::Scene::draw()
+void Resources::Scene::draw(FramePacket& packet)
 {
+	PROFILE_SCOPE("Draw");
+	MEMORY_TAG(RENDERER);
+
 	for (auto object : m_objectList)
 	{
 		object.second->m_transform->updateTransform();
 	}
 
-	m_rendererManager.draw();
+	m_rendererManager.extract(packet);
 }
 
 void Resources::Scene::drawLoading() 
 {
 	glClearColor(0.f, 0.f, 0.f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	GLState::instance()->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::instance()->enable(GL_BLEND);
 	m_loader_sprite.draw();
+	QuadBatcher::instance()->flush();
+	GLState::instance()->disable(GL_BLEND);
 	static int pointNb = 0;
 	pointNb = (pointNb < 30) ? pointNb + 1 : 0;
 	int points = pointNb / 10;
@@ -289,7 +358,7 @@ void Resources::Scene::drawLoading()
 
 	TextRender::instance()->AddText("abnes.ttf", loading.c_str(), { -3, -5 }, .75f, { 1.f, 1.f, 1.f});
 	TextRender::instance()->RenderTextBuffer();
-	glfwSwapBuffers(Core::Window::instance()->m_window);
+	if (GLFWwindow* window = Core::Window::instance()->m_window) glfwSwapBuffers(window);
 	m_loader_transform.m_rotation.z -= .1f;
 	m_loader_transform.updateTransform();
 
@@ -2,18 +2,25 @@
 #include <glad/glad.h>
 
 #include <Core/Log.hpp>
+#include <Core/Profiler.hpp>
+#include <Core/MemoryTracker.hpp>
          
 #include <Resources/ResourcesManager.hpp>
 #include <Resources/Shader.hpp>
+#include <Resources/ProgramCache.hpp>
          
 #include <Utils/File.h>
          
 #include <Maths/Matrix.h>
          
 #include <LowRenderer/Light.hpp>
+#include <LowRenderer/GLState.hpp>
+#include <LowRenderer/RenderStats.hpp>
 
 #include <Engine/Transform3.hpp>
 
+#include <chrono>
+
 std::string loadStringFromFile(const std::string& path)
 {
     std::ifstream file;
@@ -52,233 +59,382 @@ void checkCompileErrors(unsigned int shad, const std::string& shaderName)
     }
     else
     {
-        _log->writeSuccess(shaderName + " ->\tSuccessfully compiled");
+        LOG_SUCCESS(SHADERS, shaderName + " ->\tSuccessfully compiled");
     }
 }
 
-Resources::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath)
+//  Keywords a .shad can list after FEATURES
+//  ----------------------------------------
+
+static const std::pair<const char*, unsigned int> s_featureNames[] =
 {
-    Core::Log* _log = Core::Log::instance();
+    { "DIFFUSE_MAP",  Resources::ShaderFeature::DIFFUSE_MAP },
+    { "NORMAL_MAP",   Resources::ShaderFeature::NORMAL_MAP },
+    { "SPECULAR_MAP", Resources::ShaderFeature::SPECULAR_MAP },
+    { "EMISSIVE_MAP", Resources::ShaderFeature::EMISSIVE_MAP },
+    { "MASK_MAP",     Resources::ShaderFeature::MASK_MAP },
+    { "SHOW_NORMAL",  Resources::ShaderFeature::SHOW_NORMAL },
+    { "OBJECT_LIGHTS", Resources::ShaderFeature::OBJECT_LIGHTS },
+};
+
+unsigned int Resources::Shader::s_variantCount = 0;
+
+//  Put the #define of each feature of the key right after the #version line
+//  A missing stage (no geometry shader) stays empty
+static std::string addFeatureDefines(const std::string& code, unsigned int featureKey)
+{
+    if (featureKey == 0 || code.empty()) return code;
+
+    std::string defines;
+    for (const auto& feature : s_featureNames)
+    {
+        if (featureKey & feature.second) defines += "#define " + std::string(feature.first) + "\n";
+    }
 
-    //  1. retrieve the vertex/fragment source code from filePath
-    //  ---------------------------------------------------------
+    //  Without a #version line, the defines go first
+    size_t insertAt = 0;
+    size_t versionLine = code.find("#version");
+    if (versionLine != std::string::npos)
+    {
+        insertAt = code.find('\n', versionLine);
+        insertAt = insertAt == std::string::npos ? code.size() : insertAt + 1;
+    }
+
+    return code.substr(0, insertAt) + defines + code.substr(insertAt);
+}
 
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
+Resources::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath)
+{
+    Core::Log* _log = Core::Log::instance();
 
-    bool hasGeometry = geometryPath != "";
+    //  Retrieve the vertex/fragment source code from filePath
+    //  Sources are kept to compile the variants later
+    //  ------------------------------------------------------
 
     try
     {
-        vertexCode = loadStringFromFile(vertexPath);
-        fragmentCode = loadStringFromFile(fragmentPath);
+        m_vertexCode = loadStringFromFile(vertexPath);
+        m_fragmentCode = loadStringFromFile(fragmentPath);
+        if (geometryPath != "") m_geometryCode = loadStringFromFile(geometryPath);
     }
     catch (std::ifstream::failure e)
     {
         _log->writeError("SHADER ->\tFILE NOT SUCCESSFULLY READED");
     }
+
+    ID = compile(0);
+}
+
+//  Program the driver may still be compiling
+//  Its compile and link status are only read once it's done
+struct PendingProgram
+{
+    unsigned int vertex = 0;
+    unsigned int fragment = 0;
+    unsigned int geometry = 0;
+
+    std::string cacheKey;
+
+    //  Main thread time spent submitting it
+    double submitMs = 0.0;
+};
+
+static std::unordered_map<unsigned int, PendingProgram> s_pendingPrograms;
+
+//  Wall time of the current batch of pending programs
+static std::chrono::high_resolution_clock::time_point s_prepStart;
+static unsigned int s_prepCount = 0;
+
+//  Point the material samplers at their texture units
+//  Samplers the features don't use are compiled out, their location is -1
+static void setSamplers(unsigned int program)
+{
+    GLState::instance()->useProgram(program);
+
+    glUniform1i(glGetUniformLocation(program, "DiffuseMap"), 0);
+    glUniform1i(glGetUniformLocation(program, "NormalMap"), 1);
+    glUniform1i(glGetUniformLocation(program, "SpecularMap"), 2);
+    glUniform1i(glGetUniformLocation(program, "EmissiveMap"), 3);
+    glUniform1i(glGetUniformLocation(program, "MaskMap"), 4);
+}
+
+//  Start compiling and linking the sources, the geometry shader is optional
+//  No status is queried here, so the driver can compile several programs at once
+static unsigned int submitProgram(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode, const std::string& cacheKey)
+{
+    static bool parallelCompile = false;
+    if (!parallelCompile && GLAD_GL_KHR_parallel_shader_compile)
+    {
+        //  Let the driver pick its number of compiler threads
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    //  2. compile shaders
-    //  ------------------
-
-    unsigned int vertex, fragment, geometry;
-    int success;
-    char infoLog[512];
+    PendingProgram pending;
+    pending.cacheKey = cacheKey;
 
     //  Vertex Shader
     {
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-
-        checkCompileErrors(vertex, "Vertex Shader");
+        pending.vertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(pending.vertex, 1, &vShaderCode, NULL);
+        glCompileShader(pending.vertex);
     }
 
     //  Fragment Shader
     {
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-
-        checkCompileErrors(fragment, "Fragment Shader");
+        pending.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(pending.fragment, 1, &fShaderCode, NULL);
+        glCompileShader(pending.fragment);
     }
 
     //  Geometry Shader
     {
         // if geometry shader is given, compile geometry shader
-        if (hasGeometry)
+        if (geometryCode != "")
         {
             const char* gShaderCode = geometryCode.c_str();
-            geometry = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(geometry, 1, &gShaderCode, NULL);
-            glCompileShader(geometry);
-
-            checkCompileErrors(geometry, "Geometry Shader");
+            pending.geometry = glCreateShader(GL_GEOMETRY_SHADER);
+            glShaderSource(pending.geometry, 1, &gShaderCode, NULL);
+            glCompileShader(pending.geometry);
         }
     }
 
     //  shader Program
 
+    unsigned int program = glCreateProgram();
+
+    //  Ask the driver to keep the binary for the program cache
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glAttachShader(program, pending.vertex);
+    glAttachShader(program, pending.fragment);
+    if (pending.geometry) glAttachShader(program, pending.geometry);
+    glLinkProgram(program);
+
+    if (s_pendingPrograms.empty())
     {
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        if (hasGeometry) glAttachShader(ID, geometry);
-        glLinkProgram(ID);
-
-        //  print linking errors if any
-        glGetProgramiv(ID, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            glGetProgramInfoLog(ID, 512, NULL, infoLog);
-            _log->writeError("SHADER PROGRAM ->\tLINKING_FAILED");
-            _log->write(infoLog);
-        }
-        else
-        {
-            _log->writeSuccess("Shader program ->\tSuccessfully linked");
-        }
+        s_prepStart = std::chrono::high_resolution_clock::now();
+        s_prepCount = 0;
     }
 
-    // delete the shaders as they're linked into our program now and no longer necessary
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
-    if(hasGeometry) glDeleteShader(geometry);
-
-    use();
+    s_pendingPrograms[program] = pending;
+    s_prepCount++;
 
-    setInt("mat.diffuseMap.text", 0);
-    setInt("mat.normalMap.map.text", 1);
-    setInt("mat.specularMap.text", 2);
-    setInt("mat.emissiveMap.text", 3);
-    setInt("mat.maskMap.text", 4);
+    return program;
 }
 
-void Resources::Shader::use()
+//  Read the status of a pending program, return false if the driver isn't done and wait is false
+static bool resolveProgram(unsigned int program, bool wait)
 {
-    glUseProgram(ID);
-}
+    auto found = s_pendingPrograms.find(program);
+    if (found == s_pendingPrograms.end()) return true;
 
-void Resources::Shader::setBool(const std::string& name, const bool value) const
-{
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
-}
+    if (!wait && GLAD_GL_KHR_parallel_shader_compile)
+    {
+        int completed = 0;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) return false;
+    }
 
-void Resources::Shader::setInt(const std::string& name, const int value) const
-{
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
-}
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
 
-void Resources::Shader::setFloat(const std::string& name, const float value) const
-{
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
-}
+    Core::Log* _log = Core::Log::instance();
+    PendingProgram& pending = found->second;
 
-void Resources::Shader::setFloat2(const std::string& name, const Maths::Vector2f& value) const
-{
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), value.x, value.y);
-}
+    checkCompileErrors(pending.vertex, "Vertex Shader");
+    checkCompileErrors(pending.fragment, "Fragment Shader");
+    if (pending.geometry) checkCompileErrors(pending.geometry, "Geometry Shader");
 
-void Resources::Shader::setFloat3(const std::string& name, const Maths::Vector3f& value) const
-{
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z);
+    int success;
+    char infoLog[512];
+
+    //  print linking errors if any
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        _log->writeError("SHADER PROGRAM ->\tLINKING_FAILED");
+        _log->write(infoLog);
+    }
+    else
+    {
+        LOG_SUCCESS(SHADERS, "Shader program ->\tSuccessfully linked");
+        Resources::ProgramCache::save(pending.cacheKey, program);
+    }
+
+    // delete the shaders as they're linked into our program now and no longer necessary
+    glDeleteShader(pending.vertex);
+    glDeleteShader(pending.fragment);
+    if (pending.geometry) glDeleteShader(pending.geometry);
+
+    setSamplers(program);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    Resources::ProgramCache::addLoadTime(false, pending.submitMs + ms);
+
+    s_pendingPrograms.erase(found);
+
+    if (s_pendingPrograms.empty())
+    {
+        double prepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - s_prepStart).count();
+
+        char line[128];
+        snprintf(line, sizeof(line), "Shader prep : %d programs ready in %.2f ms%s", s_prepCount, prepMs,
+            GLAD_GL_KHR_parallel_shader_compile ? " (parallel compile)" : "");
+        _log->write(line);
+    }
+
+    return true;
 }
 
-void Resources::Shader::setFloat4(const std::string& name, const  Maths::Vector4f& value) const
+unsigned int Resources::Shader::compile(unsigned int featureKey) const
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z, value.w);
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+    std::string vertexCode = addFeatureDefines(m_vertexCode, featureKey);
+    std::string fragmentCode = addFeatureDefines(m_fragmentCode, featureKey);
+    std::string geometryCode = addFeatureDefines(m_geometryCode, featureKey);
+
+    //  Reuse the program linked by a previous run
+    std::string cacheKey = ProgramCache::getKey(vertexCode + '\0' + fragmentCode + '\0' + geometryCode);
+
+    unsigned int program = ProgramCache::load(cacheKey);
+    if (program)
+    {
+        LOG_SUCCESS(SHADERS, "Shader program ->\tLoaded from cache " + cacheKey);
+        setSamplers(program);
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        ProgramCache::addLoadTime(true, ms);
+
+        return program;
+    }
+
+    //  Compile it on a miss, it is resolved by resolvePending or on first use
+    program = submitProgram(vertexCode, fragmentCode, geometryCode, cacheKey);
+    s_pendingPrograms[program].submitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    return program;
 }
 
-void Resources::Shader::setMat4(const std::string& name, const Maths::Mat4x4& value) const
+bool Resources::Shader::isReady() const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, value.e);
+    return s_pendingPrograms.empty() || s_pendingPrograms.find(ID) == s_pendingPrograms.end();
 }
 
-void Resources::Shader::setLights(const std::unordered_map<int, const Light*>& list) const
+void Resources::Shader::resolvePending(bool wait)
 {
+    std::vector<unsigned int> programs;
+    for (auto& pending : s_pendingPrograms) programs.push_back(pending.first);
 
-    setInt("LightNumber", (int)list.size());
-    int i = 0;
-    for (auto& curr_light : list)
+    for (unsigned int program : programs)
     {
-        std::string l = "light_list[" + std::to_string(i) + "].";
-
-        setBool(l + "enabled", curr_light.second->isActive());
+        resolveProgram(program, wait);
+    }
+}
 
-        setFloat3(l + "position", curr_light.second->m_transform->getWorldPosition());
+Resources::Shader* Resources::Shader::getVariant(unsigned int featureKey)
+{
+    //  Features the shader doesn't list don't change its code
+    featureKey &= m_featureMask;
+    if (featureKey == 0) return this;
 
-        setFloat3(l + "ambient", curr_light.second->ambient);
-        setFloat3(l + "diffuse", curr_light.second->diffuse);
-        setFloat3(l + "specular", curr_light.second->specular);
+    //  Fall back on the shader while the driver compiles the variant
+    std::unique_ptr<Shader>& variant = m_variants[featureKey];
+    if (variant) return variant->isReady() ? variant.get() : this;
 
-        setFloat3(l + "attenuation", curr_light.second->attenuation);
-        setFloat3(l + "direction", curr_light.second->direction);
-        
-        setFloat(l + "power", curr_light.second->power);
-        setFloat(l + "cutOff", curr_light.second->cutOff);
-        setFloat(l + "outerCutOff", curr_light.second->outerCutOff);
+    variant = std::make_unique<Shader>();
+    variant->ID = compile(featureKey);
+    variant->m_type = m_type;
+    variant->m_name = m_name;
 
-        setInt(l + "lightType", curr_light.second->lightType);
+    s_variantCount++;
 
-        i++;
+    std::string features;
+    for (const auto& feature : s_featureNames)
+    {
+        if (featureKey & feature.second) features += " " + std::string(feature.first);
     }
-}
 
+    LOG_INFO(SHADERS, "+ Shader variant \"" + m_name + "\" :" + features + " (" + std::to_string(m_variants.size()) + " for this shader, " + std::to_string(s_variantCount) + " in total)");
 
-void Resources::Shader::setMaterial(const Resources::Material& in_material) const
-{
-    //  Send materials data to the GPU
-    //  ------------------------------
+    return variant->isReady() ? variant.get() : this;
+}
 
-    setFloat3("mat.ambient", in_material.m_ambient);
-    setFloat3("mat.diffuse", in_material.m_diffuse);
-    setFloat3("mat.specular", in_material.m_specular);
-    setFloat3("mat.emissive", in_material.m_emissive);
+unsigned int Resources::Shader::getFeatureKey(const Resources::Material& in_material)
+{
+    unsigned int featureKey = 0;
 
-    setFloat("mat.shininess", in_material.m_shininess);    
+    if (in_material.m_text_diffuse.getTextureID() != 0)  featureKey |= ShaderFeature::DIFFUSE_MAP;
+    if (in_material.m_text_bump.getTextureID() != 0)     featureKey |= ShaderFeature::NORMAL_MAP;
+    if (in_material.m_text_specular.getTextureID() != 0) featureKey |= ShaderFeature::SPECULAR_MAP;
+    if (in_material.m_text_emissive.getTextureID() != 0) featureKey |= ShaderFeature::EMISSIVE_MAP;
+    if (in_material.m_text_dissolve.getTextureID() != 0) featureKey |= ShaderFeature::MASK_MAP;
 
-    //  Texture
-    //  -------
+    return featureKey;
+}
 
-    //  Diffuse Texture
+unsigned int Resources::Shader::getFeatureBit(const std::string& keyword)
+{
+    for (const auto& feature : s_featureNames)
+    {
+        if (keyword == feature.first) return feature.second;
+    }
 
-    setBool("mat.diffuseMap.exist", in_material.m_text_diffuse.getTextureID() != 0);
-    setFloat3("mat.diffuseMap.offset", in_material.m_text_diffuse.m_offset);
-    setFloat3("mat.diffuseMap.tiling", in_material.m_text_diffuse.m_tiling);
-    in_material.m_text_diffuse.bind(GL_TEXTURE0);
+    return 0;
+}
 
-    //  Normal Texture
+void Resources::Shader::use()
+{
+    //  Can't draw with it before the driver is done
+    if (!isReady()) resolveProgram(ID, true);
 
-    setBool("mat.normalMap.map.exist", in_material.m_text_bump.getTextureID() != 0);
-    setFloat3("mat.normalMap.map.offset", in_material.m_text_bump.m_offset);
-    setFloat3("mat.normalMap.map.tiling", in_material.m_text_bump.m_tiling);
-    setFloat("mat.normalMap.multiplier", in_material.m_text_bump.m_multiplier);
-    in_material.m_text_bump.bind(GL_TEXTURE1);
+    GLState::instance()->useProgram(ID);
+}
 
-    //  Specular Texture
+void Resources::Shader::setBool(const char* name, const bool value) const
+{
+    glUniform1i(glGetUniformLocation(ID, name), (int)value);
+    RenderStats::instance()->addUniformUpload();
+}
 
-    setBool("mat.specularMap.exist", in_material.m_text_specular.getTextureID() != 0);
-    setFloat3("mat.specularMap.offset", in_material.m_text_specular.m_offset);
-    setFloat3("mat.specularMap.tiling", in_material.m_text_specular.m_tiling);
-    in_material.m_text_specular.bind(GL_TEXTURE2);
+void Resources::Shader::setInt(const char* name, const int value) const
+{
+    glUniform1i(glGetUniformLocation(ID, name), (int)value);
+    RenderStats::instance()->addUniformUpload();
+}
 
-    //  Emissive Texture
+void Resources::Shader::setFloat(const char* name, const float value) const
+{
+    glUniform1f(glGetUniformLocation(ID, name), value);
+    RenderStats::instance()->addUniformUpload();
+}
 
-    setBool("mat.emissiveMap.exist", in_material.m_text_emissive.getTextureID() != 0);
-    setFloat3("mat.emissiveMap.offset", in_material.m_text_emissive.m_offset);
-    setFloat3("mat.emissiveMap.tiling", in_material.m_text_emissive.m_tiling);
-    in_material.m_text_emissive.bind(GL_TEXTURE3);
+void Resources::Shader::setFloat2(const char* name, const Maths::Vector2f& value) const
+{
+    glUniform2f(glGetUniformLocation(ID, name), value.x, value.y);
+    RenderStats::instance()->addUniformUpload();
+}
 
-    //  Mask Texture
+void Resources::Shader::setFloat3(const char* name, const Maths::Vector3f& value) const
+{
+    glUniform3f(glGetUniformLocation(ID, name), value.x, value.y, value.z);
+    RenderStats::instance()->addUniformUpload();
+}
 
-    setBool("mat.maskMap.exist", in_material.m_text_dissolve.getTextureID() != 0);
-    setFloat3("mat.maskMap.offset", in_material.m_text_dissolve.m_offset);
-    setFloat3("mat.maskMap.tiling", in_material.m_text_dissolve.m_tiling);
-    in_material.m_text_dissolve.bind(GL_TEXTURE4);
+void Resources::Shader::setFloat4(const char* name, const  Maths::Vector4f& value) const
+{
+    glUniform4f(glGetUniformLocation(ID, name), value.x, value.y, value.z, value.w);
+    RenderStats::instance()->addUniformUpload();
+}
 
+void Resources::Shader::setMat4(const char* name, const Maths::Mat4x4& value) const
+{
+    glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, value.e);
+    RenderStats::instance()->addUniformUpload();
 }
 
 
@@ -290,6 +446,9 @@ void Resources::loadShader(std::string shaderName)
 
     if (resources->fileLoaded(filePath)) return;
 
+    PROFILE_SCOPE("Load shader");
+    MEMORY_TAG(RESOURCES);
+
     Core::Log* _log = Core::Log::instance();
 
     //	Open file in read mode
@@ -311,6 +470,7 @@ void Resources::loadShader(std::string shaderName)
     std::string geometryPath = "";
 
     int shaderType = 0;
+    unsigned int featureMask = 0;
     while (std::getline(file, curr_line))
     {
 
@@ -349,6 +509,17 @@ void Resources::loadShader(std::string shaderName)
         {
             geometryPath = FileParser::getString(lineStream);
         }
+        else if (type == "FEATURES")
+        {
+            std::string keyword;
+            while (lineStream >> keyword)
+            {
+                unsigned int featureBit = Resources::Shader::getFeatureBit(keyword);
+                if (featureBit == 0) _log->writeWarning("Unknown shader feature \"" + keyword + "\" in \"" + filePath + "\"");
+
+                featureMask |= featureBit;
+            }
+        }
     }
 
     if (fragment_shader == "" || vertex_shader == "") return;
@@ -356,10 +527,12 @@ void Resources::loadShader(std::string shaderName)
     const char* vertexPath = vertex_shader.c_str();
     const char* fragmentPath = fragment_shader.c_str();
 
-    _log->write("+ Loading Shaders \"" + filePath + "\"");
+    LOG_INFO(SHADERS, "+ Loading Shaders \"" + filePath + "\"");
 
     resources->m_shaderName_shader[shaderName] = Resources::Shader(vertexPath, fragmentPath, geometryPath);
     resources->m_shaderName_shader[shaderName].m_type = shaderType;
+    resources->m_shaderName_shader[shaderName].m_name = shaderName;
+    resources->m_shaderName_shader[shaderName].m_featureMask = featureMask;
 
     file.close();
 
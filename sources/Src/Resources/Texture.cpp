@@ -4,7 +4,10 @@
 #include <stb_image.h>
 
 #include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/JobSystem.hpp>
 #include <Resources/Texture.hpp>
+#include <LowRenderer/GLState.hpp>
 #include <Resources/ResourcesManager.hpp>
 
 #include <Utils/StringExtractor.h>
@@ -49,7 +52,7 @@ Resources::Texture::Texture(const std::string& filename, const std::string& text
 		//	Clean data
 		stbi_image_free(data);
 
-		_log->writeSuccess("Loaded texture \"" + std::string(filename) + "\"");
+		LOG_SUCCESS(LOADING, "Loaded texture \"" + std::string(filename) + "\"");
 
 		return;
 	}
@@ -60,7 +63,7 @@ Resources::Texture::Texture(const std::string& filename, const std::string& text
 void Resources::Texture::generateTexture(const GLenum format1, const GLenum format2, const float* data)
 {
 	glGenTextures(1, &m_ID);
-	glBindTexture(GL_TEXTURE_2D, m_ID);
+	GLState::instance()->bindTexture(GL_TEXTURE_2D, m_ID);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -74,9 +77,12 @@ void Resources::Texture::generateTexture(const GLenum format1, const GLenum form
 
 	glGenerateMipmap(GL_TEXTURE_2D);
 
+	//	Unsized formats are stored a byte per channel, the mipmaps add a third
+	long long channels = format1 == GL_RED ? 1 : format1 == GL_RGB ? 3 : 4;
+	Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, (long long)m_width * m_height * channels * 4 / 3);
+
 	//	Reset
-	glActiveTexture(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::instance()->bindTexture(GL_TEXTURE_2D, 0);
 }
 
 
@@ -92,8 +98,7 @@ void  Resources::Texture::showImGui() const
 
 void Resources::Texture::bind(const int bindID) const
 {
-	glActiveTexture(bindID);
-	glBindTexture(GL_TEXTURE_2D, m_ID);
+	GLState::instance()->bindTexture(GL_TEXTURE_2D, m_ID, bindID - GL_TEXTURE0);
 }
 
 
@@ -135,34 +140,60 @@ bool Resources::TextureCubeMap::generateTexture(const std::vector<std::string>&
 	Core::Log* _log = Core::Log::instance();
 
 	glGenTextures(1, &m_ID);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, m_ID);
+	GLState::instance()->bindTexture(GL_TEXTURE_CUBE_MAP, m_ID);
+
 
+	//	Faces decoded on every thread, only the upload needs the context
+	struct Face
+	{
+		float* data = nullptr;
+		int width = 0;
+		int height = 0;
+		int colorType = 0;
+	};
+
+	std::vector<Face> decoded(faces.size());
+	Core::JobSystem::instance()->parallelFor((unsigned int)faces.size(), [&](unsigned int first, unsigned int last)
+	{
+		for (unsigned int i = first; i < last; i++)
+		{
+			Face& face = decoded[i];
+			face.data = stbi_loadf(faces[i].c_str(), &face.width, &face.height, &face.colorType, 0);
+		}
+	});
 
+	bool succeed = true;
 	for (unsigned int i = 0; i < faces.size(); i++)
 	{
-		int colorType;
-		float* data = stbi_loadf(faces[i].c_str(), &m_width, &m_height, &colorType, 0);
-		if (data)
+		const Face& face = decoded[i];
+		if (face.data && succeed)
 		{
+			m_width = face.width;
+			m_height = face.height;
+
 			GLenum format1;
 			GLenum format2;
 
-			/**/ if (colorType == 1) { format1 = format2 = GL_RED; }
-			else if (colorType == 3) { format1 = GL_RGB;  format2 = GL_RGB; }
-			else if (colorType == 4) { format1 = GL_RGBA;  format2 = GL_RGBA; }
+			/**/ if (face.colorType == 1) { format1 = format2 = GL_RED; }
+			else if (face.colorType == 3) { format1 = GL_RGB;  format2 = GL_RGB; }
+			else if (face.colorType == 4) { format1 = GL_RGBA;  format2 = GL_RGBA; }
+
 
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format1, m_width, m_height, 0, format2, GL_FLOAT, face.data);
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format1, m_width, m_height, 0, format2, GL_FLOAT, data);
-			stbi_image_free(data);
+			Core::MemoryTracker::addGpuBytes(Core::MemoryTag::RESOURCES, (long long)m_width * m_height * face.colorType);
 		}
-		else
+		else if (succeed)
 		{
 			_log->writeFailure("Cubemap texture failed to load at path: \"" + faces[i] + "\"");
-			stbi_image_free(data);
-			return false;
+			succeed = false;
 		}
+
+		stbi_image_free(face.data);
 	}
 
+	if (!succeed) return false;
+
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -194,8 +225,7 @@ Resources::TextureMap::TextureMap(Texture* in_texture, const Maths::Vector3f& in
 
 void Resources::TextureMap::bind(const int bindID) const
 {
-	glActiveTexture(bindID);
-	glBindTexture(GL_TEXTURE_2D, getTextureID());
+	GLState::instance()->bindTexture(GL_TEXTURE_2D, getTextureID(), bindID - GL_TEXTURE0);
 }
 
 GLuint Resources::TextureMap::getTextureID() const
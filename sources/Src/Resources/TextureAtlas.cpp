@@ -0,0 +1,227 @@
+#include <Resources/TextureAtlas.hpp>
+
+#include <Core/Log.hpp>
+#include <Core/JobSystem.hpp>
+
+#include <Utils/File.h>
+#include <Utils/StringExtractor.h>
+
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+#include <stb_image.h>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+#define ATLAS_PAGE_SIZE	4096
+#define ATLAS_PADDING	2
+
+
+namespace
+{
+	struct AtlasImage
+	{
+		std::string path;
+		std::string name;
+		int width = 0;
+		int height = 0;
+		unsigned char* pixels = nullptr;
+
+		int page = -1;
+		int x = 0;
+		int y = 0;
+	};
+
+	//	Uncompressed 32 bits TGA, top-left origin
+	bool writeTGA(const std::string& path, int width, int height, const std::vector<unsigned char>& rgba)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file) return false;
+
+		unsigned char header[18] = {};
+		header[2] = 2;
+		header[12] = width & 0xFF;
+		header[13] = (width >> 8) & 0xFF;
+		header[14] = height & 0xFF;
+		header[15] = (height >> 8) & 0xFF;
+		header[16] = 32;
+		header[17] = 0x28;
+		file.write((const char*)header, sizeof(header));
+
+		std::vector<unsigned char> bgra(rgba.size());
+		for (size_t i = 0; i < rgba.size(); i += 4)
+		{
+			bgra[i + 0] = rgba[i + 2];
+			bgra[i + 1] = rgba[i + 1];
+			bgra[i + 2] = rgba[i + 0];
+			bgra[i + 3] = rgba[i + 3];
+		}
+		file.write((const char*)bgra.data(), bgra.size());
+
+		return (bool)file;
+	}
+
+	//	Copy the image in the page and extrude its borders in the padding,
+	//	so filtering and mipmaps don't bleed the neighbours in
+	void blit(const AtlasImage& image, int pageWidth, std::vector<unsigned char>& page)
+	{
+		for (int y = -ATLAS_PADDING; y < image.height + ATLAS_PADDING; y++)
+		{
+			int srcY = std::min(std::max(y, 0), image.height - 1);
+
+			for (int x = -ATLAS_PADDING; x < image.width + ATLAS_PADDING; x++)
+			{
+				int srcX = std::min(std::max(x, 0), image.width - 1);
+
+				const unsigned char* src = image.pixels + (srcY * image.width + srcX) * 4;
+				unsigned char* dst = &page[((image.y + y) * pageWidth + image.x + x) * 4];
+
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = src[3];
+			}
+		}
+	}
+}
+
+
+bool Resources::TextureAtlas::pack(const std::string& listPath, const std::string& outputName)
+{
+	Core::Log* _log = Core::Log::instance();
+
+	std::ifstream list;
+	if (!FileParser::openFile(listPath, list)) return false;
+
+	//	Load every listed image in 8 bits RGBA
+	//	--------------------------------------
+
+	stbi_set_flip_vertically_on_load(false);
+
+	std::vector<AtlasImage> listed;
+	std::string line;
+	while (std::getline(list, line))
+	{
+		line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+		if (line.empty() || line[0] == '#') continue;
+
+		AtlasImage image;
+		image.path = line;
+		image.name = Extractor::ExtractNameWithoutExtension(Extractor::ExtractFilename(line));
+		listed.push_back(image);
+	}
+
+	//	Decoded on every thread, each job only writes its own images
+	Core::JobSystem::instance()->parallelFor((unsigned int)listed.size(), [&listed](unsigned int first, unsigned int last)
+	{
+		for (unsigned int i = first; i < last; i++)
+		{
+			int channels;
+			AtlasImage& image = listed[i];
+			image.pixels = stbi_load(image.path.c_str(), &image.width, &image.height, &channels, 4);
+		}
+	});
+
+	std::vector<AtlasImage> images;
+	for (AtlasImage& image : listed)
+	{
+		if (!image.pixels || image.width + ATLAS_PADDING * 2 > ATLAS_PAGE_SIZE || image.height + ATLAS_PADDING * 2 > ATLAS_PAGE_SIZE)
+		{
+			_log->writeFailure("Atlas : unable to pack \"" + image.path + "\"");
+			if (image.pixels) stbi_image_free(image.pixels);
+			continue;
+		}
+
+		images.push_back(image);
+	}
+
+	//	Pack what is left in a new page until every image is placed
+	//	-----------------------------------------------------------
+
+	std::vector<stbrp_node> nodes(ATLAS_PAGE_SIZE);
+	std::vector<int> pageHeights;
+
+	size_t placed = 0;
+	while (placed < images.size())
+	{
+		int page = (int)pageHeights.size();
+
+		std::vector<stbrp_rect> rects;
+		for (int i = 0; i < (int)images.size(); i++)
+		{
+			if (images[i].page != -1) continue;
+
+			stbrp_rect rect = {};
+			rect.id = i;
+			rect.w = images[i].width + ATLAS_PADDING * 2;
+			rect.h = images[i].height + ATLAS_PADDING * 2;
+			rects.push_back(rect);
+		}
+
+		stbrp_context context;
+		stbrp_init_target(&context, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, nodes.data(), (int)nodes.size());
+		stbrp_pack_rects(&context, rects.data(), (int)rects.size());
+
+		int height = 0;
+		for (const stbrp_rect& rect : rects)
+		{
+			if (!rect.was_packed) continue;
+
+			AtlasImage& image = images[rect.id];
+			image.page = page;
+			image.x = rect.x + ATLAS_PADDING;
+			image.y = rect.y + ATLAS_PADDING;
+
+			height = std::max(height, (int)(rect.y + rect.h));
+			placed++;
+		}
+
+		//	Nothing fits in an empty page, stop there
+		if (height == 0) break;
+
+		pageHeights.push_back(height);
+	}
+
+	//	Write pages and description
+	//	---------------------------
+
+	std::ofstream atlas(outputName + ".atlas");
+	if (!atlas)
+	{
+		_log->writeError("Atlas : unable to create \"" + outputName + ".atlas\"");
+		return false;
+	}
+
+	bool succeed = true;
+	for (int page = 0; page < (int)pageHeights.size(); page++)
+	{
+		std::vector<unsigned char> pixels((size_t)ATLAS_PAGE_SIZE * pageHeights[page] * 4, 0);
+
+		for (const AtlasImage& image : images)
+		{
+			if (image.page == page) blit(image, ATLAS_PAGE_SIZE, pixels);
+		}
+
+		std::string pageName = outputName + "_" + std::to_string(page) + ".tga";
+		if (!writeTGA(pageName, ATLAS_PAGE_SIZE, pageHeights[page], pixels))
+		{
+			_log->writeError("Atlas : unable to write \"" + pageName + "\"");
+			succeed = false;
+		}
+
+		atlas << "PAGE\t" << page << " " << Extractor::ExtractFilename(pageName) << " " << ATLAS_PAGE_SIZE << " " << pageHeights[page] << "\n";
+	}
+
+	for (AtlasImage& image : images)
+	{
+		atlas << "REGION\t" << image.name << " " << image.page << " " << image.x << " " << image.y << " " << image.width << " " << image.height << "\n";
+		stbi_image_free(image.pixels);
+	}
+
+	_log->writeSuccess("Atlas : packed " + std::to_string(images.size()) + " images in " + std::to_string(pageHeights.size()) + " page(s)");
+
+	return succeed;
+}
@@ -21,12 +21,11 @@ void Enemy::start()
 	m_rigidbody = m_gameObject->getComponent<Rigidbody3>();
 	m_gameObject->tryGetComponent<ParticleSystem>(&m_hitParts);
 
-	//	Find and get player component
-	GameObject* player = Core::Graph::instance()->getCurrentScene()->findGameObjectInScene("Player");
+	//	Find and get player component, from the players of the scene : no search by name
+	m_player = Core::Graph::instance()->getCurrentScene()->getFirstComponent<Player>();
 
-	if (player != nullptr)
+	if (m_player != nullptr)
 	{
-		m_player = player->getComponent<Player>();
 		Core::Log::instance()->write("Found player");
 	}
 }
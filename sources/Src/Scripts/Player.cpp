@@ -5,6 +5,7 @@
 #include <Core/TimeManager.h>
 #include <Core/Graph.hpp>
 #include <Core/Log.hpp>
+#include <Core/FrameArena.hpp>
 #include <LowRenderer/Text.hpp>
 
 #include <Config.hpp>
@@ -20,7 +21,6 @@
 #include <Physics/Collider3.hpp>
 
 #include <sstream>
-#include <iomanip>
 
 
 Player::Player(GameObject* in_gameObject) : Component(in_gameObject)
@@ -41,16 +41,12 @@ void Player::update()
         //  Life percentage for text color
         float percent = (float)m_playerLife / (float)m_playerMaxLife;
 
-        //  Convert life integer value to string with '0' padding of 3 (0XX)
-        std::stringstream ss;
-        ss << std::setw(3) << std::setfill('0') << m_playerLife;
-
         //  Set color (Cyan to Red)
         float r = .5f + (1.f - percent) * .5f;
         float gb = percent;
 
-        //  Stock text in text render buffer
-        TextRender::instance()->AddText("abnes.ttf", ss.str() + " HP", { -8.5f, -8.25f }, .5f, { r,gb,gb });
+        //  Stock life with '0' padding of 3 (0XX) in text render buffer, formatted in the frame arena
+        TextRender::instance()->AddText("abnes.ttf", Core::FrameArena::get().format("%03d HP", m_playerLife), { -8.5f, -8.25f }, .5f, { r,gb,gb });
     }
 
     //  Check if player is grounded
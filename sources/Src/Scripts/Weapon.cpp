@@ -7,6 +7,7 @@
 #include <Core/Window.hpp>
 #include <Core/Graph.hpp>
 #include <Core/Log.hpp>
+#include <Core/FrameArena.hpp>
 
 #include <LowRenderer/Text.hpp>
 
@@ -17,7 +18,6 @@
 #include <imgui.h>
 
 #include <sstream>
-#include <iomanip>
 
 
 Weapon::Weapon(GameObject* in_gameObject) : Component(in_gameObject)
@@ -42,25 +42,17 @@ void Weapon::update()
         //  clip percentage
         float percent = ((float)m_clipAmmo / (float)m_clipSize);
 
-        //  Convert clip ammo in string
-        std::stringstream ss;
-        ss << std::setw(3) << std::setfill('0') << m_clipAmmo;
-
         //  Set colors (cyan to red)
         float r = .5f + (1.f - percent) * .5f;
         float gb = percent;
 
         //  Stock text in text render buffer
-        TextRender::instance()->AddText("abnes.ttf", ss.str(), { 5.5f,-8.25f }, .4f, { .5f,percent,percent });
+        TextRender::instance()->AddText("abnes.ttf", Core::FrameArena::get().format("%03d", m_clipAmmo), { 5.5f,-8.25f }, .4f, { .5f,percent,percent });
     }
 
     {
-        //  Convert max clip ammo in string
-        std::stringstream ss;
-        ss << std::setw(3) << std::setfill('0') << m_ammoReserve;
-
-        //  Stock text in text render buffer (cyan)
-        TextRender::instance()->AddText("abnes.ttf", "/" + ss.str(), { 7.f,-8.25f }, .4f, { .5f,1.f,1.f });
+        //  Stock max clip ammo in text render buffer (cyan), formatted in the frame arena
+        TextRender::instance()->AddText("abnes.ttf", Core::FrameArena::get().format("/%03d", m_ammoReserve), { 7.f,-8.25f }, .4f, { .5f,1.f,1.f });
     }
 
     if (m_shootFlash != nullptr)
@@ -0,0 +1,635 @@
+#include <Utils/Benchmark.hpp>
+#include <Utils/RadixSort.hpp>
+
+#include <Core/Log.hpp>
+#include <Core/JobSystem.hpp>
+
+#include <Physics/SignedDistanceField.hpp>
+#include <LowRenderer/LightClusterGrid.hpp>
+#include <LowRenderer/LightClusters.hpp>
+#include <LowRenderer/LightSelector.hpp>
+#include <LowRenderer/Light.hpp>
+#include <Maths/Quaternion.h>
+
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <atomic>
+#include <thread>
+
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	//	Milliseconds elapsed since start
+	double elapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+
+	//	Sort 100k view depth keys per frame, as the translucent pass does
+	//	------------------------------------------------------------------
+	bool benchRadixSort()
+	{
+		Core::Log* _log = Core::Log::instance();
+
+		const unsigned int keyCount = 100000;
+		const int frameCount = 200;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> depth(-500.f, -0.1f);
+
+		std::vector<float> keys(keyCount);
+		std::vector<float> reference(keyCount);
+
+		RadixSorter sorter;
+		sorter.reserve(keyCount);
+
+		double radixMs = 0.0;
+		double stdMs = 0.0;
+
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			for (float& key : keys) key = depth(random);
+
+			Clock::time_point start = Clock::now();
+			const unsigned int* order = sorter.sort(keys.data(), keyCount);
+			radixMs += elapsedMs(start);
+
+			for (unsigned int i = 1; i < keyCount; i++)
+			{
+				if (keys[order[i - 1]] > keys[order[i]])
+				{
+					_log->writeFailure("RadixSort : keys out of order at frame " + std::to_string(frame));
+					return false;
+				}
+			}
+
+			reference = keys;
+			start = Clock::now();
+			std::sort(reference.begin(), reference.end());
+			stdMs += elapsedMs(start);
+		}
+
+		_log->write("RadixSort : " + std::to_string(keyCount) + " keys, " + std::to_string(frameCount) + " frames");
+		_log->write("\t radix sort : " + std::to_string(radixMs / frameCount) + " ms/frame");
+		_log->write("\t std::sort  : " + std::to_string(stdMs / frameCount) + " ms/frame");
+
+		return true;
+	}
+
+
+	//	Exact signed distance to a box : the point in the box referential clamped to its half extents
+	float exactBoxDistance(const Maths::Box& box, const Vector3f& point)
+	{
+		Vector3f toPoint = point - box.m_center;
+		Vector3f local = { dotProduct(toPoint, vector3RotateByQuaternion({ 1.f, 0.f, 0.f }, box.m_rotation)),
+						   dotProduct(toPoint, vector3RotateByQuaternion({ 0.f, 1.f, 0.f }, box.m_rotation)),
+						   dotProduct(toPoint, vector3RotateByQuaternion({ 0.f, 0.f, 1.f }, box.m_rotation)) };
+
+		Vector3f clamped = { clamp(local.x, -box.m_extension.x, box.m_extension.x),
+							 clamp(local.y, -box.m_extension.y, box.m_extension.y),
+							 clamp(local.z, -box.m_extension.z, box.m_extension.z) };
+
+		float outside = (local - clamped).length();
+		if (outside > 0.f) return outside;
+
+		//	Inside, the closest face
+		return -min(box.m_extension.x - fabsf(local.x), min(box.m_extension.y - fabsf(local.y), box.m_extension.z - fabsf(local.z)));
+	}
+
+
+	//	Particle lookups in the distance field for growing static collider counts
+	//	The cost per lookup should stay flat, unlike testing every box
+	//	Also checks the lookups against the exact distance to the closest box
+	//	-------------------------------------------------------------------------
+	bool benchDistanceField()
+	{
+		Core::Log* _log = Core::Log::instance();
+
+		const int colliderCounts[] = { 10, 100, 1000, 10000 };
+		const int lookupCount = 1000000;
+		const int bruteForceCount = 20000;
+		const int particlesPerEmitter = 500;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-100.f, 100.f);
+		std::uniform_real_distribution<float> size(0.25f, 4.f);
+		std::uniform_real_distribution<float> angle(0.f, 3.14159f);
+		std::uniform_real_distribution<float> offset(-5.f, 5.f);
+		std::uniform_real_distribution<float> spread(-1.f, 1.f);
+
+		bool succeed = true;
+		for (int colliderCount : colliderCounts)
+		{
+			std::vector<Maths::Box> boxes;
+			Physics::SignedDistanceField field;
+
+			for (int i = 0; i < colliderCount; i++)
+			{
+				Maths::Box box({ position(random), position(random) * 0.1f, position(random) },
+					quaternionFromEuler(Vector3f{ 0.f, angle(random), 0.f }),
+					{ size(random), size(random), size(random) }, 0.f);
+
+				boxes.push_back(box);
+				field.addBox(box, Physics::PhysicsMaterial());
+			}
+
+			Clock::time_point start = Clock::now();
+			field.bake();
+			double bakeMs = elapsedMs(start);
+
+			//	Emitters around the colliders, each one with a cloud of particles
+			std::vector<Vector3f> points(lookupCount);
+			for (int i = 0; i < lookupCount; i += particlesPerEmitter)
+			{
+				const Maths::Box& box = boxes[random() % boxes.size()];
+				Vector3f emitter = box.m_center + Vector3f{ offset(random), offset(random), offset(random) };
+
+				for (int j = i; j < i + particlesPerEmitter; j++)
+					points[j] = emitter + Vector3f{ spread(random), spread(random), spread(random) };
+			}
+
+			Physics::DistanceSample sample;
+			float checksum = 0.f;
+
+			start = Clock::now();
+			for (const Vector3f& point : points)
+			{
+				if (field.sample(point, sample)) checksum += sample.distance;
+			}
+			double lookupNs = elapsedMs(start) * 1e6 / lookupCount;
+
+			//	Reference : closest box through every collider
+			std::vector<float> closests(bruteForceCount);
+
+			start = Clock::now();
+			for (int i = 0; i < bruteForceCount; i++)
+			{
+				float closest = FLT_MAX;
+				for (const Maths::Box& box : boxes) closest = min(closest, exactBoxDistance(box, points[i]));
+
+				closests[i] = closest;
+				checksum += closest;
+			}
+			double bruteForceNs = elapsedMs(start) * 1e6 / bruteForceCount;
+
+			//	The field stores distances up to a brick, a solid brick reads as a brick deep
+			//	A point closer than a cell to a box is always in a baked brick
+			const float cellSize = field.getCellSize();
+			const float brickSize = cellSize * Physics::SignedDistanceField::BRICK_CELLS;
+
+			int wrong = 0;
+			float maxError = 0.f;
+			for (int i = 0; i < bruteForceCount; i++)
+			{
+				if (!field.sample(points[i], sample))
+				{
+					if (closests[i] < cellSize) wrong++;
+					continue;
+				}
+
+				float expected = clamp(closests[i], -brickSize, brickSize);
+				if (sample.distance <= -brickSize && expected <= -cellSize) continue;
+
+				float error = fabsf(sample.distance - expected);
+				maxError = max(maxError, error);
+				if (error > cellSize) wrong++;
+			}
+
+			_log->write("DistanceField : " + std::to_string(colliderCount) + " boxes, bake " + std::to_string(bakeMs) + " ms, "
+				+ std::to_string(field.getBrickCount()) + " bricks, " + std::to_string(field.getMemorySize() / 1024) + " KB");
+			_log->write("	 lookup      : " + std::to_string(lookupNs) + " ns/particle");
+			_log->write("	 every box   : " + std::to_string(bruteForceNs) + " ns/particle (checksum " + std::to_string(checksum) + ")");
+			_log->write("	 max error   : " + std::to_string(maxError) + " for cells of " + std::to_string(cellSize));
+
+			if (wrong)
+			{
+				_log->writeFailure("DistanceField : " + std::to_string(wrong) + " lookups off by more than a cell");
+				succeed = false;
+			}
+		}
+
+		return succeed;
+	}
+
+
+	//	Cluster assignment of growing point light counts
+	//	Also checks that every light reaching a point is listed in its cluster
+	//	----------------------------------------------------------------------
+	bool benchLightClusters()
+	{
+		Core::Log* _log = Core::Log::instance();
+
+		const int lightCounts[] = { 16, 128, 512, 2048 };
+		const int frameCount = 100;
+		const int checkCount = 100000;
+
+		const float fovY = 90.f * 3.14159f / 180.f;
+		const float aspect = 16.f / 9.f;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> side(-1.f, 1.f);
+		std::uniform_real_distribution<float> depth(0.5f, 150.f);
+		std::uniform_real_distribution<float> radius(1.f, 15.f);
+
+		LightClusterGrid grid;
+		grid.setFrustum(fovY, aspect, 0.1f, 10000.f);
+
+		float tanY = tanf(fovY * 0.5f);
+		float tanX = tanY * aspect;
+
+		bool succeed = true;
+		for (int lightCount : lightCounts)
+		{
+			std::vector<ClusterSphere> spheres(lightCount);
+			for (ClusterSphere& sphere : spheres)
+			{
+				float z = depth(random);
+				sphere.center = { side(random) * z * tanX, side(random) * z * tanY, -z };
+				sphere.radius = radius(random);
+			}
+
+			Clock::time_point start = Clock::now();
+			for (int frame = 0; frame < frameCount; frame++)
+				grid.assign(spheres);
+			double assignMs = elapsedMs(start) / frameCount;
+
+			const std::vector<ClusterRange>& clusters = grid.getClusters();
+			const std::vector<unsigned int>& indices = grid.getIndices();
+
+			//	Random visible points against every sphere
+			int missing = 0;
+			int reaching = 0;
+			for (int i = 0; i < checkCount; i++)
+			{
+				float z = depth(random);
+				Vector3f point = { side(random) * z * tanX, side(random) * z * tanY, -z };
+
+				int cluster = grid.getClusterIndex(point);
+				if (cluster < 0) continue;
+
+				const ClusterRange& range = clusters[cluster];
+				for (int light = 0; light < lightCount; light++)
+				{
+					if ((point - spheres[light].center).length() > spheres[light].radius) continue;
+
+					reaching++;
+					if (std::find(indices.begin() + range.offset, indices.begin() + range.offset + range.count, (unsigned int)light) == indices.begin() + range.offset + range.count)
+						missing++;
+				}
+			}
+
+			_log->write("LightClusters : " + std::to_string(lightCount) + " lights, assign " + std::to_string(assignMs) + " ms");
+			_log->write("	 per cluster : " + std::to_string(indices.size() / (float)clusters.size()) + " lights listed");
+			_log->write("	 per point   : " + std::to_string(reaching / (float)checkCount) + " lights reaching");
+
+			if (missing)
+			{
+				_log->writeFailure("LightClusters : " + std::to_string(missing) + " lights missing from their cluster");
+				succeed = false;
+			}
+		}
+
+		return succeed;
+	}
+
+
+	//	Pick the 8 most influential lights of 10k models, checked against scoring every light
+	//	-----------------------------------------------------------------------------------------
+	bool benchLightSelection()
+	{
+		Core::Log* _log = Core::Log::instance();
+
+		const int lightCounts[] = { 16, 128, 512, 2048 };
+		const unsigned int objectCount = 10000;
+		const unsigned int budget = 8;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-200.f, 200.f);
+		std::uniform_real_distribution<float> radius(1.f, 15.f);
+		std::uniform_real_distribution<float> objectRadius(0.2f, 5.f);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		LightSelector selector;
+
+		bool succeed = true;
+		for (int lightCount : lightCounts)
+		{
+			//	Point lights, with a directional and a few spot lights
+			std::vector<GpuLight> lights(lightCount);
+			for (int i = 0; i < lightCount; i++)
+			{
+				GpuLight& light = lights[i];
+				for (int c = 0; c < 3; c++)
+				{
+					light.position[c] = position(random);
+					light.ambient[c] = 0.05f;
+					light.diffuse[c] = unit(random);
+					light.specular[c] = 0.5f;
+					light.direction[c] = unit(random) - 0.5f;
+				}
+
+				light.power = 1.f;
+				light.cutOff = 0.9f;
+				light.outerCutOff = 0.85f;
+				light.attenuation[0] = 1.f;
+				light.attenuation[1] = 0.1f;
+				light.attenuation[2] = 0.05f;
+				light.lightType = i == 0 ? (int)LightType::DIRECTIONNAL_LIGHT : (i % 32 == 0 ? (int)LightType::SPOT_LIGHT : (int)LightType::POINT_LIGHT);
+				light.radius = light.lightType == (int)LightType::POINT_LIGHT ? radius(random) : -1.f;
+				light.padding = 0.f;
+			}
+
+			std::vector<Vector3f> centers(objectCount);
+			std::vector<float> radii(objectCount);
+			for (unsigned int i = 0; i < objectCount; i++)
+			{
+				centers[i] = { position(random), position(random), position(random) };
+				radii[i] = objectRadius(random);
+			}
+
+			std::vector<unsigned int> selected(objectCount * budget);
+			std::vector<unsigned int> counts(objectCount);
+
+			Clock::time_point start = Clock::now();
+			selector.build(lights);
+			double buildMs = elapsedMs(start);
+
+			start = Clock::now();
+			for (unsigned int i = 0; i < objectCount; i++)
+				counts[i] = selector.select(centers[i], radii[i], &selected[i * budget], budget);
+			double selectMs = elapsedMs(start);
+
+			//	The selection must hold as much influence as the best lights of a full scan
+			int wrong = 0;
+			unsigned int selectedCount = 0;
+			std::vector<float> scores(lightCount);
+
+			start = Clock::now();
+			for (unsigned int i = 0; i < objectCount; i++)
+			{
+				for (int light = 0; light < lightCount; light++) scores[light] = selector.getInfluence(light, centers[i], radii[i]);
+
+				std::partial_sort(scores.begin(), scores.begin() + std::min<int>(budget, lightCount), scores.end(), std::greater<float>());
+
+				float expected = 0.f;
+				for (unsigned int k = 0; k < budget && k < (unsigned int)lightCount && scores[k] > 0.f; k++) expected += scores[k];
+
+				float found = 0.f;
+				for (unsigned int k = 0; k < counts[i]; k++) found += selector.getInfluence(selected[i * budget + k], centers[i], radii[i]);
+
+				if (fabsf(found - expected) > 1e-4f * std::max(expected, 1.f)) wrong++;
+				selectedCount += counts[i];
+			}
+			double scanMs = elapsedMs(start);
+
+			_log->write("LightSelector : " + std::to_string(lightCount) + " lights, build " + std::to_string(buildMs) + " ms, select " + std::to_string(selectMs) + " ms (full scan " + std::to_string(scanMs) + " ms)");
+			_log->write("	 per model : " + std::to_string(selector.getScoredPerQuery()) + " lights scored, " + std::to_string(selectedCount / (float)objectCount) + " selected");
+
+			if (wrong)
+			{
+				_log->writeFailure("LightSelector : " + std::to_string(wrong) + " models missing an influential light");
+				succeed = false;
+			}
+		}
+
+		return succeed;
+	}
+
+
+	//	Job system stress : every index of a parallelFor once, more jobs than the queues hold,
+	//	nested parallelFor, dependency chains and jobs added from another thread
+	//	---------------------------------------------------------------------------------------
+	bool benchJobs()
+	{
+		Core::Log* _log = Core::Log::instance();
+		Core::JobSystem* _jobs = Core::JobSystem::instance();
+
+		const unsigned int workerCounts[] = { 1, 3, std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+		const int rounds = 200;
+
+		bool succeed = true;
+		for (unsigned int workerCount : workerCounts)
+		{
+			_jobs->start(workerCount);
+
+			int failures = 0;
+			Clock::time_point start = Clock::now();
+
+			//	Ranges of every size, each index visited once
+			std::vector<int> visits;
+			for (int round = 0; round < rounds; round++)
+			{
+				unsigned int count = 1 + round * 997 % 100000;
+				visits.assign(count, 0);
+
+				_jobs->parallelFor(count, [&](unsigned int first, unsigned int last)
+				{
+					for (unsigned int i = first; i < last; i++) visits[i]++;
+				});
+
+				if (std::count(visits.begin(), visits.end(), 1) != (int)count) failures++;
+			}
+
+			//	Rings full, the jobs left run on the spot
+			{
+				std::atomic<long long> sum{ 0 };
+				Core::JobCounter counter;
+				for (int i = 0; i < JOB_QUEUE_SIZE * 8; i++) _jobs->run(counter, [&sum, i]() { sum += i; });
+				_jobs->wait(counter);
+
+				if (sum != (long long)JOB_QUEUE_SIZE * 8 * (JOB_QUEUE_SIZE * 8 - 1) / 2) failures++;
+			}
+
+			//	parallelFor in a parallelFor
+			{
+				std::atomic<long long> sum{ 0 };
+				_jobs->parallelFor(64, [&](unsigned int first, unsigned int last)
+				{
+					for (unsigned int i = first; i < last; i++)
+					{
+						_jobs->parallelFor(1000, [&](unsigned int innerFirst, unsigned int innerLast)
+						{
+							long long partial = 0;
+							for (unsigned int k = innerFirst; k < innerLast; k++) partial += k;
+							sum += partial;
+						}, 16);
+					}
+				});
+
+				if (sum != 64ll * 999 * 1000 / 2) failures++;
+			}
+
+			//	Chained, run in the order of their dependencies whoever takes them
+			for (int round = 0; round < rounds; round++)
+			{
+				int value = 0;
+				Core::JobCounter first, second, third;
+
+				_jobs->run(first, [&value]() { std::this_thread::yield(); value = value * 10 + 1; });
+				_jobs->run(second, [&value]() { value = value * 10 + 2; }, &first);
+				_jobs->run(third, [&value]() { value = value * 10 + 3; }, &second);
+				_jobs->wait(third);
+
+				if (value != 123) failures++;
+			}
+
+			//	Jobs from a thread the system didn't start
+			{
+				std::atomic<int> sum{ 0 };
+				std::thread thread([&]()
+				{
+					Core::JobCounter counter;
+					for (int i = 0; i < 1000; i++) _jobs->run(counter, [&sum]() { sum++; });
+					_jobs->wait(counter);
+				});
+				thread.join();
+
+				if (sum != 1000) failures++;
+			}
+
+			_log->write("Jobs : " + std::to_string(workerCount) + " workers, stress done in " + std::to_string(elapsedMs(start)) + " ms");
+			if (failures)
+			{
+				_log->writeFailure("Jobs : " + std::to_string(failures) + " checks failed with " + std::to_string(workerCount) + " workers");
+				succeed = false;
+			}
+
+			_jobs->stop();
+		}
+
+		_jobs->start();
+
+		return succeed;
+	}
+
+
+	//	Particle lookups in a distance field spread with parallelFor, from 1 to every hardware thread
+	//	Also the cost of a job, with jobs doing nothing. With 1 thread the system is stopped,
+	//	the loop and the jobs run as plain calls : the reference of the speedup
+	//	---------------------------------------------------------------------------------------------
+	bool benchJobScaling()
+	{
+		Core::Log* _log = Core::Log::instance();
+		Core::JobSystem* _jobs = Core::JobSystem::instance();
+
+		const int colliderCount = 1000;
+		const unsigned int lookupCount = 1000000;
+		const int frameCount = 20;
+		const int emptyJobCount = 100000;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-100.f, 100.f);
+		std::uniform_real_distribution<float> size(0.25f, 4.f);
+
+		Physics::SignedDistanceField field;
+		for (int i = 0; i < colliderCount; i++)
+		{
+			field.addBox(Maths::Box({ position(random), position(random) * 0.1f, position(random) }, quaternionFromEuler(Vector3f{ 0.f, 0.f, 0.f }),
+				{ size(random), size(random), size(random) }, 0.f), Physics::PhysicsMaterial());
+		}
+		field.bake();
+
+		std::vector<Vector3f> points(lookupCount);
+		for (Vector3f& point : points) point = { position(random), position(random) * 0.1f, position(random) };
+
+		std::vector<float> distances(lookupCount);
+
+		unsigned int threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		double singleMs = 0.0;
+
+		for (unsigned int threads = 1; threads <= threadCount; threads++)
+		{
+			//	The main thread is the first one, alone the system is stopped (Benchmark::run started it)
+			if (threads > 1) _jobs->start(threads - 1);
+			else _jobs->stop();
+
+			Clock::time_point start = Clock::now();
+			for (int frame = 0; frame < frameCount; frame++)
+			{
+				_jobs->parallelFor(lookupCount, [&](unsigned int first, unsigned int last)
+				{
+					Physics::DistanceSample sample;
+					for (unsigned int i = first; i < last; i++) distances[i] = field.sample(points[i], sample) ? sample.distance : FLT_MAX;
+				}, 1024);
+			}
+			double frameMs = elapsedMs(start) / frameCount;
+
+			start = Clock::now();
+			Core::JobCounter counter;
+			for (int i = 0; i < emptyJobCount; i++) _jobs->run(counter, []() {});
+			_jobs->wait(counter);
+			double jobNs = elapsedMs(start) * 1e6 / emptyJobCount;
+
+			if (threads == 1) singleMs = frameMs;
+
+			_log->write("JobScaling : " + std::to_string(threads) + " threads, " + std::to_string(frameMs) + " ms/frame, x"
+				+ std::to_string(singleMs / frameMs) + ", " + std::to_string(jobNs) + " ns/empty job");
+
+			_jobs->stop();
+		}
+
+		_jobs->start();
+
+		return true;
+	}
+
+
+	//	A benchmark returns false when one of its checks fails
+	struct Entry
+	{
+		const char* name;
+		bool (*function)();
+	};
+
+	const Entry benchmarks[] =
+	{
+		{ "radixsort", &benchRadixSort },
+		{ "distancefield", &benchDistanceField },
+		{ "lightclusters", &benchLightClusters },
+		{ "lightselection", &benchLightSelection },
+		{ "jobs", &benchJobs },
+		{ "jobscaling", &benchJobScaling },
+	};
+}
+
+
+bool Benchmark::run(const std::string& name)
+{
+	Core::Log* _log = Core::Log::instance();
+
+	//	As in the game, the light clusters are assigned on the workers
+	Core::JobSystem::instance()->start();
+
+	bool found = false;
+	bool succeed = true;
+	for (const Entry& entry : benchmarks)
+	{
+		if (name != "all" && name != entry.name) continue;
+
+		found = true;
+		_log->write("Benchmark \"" + std::string(entry.name) + "\"");
+		if (!entry.function()) succeed = false;
+		_log->breakLine();
+	}
+
+	if (!found) _log->writeError("Unknown benchmark \"" + name + "\"");
+
+	Core::JobSystem::kill();
+
+	return found && succeed;
+}
+
+void Benchmark::list()
+{
+	Core::Log* _log = Core::Log::instance();
+
+	for (const Entry& entry : benchmarks) _log->write("\t " + std::string(entry.name));
+}
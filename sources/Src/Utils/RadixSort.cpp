@@ -0,0 +1,92 @@
+#include <Utils/RadixSort.hpp>
+
+#include <cstring>
+
+
+//	Flip float bits so that the unsigned order matches the float order
+//	Negative floats get all their bits flipped, positive ones only their sign bit
+//	-----------------------------------------------------------------------------
+static inline unsigned int floatToSortableKey(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	unsigned int mask = (unsigned int)(-(int)(bits >> 31)) | 0x80000000u;
+	return bits ^ mask;
+}
+
+
+void RadixSorter::reserve(unsigned int count)
+{
+	if (count <= m_keys.size()) return;
+
+	m_keys.resize(count);
+	m_keysScratch.resize(count);
+	m_indices.resize(count);
+	m_indicesScratch.resize(count);
+}
+
+const unsigned int* RadixSorter::sort(const float* keys, unsigned int count)
+{
+	reserve(count);
+
+	if (count == 0) return m_indices.data();
+
+	//	Convert keys and build every histogram in a single read
+	//	-------------------------------------------------------
+
+	memset(m_histogram, 0, sizeof(m_histogram));
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		unsigned int key = floatToSortableKey(keys[i]);
+
+		m_keys[i] = key;
+		m_indices[i] = i;
+
+		m_histogram[0][key & RADIX_MASK]++;
+		m_histogram[1][(key >> RADIX_BITS) & RADIX_MASK]++;
+		m_histogram[2][key >> (RADIX_BITS * 2)]++;
+	}
+
+	unsigned int* srcKeys = m_keys.data();
+	unsigned int* dstKeys = m_keysScratch.data();
+	unsigned int* srcIndices = m_indices.data();
+	unsigned int* dstIndices = m_indicesScratch.data();
+
+
+	//	Scatter pass per digit, from the least significant one
+	//	------------------------------------------------------
+
+	for (unsigned int pass = 0; pass < RADIX_PASSES; pass++)
+	{
+		unsigned int shift = pass * RADIX_BITS;
+		unsigned int* histogram = m_histogram[pass];
+
+		//	Every key shares this digit, the pass would not move anything
+		if (histogram[(srcKeys[0] >> shift) & RADIX_MASK] == count) continue;
+
+		//	Histogram to start offsets
+		unsigned int offset = 0;
+		for (unsigned int bucket = 0; bucket < RADIX_SIZE; bucket++)
+		{
+			unsigned int bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			unsigned int key = srcKeys[i];
+			unsigned int dst = histogram[(key >> shift) & RADIX_MASK]++;
+
+			dstKeys[dst] = key;
+			dstIndices[dst] = srcIndices[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcIndices, dstIndices);
+	}
+
+	return srcIndices;
+}
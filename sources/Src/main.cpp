@@ -1,25 +1,141 @@
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
+#ifdef _MSC_VER
 #include <crtdbg.h>
+#endif
 #include <time.h> 
 
 #include <iostream>
+#include <string>
 #include <API.hpp>
 
+#include <Config.hpp>
+#include <Core/Log.hpp>
+#include <Core/MemoryTracker.hpp>
+#include <Core/RenderThread.hpp>
+#include <Core/Window.hpp>
+#include <LowRenderer/RenderStats.hpp>
+#include <Resources/TextureAtlas.hpp>
+#include <Utils/Benchmark.hpp>
 
-int main()
+
+int main(int argc, char** argv)
 {
 	{
 		srand((unsigned int)time(NULL));
 
+		//	Run benchmarks without opening a window
+		if (argc > 1 && std::string(argv[1]) == "--bench")
+		{
+			bool succeed = true;
+			if (argc > 2)
+			{
+				succeed = Benchmark::run(argv[2]);
+			}
+			else
+			{
+				Core::Log::instance()->write("Usage : --bench <name|all>");
+				Benchmark::list();
+			}
+
+			Core::Log::kill();
+			return succeed ? 0 : -1;
+		}
+
+		//	Pack the UI atlas, run by the post-build event
+		if (argc > 1 && std::string(argv[1]) == "--pack-atlas")
+		{
+			std::string list = argc > 2 ? argv[2] : UI_ATLAS_LIST;
+			std::string output = argc > 3 ? argv[3] : UI_ATLAS;
+
+			bool succeed = Resources::TextureAtlas::pack(list, output);
+
+			Core::Log::kill();
+			return succeed ? 0 : -1;
+		}
+
+		//	Write the renderer counters of the first frames, windowed or headless
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::string(argv[i]) != "--capture-stats") continue;
+
+			int frames = i + 1 < argc ? atoi(argv[i + 1]) : 0;
+			std::string file = i + 2 < argc && argv[i + 2][0] != '-' ? argv[i + 2] : STATS_CAPTURE_FILE;
+
+			if (frames > 0) RenderStats::instance()->startCapture(frames, file);
+			else Core::Log::instance()->writeError("Usage : --capture-stats <frames> [file]");
+		}
+
+		//	Play a scene on the null render device, no window nor GPU
+		if (argc > 1 && std::string(argv[1]) == "--headless")
+		{
+			int frames = argc > 2 && argv[2][0] != '-' ? atoi(argv[2]) : HEADLESS_FRAMES;
+			std::string scene = argc > 3 && argv[3][0] != '-' ? argv[3] : HEADLESS_SCENE;
+
+			//	Fail when a frame past the warmup allocates
+			bool assertNoAlloc = false;
+			for (int i = 2; i < argc; i++)
+			{
+				if (std::string(argv[i]) == "--assert-no-alloc") assertNoAlloc = true;
+			}
+
+			Core::Window::s_headless = true;
+
+			int result;
+			{
+				API m_api;
+				result = m_api.runHeadless(scene, frames > 0 ? frames : HEADLESS_FRAMES, assertNoAlloc);
+			}
+
+			Core::MemoryTracker::logLiveAllocations();
+			Core::Log::kill();
+
+#ifdef _MSC_VER
+			_CrtDumpMemoryLeaks();
+#endif
+			return result;
+		}
+
+		//	Time the loads and unloads of a scene on the null render device
+		if (argc > 1 && std::string(argv[1]) == "--bench-scene")
+		{
+			std::string scene = argc > 2 ? argv[2] : HEADLESS_SCENE;
+			int loads = argc > 3 ? atoi(argv[3]) : BENCH_SCENE_LOADS;
+
+			Core::Window::s_headless = true;
+
+			int result;
+			{
+				API m_api;
+				result = m_api.runSceneBenchmark(scene, loads > 0 ? loads : BENCH_SCENE_LOADS);
+			}
+
+			Core::Log::kill();
+			return result;
+		}
+
+		//	Keep every GL call on the main thread, as the editor does
+		//	--save-trace [file] writes the profilers trace of the last frames when the window closes
+		std::string tracePath;
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::string(argv[i]) == "--single-thread") Core::RenderThread::instance()->m_enabled = false;
+			if (std::string(argv[i]) == "--save-trace") tracePath = i + 1 < argc && argv[i + 1][0] != '-' ? argv[i + 1] : TRACE_FILE;
+		}
+
 		API m_api;
 		if (m_api.init() < 0) return -1;
 
 		m_api.loading();
 
-		m_api.windowLoop();
+		m_api.windowLoop(tracePath);
 	}
 
+	Core::MemoryTracker::logLiveAllocations();
+	Core::Log::kill();
+
+#ifdef _MSC_VER
 	_CrtDumpMemoryLeaks();
+#endif
 	return 0;
-}
\ No newline at end of file
+}